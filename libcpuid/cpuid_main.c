@@ -35,6 +35,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 /* Implementation: */
 
@@ -119,42 +120,96 @@ static int get_total_cpus(void)
 	return system_info.dwNumberOfProcessors;
 }
 
-static bool set_cpu_affinity(logical_cpu_t logical_cpu)
+/* Map a logical CPU index to its processor group and the number within that group */
+int cpuid_get_cpu_group_affinity(logical_cpu_t logical_cpu, GROUP_AFFINITY* group_affinity)
 {
-/* Credits to https://github.com/PolygonTek/BlueshiftEngine/blob/fbc374cbc391e1147c744649f405a66a27c35d89/Source/Runtime/Private/Platform/Windows/PlatformWinThread.cpp#L27 */
 #if (_WIN32_WINNT >= 0x0601)
-	int groups = GetActiveProcessorGroupCount();
-	int total_processors = 0;
-	int group = 0;
-	int number = 0;
-	HANDLE thread = GetCurrentThread();
-	GROUP_AFFINITY groupAffinity;
+/* Credits to https://github.com/PolygonTek/BlueshiftEngine/blob/fbc374cbc391e1147c744649f405a66a27c35d89/Source/Runtime/Private/Platform/Windows/PlatformWinThread.cpp#L27 */
+	WORD groups = GetActiveProcessorGroupCount();
+	DWORD total_processors = 0;
 
-	for (int i = 0; i < groups; i++) {
-		int processors = GetActiveProcessorCount(i);
+	for (WORD i = 0; i < groups; i++) {
+		DWORD processors = GetActiveProcessorCount(i);
 		if (total_processors + processors > logical_cpu) {
-			group = i;
-			number = logical_cpu - total_processors;
-			break;
+			memset(group_affinity, 0, sizeof(GROUP_AFFINITY));
+			group_affinity->Group = i;
+			group_affinity->Mask = (KAFFINITY) 1 << (logical_cpu - total_processors);
+			return true;
 		}
 		total_processors += processors;
 	}
+#endif /* (_WIN32_WINNT >= 0x0601) */
+	return false;
+}
 
-	memset(&groupAffinity, 0, sizeof(groupAffinity));
-	groupAffinity.Group = (WORD) group;
-	groupAffinity.Mask = (KAFFINITY) (1ULL << number);
-	return SetThreadGroupAffinity(thread, &groupAffinity, NULL);
+static bool set_cpu_affinity(logical_cpu_t logical_cpu)
+{
+#if (_WIN32_WINNT >= 0x0601)
+	GROUP_AFFINITY groupAffinity;
+	if (!cpuid_get_cpu_group_affinity(logical_cpu, &groupAffinity))
+		return false;
+	return SetThreadGroupAffinity(GetCurrentThread(), &groupAffinity, NULL);
 #else
-	if (logical_cpu > (sizeof(DWORD_PTR) * 8)) {
+	if (logical_cpu >= (sizeof(DWORD_PTR) * 8)) {
 		warnf("set_cpu_affinity for logical CPU %u is not supported in this operating system.\n", logical_cpu);
-		return -1;
+		return false;
 	}
 	HANDLE process = GetCurrentProcess();
-	DWORD_PTR processAffinityMask = 1ULL << logical_cpu;
+	DWORD_PTR processAffinityMask = (DWORD_PTR) 1 << logical_cpu;
 	return SetProcessAffinityMask(process, processAffinityMask);
 #endif /* (_WIN32_WINNT >= 0x0601) */
 }
 
+/* Total number of logical CPUs across all processor groups */
+static int get_total_logical_cpus(void)
+{
+#if (_WIN32_WINNT >= 0x0601)
+	return (int) GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+#else
+	return get_total_cpus();
+#endif /* (_WIN32_WINNT >= 0x0601) */
+}
+
+struct raw_data_worker_t {
+	struct cpu_raw_data_t* raw;
+	int error;
+};
+
+static DWORD WINAPI raw_data_worker(LPVOID param)
+{
+	struct raw_data_worker_t* worker = param;
+	if (worker->raw)
+		worker->error = cpuid_get_raw_data(worker->raw);
+	return 0;
+}
+
+/* Start a worker pinned to logical_cpu. The thread is created suspended so that
+ * no CPUID leaf runs before the affinity is in place. */
+static HANDLE start_raw_data_worker(logical_cpu_t logical_cpu, struct raw_data_worker_t* worker)
+{
+	bool pinned;
+	HANDLE thread = CreateThread(NULL, 64 * 1024, raw_data_worker, worker,
+		CREATE_SUSPENDED | STACK_SIZE_PARAM_IS_A_RESERVATION, NULL);
+	if (thread == NULL) {
+		worker->error = ERR_NO_MEM;
+		return NULL;
+	}
+#if (_WIN32_WINNT >= 0x0601)
+	GROUP_AFFINITY groupAffinity;
+	pinned = cpuid_get_cpu_group_affinity(logical_cpu, &groupAffinity)
+		&& SetThreadGroupAffinity(thread, &groupAffinity, NULL);
+#else
+	pinned = logical_cpu < (sizeof(DWORD_PTR) * 8)
+		&& SetThreadAffinityMask(thread, (DWORD_PTR) 1 << logical_cpu) != 0;
+#endif /* (_WIN32_WINNT >= 0x0601) */
+	if (!pinned) {
+		worker->raw = NULL;
+		worker->error = ERR_INVCNB;
+	}
+	ResumeThread(thread);
+	return thread;
+}
+
 static void load_features_common(struct cpu_raw_data_t* raw, struct cpu_id_t* data)
 {
 	const struct feature_map_t matchtable_edx1[] = {
@@ -338,56 +393,121 @@ int cpuid_present(void)
 	return cpuid_exists_by_eflags();
 }
 
+/* Every CPUID is a VM exit under a hypervisor, count them */
+static volatile LONG cpuid_exec_count = 0;
+
 void cpu_exec_cpuid(uint32_t eax, uint32_t* regs)
 {
 	regs[0] = eax;
 	regs[1] = regs[2] = regs[3] = 0;
+	InterlockedIncrement(&cpuid_exec_count);
 	exec_cpuid(regs);
 }
 
 void cpu_exec_cpuid_ext(uint32_t* regs)
 {
+	InterlockedIncrement(&cpuid_exec_count);
 	exec_cpuid(regs);
 }
 
+long cpuid_get_exec_count(void)
+{
+	return cpuid_exec_count;
+}
+
+static void exec_cpuid_subleaf(uint32_t leaf, uint32_t subleaf, uint32_t* regs)
+{
+	regs[EAX] = leaf;
+	regs[EBX] = 0;
+	regs[ECX] = subleaf;
+	regs[EDX] = 0;
+	cpu_exec_cpuid_ext(regs);
+}
+
+int cpuid_get_raw_leaf(uint32_t leaf, uint32_t subleaf, uint32_t* regs)
+{
+	static uint32_t max_basic = 0, max_ext = 0;
+	static volatile LONG init = 0;
+	uint32_t max_leaf = leaf;
+
+	memset(regs, 0, NUM_REGS * sizeof(uint32_t));
+	if (!init) {
+		if (!cpuid_present())
+			return set_error(ERR_NO_CPUID);
+		cpu_exec_cpuid(0, regs);
+		max_basic = regs[EAX];
+		cpu_exec_cpuid(0x80000000, regs);
+		max_ext = regs[EAX];
+		InterlockedExchange(&init, 1);
+	}
+	/* Hypervisor and other vendor ranges are left to the caller */
+	if (leaf < 0x40000000)
+		max_leaf = max_basic;
+	else if ((leaf & 0xffff0000) == 0x80000000)
+		max_leaf = max_ext;
+	if (leaf > max_leaf) {
+		memset(regs, 0, NUM_REGS * sizeof(uint32_t));
+		return set_error(ERR_INVRANGE);
+	}
+	exec_cpuid_subleaf(leaf, subleaf, regs);
+	return set_error(ERR_OK);
+}
+
 int cpuid_get_raw_data(struct cpu_raw_data_t* data)
 {
-	unsigned i;
+	unsigned i, max_basic, max_ext;
 	if (!cpuid_present())
 		return set_error(ERR_NO_CPUID);
-	for (i = 0; i < 32; i++)
+	/* Leaves the CPU does not report are left zeroed instead of executed */
+	raw_data_t_constructor(data);
+	cpu_exec_cpuid(0, data->basic_cpuid[0]);
+	max_basic = data->basic_cpuid[0][EAX];
+	if (max_basic >= MAX_CPUID_LEVEL)
+		max_basic = MAX_CPUID_LEVEL - 1;
+	for (i = 1; i <= max_basic; i++)
 		cpu_exec_cpuid(i, data->basic_cpuid[i]);
-	for (i = 0; i < 32; i++)
+	cpu_exec_cpuid(0x80000000, data->ext_cpuid[0]);
+	max_ext = data->ext_cpuid[0][EAX];
+	max_ext = ((max_ext & 0xffff0000) == 0x80000000) ? (max_ext & 0xffff) : 0;
+	if (max_ext >= MAX_EXT_CPUID_LEVEL)
+		max_ext = MAX_EXT_CPUID_LEVEL - 1;
+	for (i = 1; i <= max_ext; i++)
 		cpu_exec_cpuid(0x80000000 + i, data->ext_cpuid[i]);
-	for (i = 0; i < MAX_INTELFN4_LEVEL; i++) {
-		memset(data->intel_fn4[i], 0, sizeof(data->intel_fn4[i]));
-		data->intel_fn4[i][EAX] = 4;
-		data->intel_fn4[i][ECX] = i;
-		cpu_exec_cpuid_ext(data->intel_fn4[i]);
-	}
-	for (i = 0; i < MAX_INTELFN11_LEVEL; i++) {
-		memset(data->intel_fn11[i], 0, sizeof(data->intel_fn11[i]));
-		data->intel_fn11[i][EAX] = 11;
-		data->intel_fn11[i][ECX] = i;
-		cpu_exec_cpuid_ext(data->intel_fn11[i]);
-	}
-	for (i = 0; i < MAX_INTELFN12H_LEVEL; i++) {
-		memset(data->intel_fn12h[i], 0, sizeof(data->intel_fn12h[i]));
-		data->intel_fn12h[i][EAX] = 0x12;
-		data->intel_fn12h[i][ECX] = i;
-		cpu_exec_cpuid_ext(data->intel_fn12h[i]);
-	}
-	for (i = 0; i < MAX_INTELFN14H_LEVEL; i++) {
-		memset(data->intel_fn14h[i], 0, sizeof(data->intel_fn14h[i]));
-		data->intel_fn14h[i][EAX] = 0x14;
-		data->intel_fn14h[i][ECX] = i;
-		cpu_exec_cpuid_ext(data->intel_fn14h[i]);
-	}
-	for (i = 0; i < MAX_AMDFN8000001DH_LEVEL; i++) {
-		memset(data->amd_fn8000001dh[i], 0, sizeof(data->amd_fn8000001dh[i]));
-		data->amd_fn8000001dh[i][EAX] = 0x8000001d;
-		data->amd_fn8000001dh[i][ECX] = i;
-		cpu_exec_cpuid_ext(data->amd_fn8000001dh[i]);
+	/* Sub-leaf loops stop at the architectural terminator, which is kept */
+	if (max_basic >= 4) {
+		for (i = 0; i < MAX_INTELFN4_LEVEL; i++) {
+			exec_cpuid_subleaf(4, i, data->intel_fn4[i]);
+			if ((data->intel_fn4[i][EAX] & 0x1f) == 0) /* null cache type */
+				break;
+		}
+	}
+	if (max_basic >= 0xb) {
+		for (i = 0; i < MAX_INTELFN11_LEVEL; i++) {
+			exec_cpuid_subleaf(0xb, i, data->intel_fn11[i]);
+			if (((data->intel_fn11[i][ECX] >> 8) & 0xff) == 0) /* invalid level type */
+				break;
+		}
+	}
+	if (max_basic >= 0x12 && (data->basic_cpuid[7][EBX] & (1U << 2))) { /* SGX */
+		for (i = 0; i < MAX_INTELFN12H_LEVEL; i++) {
+			exec_cpuid_subleaf(0x12, i, data->intel_fn12h[i]);
+			if (i >= 2 && (data->intel_fn12h[i][EAX] & 0xf) == 0) /* invalid EPC section */
+				break;
+		}
+	}
+	if (max_basic >= 0x14 && (data->basic_cpuid[7][EBX] & (1U << 25))) { /* Intel PT */
+		for (i = 0; i < MAX_INTELFN14H_LEVEL; i++) {
+			exec_cpuid_subleaf(0x14, i, data->intel_fn14h[i]);
+			if (i >= data->intel_fn14h[0][EAX]) /* max sub-leaf */
+				break;
+		}
+	}
+	if (max_ext >= 0x1d && (data->ext_cpuid[1][ECX] & (1U << 22))) { /* TopologyExtensions */
+		for (i = 0; i < MAX_AMDFN8000001DH_LEVEL; i++) {
+			exec_cpuid_subleaf(0x8000001d, i, data->amd_fn8000001dh[i]);
+			if ((data->amd_fn8000001dh[i][EAX] & 0x1f) == 0) /* null cache type */
+				break;
+		}
 	}
 	return set_error(ERR_OK);
 }
@@ -415,6 +535,317 @@ int cpuid_get_all_raw_data(struct cpu_raw_data_array_t* data)
 	return ret_error;
 }
 
+int cpuid_get_all_raw_data_parallel(struct cpu_raw_data_array_t* data)
+{
+	int ret_error = ERR_OK;
+	int total;
+	logical_cpu_t first, count, i;
+	DWORD started;
+	HANDLE threads[MAXIMUM_WAIT_OBJECTS];
+	struct raw_data_worker_t workers[MAXIMUM_WAIT_OBJECTS];
+
+	if (data == NULL)
+		return set_error(ERR_HANDLE);
+	if (!cpuid_present())
+		return set_error(ERR_NO_CPUID);
+
+	cpu_raw_data_array_t_constructor(data, true);
+	total = get_total_logical_cpus();
+	if (total <= 0)
+		return set_error(ERR_INVCNB);
+	if (total > UINT16_MAX)
+		total = UINT16_MAX;
+	cpuid_grow_raw_data_array(data, (logical_cpu_t) total);
+	if (data->num_raw != total)
+		return set_error(ERR_NO_MEM);
+
+	/* Each slot is owned by exactly one worker, so the array stays ordered by logical CPU.
+	 * WaitForMultipleObjects is limited to MAXIMUM_WAIT_OBJECTS handles, run in batches. */
+	for (first = 0; first < data->num_raw; first += count) {
+		count = data->num_raw - first;
+		if (count > MAXIMUM_WAIT_OBJECTS)
+			count = MAXIMUM_WAIT_OBJECTS;
+		started = 0;
+		for (i = 0; i < count; i++) {
+			workers[i].raw = &data->raw[first + i];
+			workers[i].error = ERR_OK;
+			threads[started] = start_raw_data_worker(first + i, &workers[i]);
+			if (threads[started] != NULL)
+				started++;
+		}
+		if (started > 0)
+			WaitForMultipleObjects(started, threads, TRUE, INFINITE);
+		for (i = 0; i < started; i++)
+			CloseHandle(threads[i]);
+		for (i = 0; i < count; i++)
+			if (ret_error == ERR_OK)
+				ret_error = workers[i].error;
+	}
+
+	return set_error(ret_error);
+}
+
+/* Text dump fields, in the order (and with the names) used by upstream libcpuid */
+static const struct {
+	const char* name;
+	size_t offset;
+	int limit;
+} raw_fields[] = {
+	{ "basic_cpuid",     offsetof(struct cpu_raw_data_t, basic_cpuid),     MAX_CPUID_LEVEL          },
+	{ "ext_cpuid",       offsetof(struct cpu_raw_data_t, ext_cpuid),       MAX_EXT_CPUID_LEVEL      },
+	{ "intel_fn4",       offsetof(struct cpu_raw_data_t, intel_fn4),       MAX_INTELFN4_LEVEL       },
+	{ "intel_fn11",      offsetof(struct cpu_raw_data_t, intel_fn11),      MAX_INTELFN11_LEVEL      },
+	{ "intel_fn12h",     offsetof(struct cpu_raw_data_t, intel_fn12h),     MAX_INTELFN12H_LEVEL     },
+	{ "intel_fn14h",     offsetof(struct cpu_raw_data_t, intel_fn14h),     MAX_INTELFN14H_LEVEL     },
+	{ "amd_fn8000001dh", offsetof(struct cpu_raw_data_t, amd_fn8000001dh), MAX_AMDFN8000001DH_LEVEL },
+};
+
+#define RAW_LOGICAL_CPU_HEADER "_________________ Logical CPU #"
+#define RAW_BINARY_MAGIC "LCPUIDRB"
+
+/* Compact binary dump: this header followed by num_raw cpu_raw_data_t records */
+struct raw_binary_header_t {
+	char magic[8];
+	uint32_t record_size;
+	uint32_t num_raw;
+	uint32_t with_affinity;
+	uint32_t reserved;
+};
+
+static FILE* open_dump(const char* filename, const char* mode, bool write)
+{
+	FILE* f = NULL;
+	if (filename == NULL || filename[0] == '\0')
+		return write ? stdout : stdin;
+	if (fopen_s(&f, filename, mode) != 0)
+		return NULL;
+	return f;
+}
+
+static void close_dump(FILE* f)
+{
+	if (f != stdout && f != stdin)
+		fclose(f);
+}
+
+static void write_raw_data(FILE* f, const struct cpu_raw_data_t* raw)
+{
+	unsigned i;
+	int j;
+
+	for (i = 0; i < COUNT_OF(raw_fields); i++) {
+		const uint32_t (*regs)[NUM_REGS] = (const uint32_t (*)[NUM_REGS]) ((const char*) raw + raw_fields[i].offset);
+		for (j = 0; j < raw_fields[i].limit; j++)
+			fprintf(f, "%s[%d]=%08x %08x %08x %08x\n", raw_fields[i].name, j,
+				regs[j][EAX], regs[j][EBX], regs[j][ECX], regs[j][EDX]);
+	}
+}
+
+/* Returns 1 if the line was understood, 0 if it was ignored and -1 on a syntax error */
+static int parse_raw_line(struct cpu_raw_data_t* raw, const char* token, const char* value)
+{
+	unsigned i;
+	size_t len;
+	char* end;
+	int index, j;
+	uint32_t regs[NUM_REGS];
+
+	if (!strcmp(token, "version") || !strcmp(token, "build_date"))
+		return 1;
+	for (i = 0; i < COUNT_OF(raw_fields); i++) {
+		len = strlen(raw_fields[i].name);
+		if (strncmp(token, raw_fields[i].name, len) || token[len] != '[')
+			continue;
+		index = (int) strtol(&token[len + 1], &end, 10);
+		if (*end != ']' || index < 0 || index >= raw_fields[i].limit)
+			return -1;
+		for (j = 0; j < NUM_REGS; j++) {
+			regs[j] = (uint32_t) strtoul(value, &end, 16);
+			if (end == value)
+				return -1;
+			value = end;
+		}
+		memcpy((char*) raw + raw_fields[i].offset + index * sizeof(regs), regs, sizeof(regs));
+		return 1;
+	}
+	return 0;
+}
+
+/* Reads a text dump. Lines before the first logical CPU header belong to CPU #0,
+ * which is also how dumps of libcpuid 0.5.1 and below (without headers) are read. */
+static int read_raw_text(FILE* f, struct cpu_raw_data_t* single, struct cpu_raw_data_array_t* array)
+{
+	char line[256];
+	char* value;
+	char* eq;
+	size_t len;
+	unsigned long logical_cpu;
+	struct cpu_raw_data_t* raw_ptr = single;
+
+	if (array) {
+		cpuid_grow_raw_data_array(array, 1);
+		if (array->num_raw < 1)
+			return set_error(ERR_NO_MEM);
+		raw_ptr = &array->raw[0];
+	}
+	while (fgets(line, sizeof(line), f)) {
+		len = strlen(line);
+		while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r'))
+			line[--len] = '\0';
+		if (len == 0)
+			continue;
+		if (!strncmp(line, RAW_LOGICAL_CPU_HEADER, sizeof(RAW_LOGICAL_CPU_HEADER) - 1)) {
+			logical_cpu = strtoul(&line[sizeof(RAW_LOGICAL_CPU_HEADER) - 1], NULL, 10);
+			if (array == NULL) {
+				/* A single raw data gets the first logical CPU only */
+				if (logical_cpu > 0)
+					break;
+				continue;
+			}
+			if (logical_cpu >= UINT16_MAX)
+				return set_error(ERR_BADFMT);
+			cpuid_grow_raw_data_array(array, (logical_cpu_t) (logical_cpu + 1));
+			if (array->num_raw < logical_cpu + 1)
+				return set_error(ERR_NO_MEM);
+			array->with_affinity = true;
+			raw_ptr = &array->raw[logical_cpu];
+			continue;
+		}
+		eq = strchr(line, '=');
+		if (eq == NULL || eq == line)
+			return set_error(ERR_BADFMT);
+		*eq = '\0';
+		value = eq + 1;
+		if (parse_raw_line(raw_ptr, line, value) < 0)
+			return set_error(ERR_BADFMT);
+	}
+	return set_error(ERR_OK);
+}
+
+static int read_raw_binary(FILE* f, struct cpu_raw_data_t* single, struct cpu_raw_data_array_t* array)
+{
+	struct raw_binary_header_t header;
+
+	if (fread(&header, sizeof(header), 1, f) != 1
+		|| memcmp(header.magic, RAW_BINARY_MAGIC, sizeof(header.magic))
+		|| header.record_size != sizeof(struct cpu_raw_data_t)
+		|| header.num_raw == 0 || header.num_raw > UINT16_MAX)
+		return set_error(ERR_BADFMT);
+	if (array == NULL)
+		return set_error(fread(single, sizeof(struct cpu_raw_data_t), 1, f) == 1 ? ERR_OK : ERR_BADFMT);
+	cpuid_grow_raw_data_array(array, (logical_cpu_t) header.num_raw);
+	if (array->num_raw != header.num_raw)
+		return set_error(ERR_NO_MEM);
+	array->with_affinity = header.with_affinity ? true : false;
+	if (fread(array->raw, sizeof(struct cpu_raw_data_t), array->num_raw, f) != array->num_raw)
+		return set_error(ERR_BADFMT);
+	return set_error(ERR_OK);
+}
+
+static int read_raw_dump(const char* filename, struct cpu_raw_data_t* single, struct cpu_raw_data_array_t* array)
+{
+	FILE* f;
+	char magic[sizeof(RAW_BINARY_MAGIC) - 1];
+	int ret;
+
+	f = open_dump(filename, "rb", false);
+	if (f == NULL)
+		return set_error(ERR_OPEN);
+	/* stdin cannot be rewound, it is read as text */
+	if (f == stdin)
+		ret = read_raw_text(f, single, array);
+	else if (fread(magic, sizeof(magic), 1, f) == 1 && !memcmp(magic, RAW_BINARY_MAGIC, sizeof(magic))) {
+		rewind(f);
+		ret = read_raw_binary(f, single, array);
+	}
+	else {
+		rewind(f);
+		ret = read_raw_text(f, single, array);
+	}
+	close_dump(f);
+	return ret;
+}
+
+int cpuid_serialize_raw_data(struct cpu_raw_data_t* data, const char* filename)
+{
+	FILE* f;
+
+	if (data == NULL)
+		return set_error(ERR_HANDLE);
+	f = open_dump(filename, "wt", true);
+	if (f == NULL)
+		return set_error(ERR_OPEN);
+	fprintf(f, "version=%s\n", VERSION);
+	write_raw_data(f, data);
+	close_dump(f);
+	return set_error(ERR_OK);
+}
+
+int cpuid_serialize_all_raw_data(struct cpu_raw_data_array_t* data, const char* filename)
+{
+	FILE* f;
+	logical_cpu_t logical_cpu;
+
+	if (data == NULL)
+		return set_error(ERR_HANDLE);
+	f = open_dump(filename, "wt", true);
+	if (f == NULL)
+		return set_error(ERR_OPEN);
+	fprintf(f, "version=%s\n", VERSION);
+	for (logical_cpu = 0; logical_cpu < data->num_raw; logical_cpu++) {
+		fprintf(f, "\n" RAW_LOGICAL_CPU_HEADER "%u _________________\n", (unsigned) logical_cpu);
+		write_raw_data(f, &data->raw[logical_cpu]);
+	}
+	close_dump(f);
+	return set_error(ERR_OK);
+}
+
+int cpuid_serialize_all_raw_data_binary(struct cpu_raw_data_array_t* data, const char* filename)
+{
+	FILE* f;
+	struct raw_binary_header_t header;
+	size_t written;
+
+	if (data == NULL)
+		return set_error(ERR_HANDLE);
+	if (filename == NULL || filename[0] == '\0')
+		return set_error(ERR_OPEN);
+	f = open_dump(filename, "wb", true);
+	if (f == NULL)
+		return set_error(ERR_OPEN);
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, RAW_BINARY_MAGIC, sizeof(header.magic));
+	header.record_size = sizeof(struct cpu_raw_data_t);
+	header.num_raw = data->num_raw;
+	header.with_affinity = data->with_affinity ? 1 : 0;
+	written = fwrite(&header, sizeof(header), 1, f);
+	if (data->num_raw > 0)
+		written += fwrite(data->raw, sizeof(struct cpu_raw_data_t), data->num_raw, f);
+	close_dump(f);
+	return set_error(written == 1 + (size_t) data->num_raw ? ERR_OK : ERR_OPEN);
+}
+
+int cpuid_deserialize_raw_data(struct cpu_raw_data_t* data, const char* filename)
+{
+	if (data == NULL)
+		return set_error(ERR_HANDLE);
+	raw_data_t_constructor(data);
+	return read_raw_dump(filename, data, NULL);
+}
+
+int cpuid_deserialize_all_raw_data(struct cpu_raw_data_array_t* data, const char* filename)
+{
+	int ret;
+
+	if (data == NULL)
+		return set_error(ERR_HANDLE);
+	cpu_raw_data_array_t_constructor(data, false);
+	ret = read_raw_dump(filename, NULL, data);
+	if (ret != ERR_OK)
+		cpuid_free_raw_data_array(data);
+	return ret;
+}
+
 int cpu_ident_internal(struct cpu_raw_data_t* raw, struct cpu_id_t* data, struct internal_id_info_t* internal)
 {
 	int r;
@@ -497,7 +928,7 @@ int cpu_identify_all(struct cpu_raw_data_array_t* raw_array, struct system_id_t*
 	if (system == NULL)
 		return set_error(ERR_HANDLE);
 	if (!raw_array) {
-		if ((ret_error = cpuid_get_all_raw_data(&my_raw_array)) < 0)
+		if ((ret_error = cpuid_get_all_raw_data_parallel(&my_raw_array)) < 0)
 			return set_error(ret_error);
 		raw_array = &my_raw_array;
 	}
@@ -557,7 +988,7 @@ int cpu_request_core_type(cpu_purpose_t purpose, struct cpu_raw_data_array_t* ra
 	struct internal_id_info_t throwaway;
 
 	if (!raw_array) {
-		if ((error = cpuid_get_all_raw_data(&my_raw_array)) < 0)
+		if ((error = cpuid_get_all_raw_data_parallel(&my_raw_array)) < 0)
 			return set_error(error);
 		raw_array = &my_raw_array;
 	}
@@ -681,6 +681,20 @@ struct cpu_mark_t {
  */
 int cpuid_get_total_cpus(void);
 
+struct _GROUP_AFFINITY;
+
+/**
+ * @brief Maps a logical CPU index to its processor group and affinity mask
+ *
+ * Logical CPUs are numbered across all processor groups, in group order.
+ * The result can be passed to SetThreadGroupAffinity() to pin a thread.
+ *
+ * @param logical_cpu - the logical CPU index
+ * @param group_affinity - where the group and single-bit mask are stored
+ * @returns nonzero if logical_cpu exists, zero otherwise.
+ */
+int cpuid_get_cpu_group_affinity(logical_cpu_t logical_cpu, struct _GROUP_AFFINITY* group_affinity);
+
 /**
  * @brief Checks if the CPUID instruction is supported
  * @retval 1 if CPUID is present
@@ -707,9 +721,32 @@ void cpu_exec_cpuid(uint32_t eax, uint32_t* regs);
  */
 void cpu_exec_cpuid_ext(uint32_t* regs);
 
+/**
+ * @brief Executes a single CPUID leaf on demand
+ * @param leaf - the value of the EAX register when executing CPUID
+ * @param subleaf - the value of the ECX register when executing CPUID
+ * @param regs - the results will be stored here. regs[0] = EAX, regs[1] = EBX, ...
+ * @note Use this instead of \ref cpuid_get_raw_data when only a few leaves are
+ *       needed, the rest are never executed. Basic and extended leaves above the
+ *       maximum reported by leaf 0 and 80000000h are not executed and read as zero.
+ * @returns zero if successful, ERR_INVRANGE if the leaf is not reported by the CPU
+ *          and some other negative number on error.
+ *          The error message can be obtained by calling \ref cpuid_error.
+ *          @see cpu_error_t
+ */
+int cpuid_get_raw_leaf(uint32_t leaf, uint32_t subleaf, uint32_t* regs);
+
+/**
+ * @brief Returns how many times the CPUID instruction was executed by libcpuid
+ * @note Under a hypervisor, each CPUID is a VM exit.
+ */
+long cpuid_get_exec_count(void);
+
 /**
  * @brief Obtains the raw CPUID data from the current CPU
  * @param data - a pointer to cpu_raw_data_t structure
+ * @note Only the leaves and sub-leaves reported by the CPU are executed,
+ *       everything else is left zeroed.
  * @returns zero if successful, and some negative number on error.
  *          The error message can be obtained by calling \ref cpuid_error.
  *          @see cpu_error_t
@@ -727,6 +764,101 @@ int cpuid_get_raw_data(struct cpu_raw_data_t* data);
  */
 int cpuid_get_all_raw_data(struct cpu_raw_data_array_t* data);
 
+/**
+ * @brief Obtains the raw CPUID data from all CPUs in parallel
+ * @param data - a pointer to cpu_raw_data_array_t structure
+ * @note Same result as cpuid_get_all_raw_data(), ordered by logical CPU index,
+ *       but each CPU is read by a short-lived worker thread pinned to it instead
+ *       of migrating the calling thread. Much faster under hypervisors, where
+ *       every CPUID leaf traps to the VMM. The affinity of the calling thread is
+ *       left untouched.
+ * @note As the memory is dynamically allocated, be sure to call
+ *       cpuid_free_raw_data_array() after you're done with the data
+ * @returns zero if successful, and some negative number on error.
+ *          The error message can be obtained by calling \ref cpuid_error.
+ *          @see cpu_error_t
+ */
+int cpuid_get_all_raw_data_parallel(struct cpu_raw_data_array_t* data);
+
+/**
+ * @brief Writes the raw CPUID data to a text file
+ * @param data - a pointer to cpu_raw_data_t structure
+ * @param filename - the path of the file, where the serialized data should be
+ *                   written. If empty, stdout will be used.
+ * @note This is intended primarily for debugging. On some processor, which is
+ *       not currently supported or not completely recognized by cpu_identify,
+ *       one can still successfully get the raw data and write it to a file.
+ *       libcpuid developers can later import this file and debug the detection
+ *       code as if running on the actual hardware.
+ *       The file is simple text format of "something=value" pairs. Version info
+ *       is also written, but the format is not intended to be neither backward-
+ *       nor forward compatible.
+ * @returns zero if successful, and some negative number on error.
+ *          The error message can be obtained by calling \ref cpuid_error.
+ *          @see cpu_error_t
+ */
+int cpuid_serialize_raw_data(struct cpu_raw_data_t* data, const char* filename);
+
+/**
+ * @brief Writes all the raw CPUID data to a text file
+ * @param data - a pointer to cpu_raw_data_array_t structure
+ * @param filename - the path of the file, where the serialized data for all CPUs
+ *                   should be written. If empty, stdout will be used.
+ * @note Same format as cpuid_serialize_raw_data(), with a
+ *       "Logical CPU #N" header before the data of each logical CPU.
+ * @returns zero if successful, and some negative number on error.
+ *          The error message can be obtained by calling \ref cpuid_error.
+ *          @see cpu_error_t
+ */
+int cpuid_serialize_all_raw_data(struct cpu_raw_data_array_t* data, const char* filename);
+
+/**
+ * @brief Writes all the raw CPUID data to a compact binary file
+ * @param data - a pointer to cpu_raw_data_array_t structure
+ * @param filename - the path of the file, must not be empty.
+ * @note The file holds a small header and one cpu_raw_data_t record per
+ *       logical CPU. It is only readable by a libcpuid build with the same
+ *       cpu_raw_data_t layout. cpuid_deserialize_raw_data() and
+ *       cpuid_deserialize_all_raw_data() recognize it automatically.
+ * @returns zero if successful, and some negative number on error.
+ *          The error message can be obtained by calling \ref cpuid_error.
+ *          @see cpu_error_t
+ */
+int cpuid_serialize_all_raw_data_binary(struct cpu_raw_data_array_t* data, const char* filename);
+
+/**
+ * @brief Reads raw CPUID data from file
+ * @param data - a pointer to cpu_raw_data_t structure. The deserialized data will
+ *               be written here.
+ * @param filename - the path of the file, containing the serialized raw data.
+ *                   If empty, stdin will be used.
+ * @note This function may fail, if the file is created by different version of
+ *       the library. Also, see the notes on cpuid_serialize_raw_data.
+ *       If the file holds several logical CPUs, the first one is read.
+ * @returns zero if successful, and some negative number on error.
+ *          The error message can be obtained by calling \ref cpuid_error.
+ *          @see cpu_error_t
+ */
+int cpuid_deserialize_raw_data(struct cpu_raw_data_t* data, const char* filename);
+
+/**
+ * @brief Reads all raw CPUID data from file
+ * @param data - a pointer to cpu_raw_data_array_t structure. The deserialized array data will
+ *               be written here.
+ * @param filename - the path of the file, containing the serialized raw data.
+ *                   If empty, stdin will be used.
+ * @note This function may fail, if the file is created by different version of
+ *       the library. Also, see the notes on cpuid_serialize_all_raw_data.
+ *       Dumps without "Logical CPU" headers are read as a single CPU with
+ *       with_affinity set to false.
+ * @note As the memory is dynamically allocated, be sure to call
+ *       cpuid_free_raw_data_array() after you're done with the data
+ * @returns zero if successful, and some negative number on error.
+ *          The error message can be obtained by calling \ref cpuid_error.
+ *          @see cpu_error_t
+ */
+int cpuid_deserialize_all_raw_data(struct cpu_raw_data_array_t* data, const char* filename);
+
 /**
  * @brief Identifies the CPU
  * @param raw - Input - a pointer to the raw CPUID data, which is obtained
@@ -757,7 +889,7 @@ int cpu_identify(struct cpu_raw_data_t* raw, struct cpu_id_t* data);
  * @param raw_array - Input - a pointer to the array of raw CPUID data, which is obtained
  *              either by cpuid_get_all_raw_data or cpuid_deserialize_all_raw_data.
  *              Can also be NULL, in which case the functions calls
- *              cpuid_get_all_raw_data itself.
+ *              cpuid_get_all_raw_data_parallel itself.
  * @param system - Output - the decoded CPU features/info is written here for each CPU type.
  * @note The function is similar to cpu_identify. Refer to cpu_identify notes.
  * @note As the memory is dynamically allocated, be sure to call
@@ -774,7 +906,7 @@ int cpu_identify_all(struct cpu_raw_data_array_t* raw_array, struct system_id_t*
  * @param raw_array - Optional input - a pointer to the array of raw CPUID data, which is obtained
  *              either by cpuid_get_all_raw_data or cpuid_deserialize_all_raw_data.
  *              Can also be NULL, in which case the functions calls
- *              cpuid_get_all_raw_data itself.
+ *              cpuid_get_all_raw_data_parallel itself.
  * @param data - Output - the decoded CPU features/info is written here.
  * @returns zero if successful, and some negative number on error (like ERR_NOT_FOUND if CPU type not found).
  *          The error message can be obtained by calling \ref cpuid_error.
@@ -858,6 +990,20 @@ const char* cpuid_error(void);
  */
 void cpu_rdtsc(uint64_t* result);
 
+/**
+ * @brief Executes RDTSCP
+ *
+ * Unlike RDTSC, RDTSCP waits until all previous instructions have executed
+ * and also returns IA32_TSC_AUX, which the OS sets to the current CPU number.
+ *
+ * @param result - a pointer to a 64-bit unsigned integer, where the TSC value
+ *                 will be stored
+ * @param aux - where IA32_TSC_AUX will be stored, may be NULL
+ *
+ * @note Check for RDTSCP support (CPUID 80000001h EDX[27]) first.
+ */
+void cpu_rdtscp(uint64_t* result, uint32_t* aux);
+
 /**
  * @brief Store TSC and timing info
  *
@@ -1028,6 +1174,50 @@ int cpu_clock_by_ic(int millis, int runs);
  */
 int cpu_clock(void);
 
+/**
+ * @brief Time sources measured by \ref cpu_time_source_measure
+ */
+typedef enum {
+	TIME_SOURCE_QPC = 0,	/*!< QueryPerformanceCounter, which sys_precise_clock is built on */
+	TIME_SOURCE_RDTSC,	/*!< RDTSC instruction */
+	TIME_SOURCE_RDTSCP,	/*!< RDTSCP instruction */
+	NUM_TIME_SOURCES,
+} cpu_time_source_t;
+
+/**
+ * @brief The result of \ref cpu_time_source_measure
+ */
+struct cpu_time_source_stats_t {
+	/** ticks per second, the TSC one is measured against QPC */
+	uint64_t frequency;
+
+	/** average cost of one read in nanoseconds */
+	double overhead_ns;
+
+	/** smallest observed step between two consecutive reads in nanoseconds */
+	double resolution_ns;
+};
+
+/**
+ * @brief Returns the short name of a time source
+ * @param source - the time source
+ * @returns a constant string like "QPC" or "RDTSC".
+ */
+const char* cpu_time_source_str(cpu_time_source_t source);
+
+/**
+ * @brief Measures the overhead and resolution of a time source
+ * @param source - the time source
+ * @param stats - the results will be stored here
+ * @note The first call with a TSC source sleeps 20 ms to measure the TSC
+ *       frequency. Pin the thread first for stable results.
+ * @returns zero if successful, ERR_NO_RDTSC if the instruction is not
+ *          supported and some other negative number on error.
+ *          The error message can be obtained by calling \ref cpuid_error.
+ *          @see cpu_error_t
+ */
+int cpu_time_source_measure(cpu_time_source_t source, struct cpu_time_source_stats_t* stats);
+
 
 /**
  * @brief The return value of cpuid_get_epc().
@@ -1153,8 +1343,24 @@ typedef enum {
 	INFO_BUS_CLOCK,            /*!< The main bus clock in MHz,
 	                            e.g., FSB/QPI/DMI/HT base clock,
 	                            multiplied by 100. */
+	INFO_EFFECTIVE_CLOCK,      /*!< The average core clock in MHz while the
+	                            core was active, from APERF/MPERF. */
 } cpu_msrinfo_request_t;
 
+/**
+ * @brief One APERF/MPERF/TSC measurement window
+ *
+ * The values derived from APERF/MPERF and the TSC rate share this window
+ * instead of running one busy loop each, @see cpu_msr_session_begin
+ */
+struct msr_session_t {
+	struct msr_driver_t* handle;	/*!< The MSR driver the window was read with */
+	int perf_valid;			/*!< 1 if both APERF and MPERF were read */
+	uint64_t mperf;			/*!< MPERF ticks over the window */
+	uint64_t aperf;			/*!< APERF ticks over the window */
+	struct cpu_mark_t mark;		/*!< TSC ticks and microseconds over the window */
+};
+
 /**
  * @brief Similar to \ref cpu_rdmsr, but extract a range of bits
  *
@@ -1172,6 +1378,31 @@ typedef enum {
 int cpu_rdmsr_range(struct msr_driver_t* handle, uint32_t msr_index, uint8_t highbit,
                     uint8_t lowbit, uint64_t* result);
 
+/**
+ * @brief Reads several MSRs on one logical CPU
+ *
+ * Equivalent to calling \ref cpu_rdmsr for every entry of msrs, but the
+ * calling thread is moved to the target CPU only once for the whole batch.
+ * With cpu = -1 the thread is pinned to the CPU it runs on at the call, so
+ * every value of the batch comes from the same CPU.
+ *
+ * @param handle - a handle to the MSR reader driver, as created by
+ *                 cpu_msr_driver_open
+ * @param cpu - the logical CPU to read from, or -1 for the current CPU
+ * @param msrs - the numeric IDs of the MSRs you want to read
+ * @param result - an array of count 64-bit integers, where the MSR values are
+ *                 stored. Entries that cannot be read are set to zero.
+ * @param valid - optional array of count flags, set to 1 for every MSR that
+ *                was read and to 0 otherwise. May be NULL.
+ * @param count - the number of MSRs in msrs
+ *
+ * @returns the number of MSRs read, or some negative number on error.
+ *          The error message can be obtained by calling \ref cpuid_error.
+ *          @see cpu_error_t
+ */
+int cpu_rdmsr_batch(struct msr_driver_t* handle, int cpu, const uint32_t* msrs, uint64_t* result,
+                    uint8_t* valid, int count);
+
 /**
  * @brief Reads extended CPU information from Model-Specific Registers.
  * @param handle - a handle to an open MSR driver, @see cpu_msr_driver_open
@@ -1188,6 +1419,37 @@ int cpu_rdmsr_range(struct msr_driver_t* handle, uint32_t msr_index, uint8_t hig
 int cpu_msrinfo(struct msr_driver_t* handle, cpu_msrinfo_request_t which);
 #define CPU_INVALID_VALUE 0x3fffffff
 
+/**
+ * @brief Samples APERF, MPERF and the TSC over one busy window
+ *
+ * The calling thread stays on its current CPU for the whole window.
+ *
+ * @param handle - a handle to an open MSR driver, @see cpu_msr_driver_open
+ * @param session - the session to fill
+ * @param millis - the length of the window in milliseconds
+ *
+ * @returns zero if successful, and some negative number on error.
+ *          A CPU without APERF/MPERF still gets a TSC window, with
+ *          session->perf_valid set to 0.
+ */
+int cpu_msr_session_begin(struct msr_driver_t* handle, struct msr_session_t* session, int millis);
+
+/**
+ * @brief Same as \ref cpu_msrinfo, but derives INFO_MPERF, INFO_APERF,
+ *        INFO_CUR_MULTIPLIER, INFO_EFFECTIVE_CLOCK and INFO_BUS_CLOCK from
+ *        the window sampled by \ref cpu_msr_session_begin.
+ *
+ * INFO_CUR_MULTIPLIER is the average ratio over the window. Requests that do
+ * not depend on the window, or that the window cannot answer, are passed to
+ * \ref cpu_msrinfo.
+ *
+ * @param session - a session filled by \ref cpu_msr_session_begin
+ * @param which - which info field should be returned
+ * @retval - the requested value, or CPU_INVALID_VALUE
+ * @note This function is not MT-safe, @see cpu_msrinfo
+ */
+int cpu_msrinfo_session(struct msr_session_t* session, cpu_msrinfo_request_t which);
+
 /**
  * @brief Closes an open MSR driver
  *
@@ -93,6 +93,141 @@ int match_cpu_codename(const struct match_entry_t* matchtable, int count,
 	return bestscore;
 }
 
+static int bucket_cmp(const struct match_entry_t* a, const struct match_entry_t* b)
+{
+	if (a->family != b->family) return a->family < b->family ? -1 : 1;
+	if (a->ext_family != b->ext_family) return a->ext_family < b->ext_family ? -1 : 1;
+	if (a->ext_model != b->ext_model) return a->ext_model < b->ext_model ? -1 : 1;
+	return 0;
+}
+
+static uint32_t value_bit(int value)
+{
+	/* Wildcards (-1) never score */
+	return value < 0 ? 0 : 1u << (value & 31);
+}
+
+static BOOL CALLBACK build_match_index(PINIT_ONCE once, PVOID param, PVOID* context)
+{
+	struct match_index_t* index = param;
+	const struct match_entry_t* table = index->table;
+	struct match_bucket_t* bucket = NULL;
+	int i, j;
+
+	/* Stable insertion sort, runs once per table */
+	for (i = 0; i < index->count; i++) {
+		for (j = i; j > 0 && bucket_cmp(&table[index->order[j - 1]], &table[i]) > 0; j--)
+			index->order[j] = index->order[j - 1];
+		index->order[j] = i;
+	}
+
+	index->num_buckets = 0;
+	for (i = 0; i < index->count; i++) {
+		const struct match_entry_t* entry = &table[index->order[i]];
+		if (bucket == NULL || bucket_cmp(&table[index->order[bucket->first]], entry) != 0) {
+			bucket = &index->buckets[index->num_buckets++];
+			memset(bucket, 0, sizeof(struct match_bucket_t));
+			bucket->family     = entry->family;
+			bucket->ext_family = entry->ext_family;
+			bucket->ext_model  = entry->ext_model;
+			bucket->first      = i;
+			bucket->min_index  = index->order[i];
+		}
+		bucket->count++;
+		bucket->models     |= value_bit(entry->model);
+		bucket->steppings  |= value_bit(entry->stepping);
+		bucket->ncores     |= value_bit(entry->ncores);
+		bucket->brand_codes |= value_bit(entry->brand_code);
+		bucket->model_codes |= value_bit(entry->model_code);
+		bucket->model_bits |= entry->model_bits;
+		if ((int) popcount64(entry->model_bits) > bucket->max_bits)
+			bucket->max_bits = (int) popcount64(entry->model_bits);
+	}
+	return TRUE;
+}
+
+/* Upper bound of score() over the bucket, must follow score() */
+static int bucket_bound(const struct match_bucket_t* bucket, const struct cpu_id_t* data,
+                        int brand_code, uint64_t bits, int model_code)
+{
+	int res = 0, common;
+	if (bucket->family     == data->family    ) res += 2;
+	if (bucket->ext_family == data->ext_family) res += 2;
+	if (bucket->ext_model  == data->ext_model ) res += 2;
+	if (bucket->models    & value_bit(data->model   )) res += 2;
+	if (bucket->steppings & value_bit(data->stepping)) res += 2;
+	if (bucket->ncores    & value_bit(data->num_cores)) res += 2;
+	res += 1 + 1; /* l2cache, l3cache */
+	if (bucket->brand_codes & value_bit(brand_code)) res += 2;
+	if (bucket->model_codes & value_bit(model_code)) res += 2;
+
+	common = (int) popcount64(bucket->model_bits & bits);
+	res += (common < bucket->max_bits ? common : bucket->max_bits) * 2;
+	return res;
+}
+
+static void score_bucket(const struct match_index_t* index, const struct match_bucket_t* bucket,
+                         const struct cpu_id_t* data, int brand_code, uint64_t bits, int model_code,
+                         int* bestscore, int* bestindex)
+{
+	int i, t;
+
+	for (i = bucket->first; i < bucket->first + bucket->count; i++) {
+		const int entry = index->order[i];
+		t = score(&index->table[entry], data, brand_code, bits, model_code);
+		/* The first entry of the table wins a tie, as in match_cpu_codename */
+		if (t > *bestscore || (t == *bestscore && entry < *bestindex)) {
+			*bestscore = t;
+			*bestindex = entry;
+		}
+	}
+}
+
+int match_cpu_codename_indexed(struct match_index_t* index,
+                               struct cpu_id_t* data, int brand_code, uint64_t bits,
+                               int model_code)
+{
+	struct match_entry_t key;
+	int bestscore = -1;
+	int bestindex = 0;
+	int exact = -1;
+	int lo, hi, mid, c, i, bound;
+
+	InitOnceExecuteOnce(&index->once, build_match_index, index, NULL);
+
+	/* The bucket with the same family, ext_family and ext_model usually holds the winner */
+	key.family     = data->family;
+	key.ext_family = data->ext_family;
+	key.ext_model  = data->ext_model;
+	lo = 0;
+	hi = index->num_buckets - 1;
+	while (lo <= hi) {
+		mid = (lo + hi) / 2;
+		c = bucket_cmp(&index->table[index->order[index->buckets[mid].first]], &key);
+		if (c == 0) {
+			exact = mid;
+			break;
+		}
+		if (c < 0)
+			lo = mid + 1;
+		else
+			hi = mid - 1;
+	}
+	if (exact >= 0)
+		score_bucket(index, &index->buckets[exact], data, brand_code, bits, model_code, &bestscore, &bestindex);
+
+	for (i = 0; i < index->num_buckets; i++) {
+		if (i == exact)
+			continue;
+		bound = bucket_bound(&index->buckets[i], data, brand_code, bits, model_code);
+		if (bound < bestscore || (bound == bestscore && index->buckets[i].min_index > bestindex))
+			continue;
+		score_bucket(index, &index->buckets[i], data, brand_code, bits, model_code, &bestscore, &bestindex);
+	}
+	strcpy_s(data->cpu_codename, sizeof(data->cpu_codename), index->table[bestindex].name);
+	return bestscore;
+}
+
 static int xmatch_entry(char c, const char* p)
 {
 	int i, j;
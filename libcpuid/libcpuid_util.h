@@ -26,6 +26,8 @@
 #ifndef __LIBCPUID_UTIL_H__
 #define __LIBCPUID_UTIL_H__
 
+#include <windows.h>
+
 #define COUNT_OF(array) (sizeof(array) / sizeof(array[0]))
 
 struct feature_map_t {
@@ -49,6 +51,38 @@ int match_cpu_codename(const struct match_entry_t* matchtable, int count,
                        struct cpu_id_t* data, int brand_code, uint64_t bits,
                        int model_code);
 
+/* Entries of a match table sharing the same family, ext_family and ext_model */
+struct match_bucket_t {
+	int family, ext_family, ext_model;
+	int first, count;       /* range in match_index_t::order */
+	int min_index;          /* lowest table index in the bucket */
+	uint32_t models;        /* bit (model & 31) set for every entry model */
+	uint32_t steppings;     /* bit (stepping & 31) set for every entry stepping */
+	uint32_t ncores;        /* same for ncores, brand_code and model_code */
+	uint32_t brand_codes;
+	uint32_t model_codes;
+	uint64_t model_bits;    /* union of the entries' model_bits */
+	int max_bits;           /* highest number of model_bits set in one entry */
+};
+
+/* Match table index, built once on first use by match_cpu_codename_indexed */
+struct match_index_t {
+	const struct match_entry_t* table;
+	int count;
+	int* order;                     /* table indices sorted by bucket, then by index */
+	struct match_bucket_t* buckets; /* at least count entries */
+	int num_buckets;
+	INIT_ONCE once;                 /* cpu_identify may run on several threads */
+};
+
+#define MATCH_INDEX_INIT(table, order, buckets) \
+	{ table, (int) COUNT_OF(table), order, buckets, 0, INIT_ONCE_STATIC_INIT }
+
+// same result as match_cpu_codename, but skips buckets that cannot beat the best score:
+int match_cpu_codename_indexed(struct match_index_t* index,
+                               struct cpu_id_t* data, int brand_code, uint64_t bits,
+                               int model_code);
+
 /*
  * Seek for a pattern in `haystack'.
  * Pattern may be an fixed string, or contain the special metacharacters
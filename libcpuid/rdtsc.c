@@ -30,6 +30,11 @@
 #include "libcpuid_util.h"
 #include "asm-bits.h"
 #include "rdtsc.h"
+#if defined(COMPILER_MICROSOFT)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
 
 void sys_precise_clock(uint64_t *result)
 {
@@ -42,6 +47,14 @@ void sys_precise_clock(uint64_t *result)
 	*result = (uint64_t) ( c * 1000000.0 / f );
 }
 
+void cpu_rdtscp(uint64_t* result, uint32_t* aux)
+{
+	unsigned int tsc_aux;
+	*result = __rdtscp(&tsc_aux);
+	if (aux)
+		*aux = tsc_aux;
+}
+
 /* out = a - b */
 static void mark_t_subtract(struct cpu_mark_t* a, struct cpu_mark_t* b, struct cpu_mark_t *out)
 {
@@ -271,3 +284,100 @@ int cpu_clock(void)
 		result = cpu_clock_measure(200, 1);
 	return result;
 }
+
+#define TIME_SOURCE_READS 10000
+
+static const char* time_source_names[NUM_TIME_SOURCES] = {
+	"QPC",
+	"RDTSC",
+	"RDTSCP",
+};
+
+const char* cpu_time_source_str(cpu_time_source_t source)
+{
+	if (source < 0 || source >= NUM_TIME_SOURCES)
+		return "";
+	return time_source_names[source];
+}
+
+static uint64_t read_time_source(cpu_time_source_t source)
+{
+	LARGE_INTEGER counter;
+	uint64_t tsc;
+
+	switch (source) {
+		case TIME_SOURCE_QPC:
+			QueryPerformanceCounter(&counter);
+			return (uint64_t) counter.QuadPart;
+		case TIME_SOURCE_RDTSC:
+			cpu_rdtsc(&tsc);
+			return tsc;
+		default:
+			cpu_rdtscp(&tsc, NULL);
+			return tsc;
+	}
+}
+
+/* The TSC runs on during Sleep() if it is invariant, which is what callers care about */
+static uint64_t tsc_frequency(void)
+{
+	static uint64_t freq = 0;
+	struct cpu_mark_t mark;
+
+	if (freq == 0) {
+		cpu_tsc_mark(&mark);
+		Sleep(20);
+		cpu_tsc_unmark(&mark);
+		if (mark.sys_clock > 0)
+			freq = mark.tsc * 1000000ULL / mark.sys_clock;
+	}
+	return freq;
+}
+
+int cpu_time_source_measure(cpu_time_source_t source, struct cpu_time_source_stats_t* stats)
+{
+	uint32_t regs[NUM_REGS];
+	LARGE_INTEGER freq, begin, end;
+	uint64_t prev, cur, step = 0;
+	int i;
+
+	if (stats == NULL)
+		return set_error(ERR_HANDLE);
+	memset(stats, 0, sizeof(struct cpu_time_source_stats_t));
+	switch (source) {
+		case TIME_SOURCE_QPC:
+			break;
+		case TIME_SOURCE_RDTSC:
+			if (cpuid_get_raw_leaf(1, 0, regs) < 0 || !(regs[EDX] & (1U << 4)))
+				return set_error(ERR_NO_RDTSC);
+			break;
+		case TIME_SOURCE_RDTSCP:
+			if (cpuid_get_raw_leaf(0x80000001, 0, regs) < 0 || !(regs[EDX] & (1U << 27)))
+				return set_error(ERR_NO_RDTSC);
+			break;
+		default:
+			return set_error(ERR_INVRANGE);
+	}
+	QueryPerformanceFrequency(&freq);
+	stats->frequency = source == TIME_SOURCE_QPC ? (uint64_t) freq.QuadPart : tsc_frequency();
+	if (stats->frequency == 0)
+		return set_error(ERR_NO_RDTSC);
+
+	/* Back-to-back reads, timed by QPC */
+	QueryPerformanceCounter(&begin);
+	for (i = 0; i < TIME_SOURCE_READS; i++)
+		read_time_source(source);
+	QueryPerformanceCounter(&end);
+	stats->overhead_ns = (double) (end.QuadPart - begin.QuadPart) * 1e9 / (double) freq.QuadPart / TIME_SOURCE_READS;
+
+	/* Smallest non-zero step between two consecutive reads */
+	prev = read_time_source(source);
+	for (i = 0; i < TIME_SOURCE_READS; i++) {
+		cur = read_time_source(source);
+		if (cur > prev && (step == 0 || cur - prev < step))
+			step = cur - prev;
+		prev = cur;
+	}
+	stats->resolution_ns = (double) step * 1e9 / (double) stats->frequency;
+	return set_error(ERR_OK);
+}
@@ -328,6 +328,10 @@ const struct match_entry_t cpudb_amd[] = {
 	{ 15,  9, -1, 22,    9,   8,    -1,    -1, NC, OPTERON_            ,     0, "Magny-Cours Opteron"           },
 };
 
+static int amd_match_order[COUNT_OF(cpudb_amd)];
+static struct match_bucket_t amd_match_buckets[COUNT_OF(cpudb_amd)];
+static struct match_index_t amd_match_index = MATCH_INDEX_INIT(cpudb_amd, amd_match_order, amd_match_buckets);
+
 
 static void load_amd_features(struct cpu_raw_data_t* raw, struct cpu_id_t* data)
 {
@@ -592,8 +596,8 @@ static void decode_amd_codename(struct cpu_raw_data_t* raw, struct cpu_id_t* dat
 
 	internal->code.amd = code_and_bits.code;
 	internal->bits = code_and_bits.bits;
-	internal->score = match_cpu_codename(cpudb_amd, COUNT_OF(cpudb_amd), data, code_and_bits.code,
-	                                     code_and_bits.bits, model_code);
+	internal->score = match_cpu_codename_indexed(&amd_match_index, data, code_and_bits.code,
+	                                             code_and_bits.bits, model_code);
 }
 
 int cpuid_identify_amd(struct cpu_raw_data_t* raw, struct cpu_id_t* data, struct internal_id_info_t* internal)
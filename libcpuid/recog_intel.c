@@ -442,6 +442,10 @@ const struct match_entry_t cpudb_intel[] = {
 	{ 15, -1, -1, 16, -1,   1,    -1,    -1, NC, 0             ,     0, "Itanium 2"                },
 };
 
+static int intel_match_order[COUNT_OF(cpudb_intel)];
+static struct match_bucket_t intel_match_buckets[COUNT_OF(cpudb_intel)];
+static struct match_index_t intel_match_index = MATCH_INDEX_INIT(cpudb_intel, intel_match_order, intel_match_buckets);
+
 
 static void load_intel_features(struct cpu_raw_data_t* raw, struct cpu_id_t* data)
 {
@@ -1024,7 +1028,7 @@ int cpuid_identify_intel(struct cpu_raw_data_t* raw, struct cpu_id_t* data, stru
 		decode_intel_sgx_features(raw, data);
 	}
 
-	internal->score = match_cpu_codename(cpudb_intel, COUNT_OF(cpudb_intel), data,
+	internal->score = match_cpu_codename_indexed(&intel_match_index, data,
 		brand.code, brand.bits, model_code);
 	return 0;
 }
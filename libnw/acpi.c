@@ -4,15 +4,18 @@
 #include "libnw.h"
 #include "utils.h"
 #include "acpi.h"
+#include "aml.h"
+
+static const char* d_human_sizes[6] =
+{ "B", "KB", "MB", "GB", "TB", "PB", };
 
 static void
 PrintU8Str(PNODE pNode, LPCSTR Key, UINT8 *Str, DWORD Len)
 {
-	DWORD i = 0;
-	NWLC->NwBuf[0] = '\0';
-	for (i = 0; i < Len; i++)
-		snprintf(NWLC->NwBuf, NWINFO_BUFSZ, "%s%c", NWLC->NwBuf, Str[i]);
-	NWL_NodeAttrSet(pNode, Key, NWLC->NwBuf, 0);
+	NWL_STRBUF sb;
+	NWL_StrBufInit(&sb, NWLC->NwBuf, NWINFO_BUFSZ);
+	NWL_StrBufAppendBytes(&sb, Str, Len);
+	NWL_NodeAttrSet(pNode, Key, sb.Buf, 0);
 }
 
 static void
@@ -27,15 +30,302 @@ PrintMSDM(PNODE pNode, struct acpi_table_header* Hdr)
 	PrintU8Str(pNode, "Product Key", msdm->data, 29);
 }
 
+static const CHAR*
+MadtTypeToStr(UINT8 type)
+{
+	switch (type)
+	{
+	case ACPI_MADT_LAPIC: return "Local APIC";
+	case ACPI_MADT_IOAPIC: return "I/O APIC";
+	case ACPI_MADT_INT_OVERRIDE: return "Interrupt Source Override";
+	case ACPI_MADT_NMI_SOURCE: return "NMI Source";
+	case ACPI_MADT_LAPIC_NMI: return "Local APIC NMI";
+	case ACPI_MADT_LAPIC_OVERRIDE: return "Local APIC Address Override";
+	case ACPI_MADT_IOSAPIC: return "I/O SAPIC";
+	case ACPI_MADT_LSAPIC: return "Local SAPIC";
+	case ACPI_MADT_PLATFORM_INT: return "Platform Interrupt Sources";
+	case ACPI_MADT_X2APIC: return "Local x2APIC";
+	case ACPI_MADT_X2APIC_NMI: return "Local x2APIC NMI";
+	case ACPI_MADT_GICC: return "GIC CPU Interface";
+	case ACPI_MADT_GICD: return "GIC Distributor";
+	case ACPI_MADT_GIC_MSI: return "GIC MSI Frame";
+	case ACPI_MADT_GICR: return "GIC Redistributor";
+	case ACPI_MADT_GIC_ITS: return "GIC ITS";
+	}
+	return "Reserved";
+}
+
+static void
+PrintMpsIntiFlags(PNODE pNode, UINT16 flags)
+{
+	switch (flags & 0x03)
+	{
+	case 0: NWL_NodeAttrSet(pNode, "Polarity", "Conforms", 0); break;
+	case 1: NWL_NodeAttrSet(pNode, "Polarity", "Active High", 0); break;
+	case 3: NWL_NodeAttrSet(pNode, "Polarity", "Active Low", 0); break;
+	default: NWL_NodeAttrSet(pNode, "Polarity", "Reserved", 0); break;
+	}
+	switch ((flags >> 2) & 0x03)
+	{
+	case 0: NWL_NodeAttrSet(pNode, "Trigger Mode", "Conforms", 0); break;
+	case 1: NWL_NodeAttrSet(pNode, "Trigger Mode", "Edge", 0); break;
+	case 3: NWL_NodeAttrSet(pNode, "Trigger Mode", "Level", 0); break;
+	default: NWL_NodeAttrSet(pNode, "Trigger Mode", "Reserved", 0); break;
+	}
+}
+
+static void
+PrintProcessorFlags(PNODE pNode, UINT32 flags, UINT32 online_capable)
+{
+	NWL_NodeAttrSetBool(pNode, "Enabled", flags & ACPI_MADT_ENABLED, 0);
+	NWL_NodeAttrSetBool(pNode, "Online Capable", flags & online_capable, 0);
+}
+
+static int
+CompareU32(const void* a, const void* b)
+{
+	UINT32 x = *(const UINT32*)a;
+	UINT32 y = *(const UINT32*)b;
+	return (x > y) - (x < y);
+}
+
+// Sort IDs and print them as ranges into NwBuf, e.g. "0-15,32-47".
+static LPCSTR
+FormatIdRanges(UINT32* ids, UINT32 count)
+{
+	UINT32 i, start;
+	NWL_STRBUF sb;
+	NWL_StrBufInit(&sb, NWLC->NwBuf, NWINFO_BUFSZ);
+	qsort(ids, count, sizeof(UINT32), CompareU32);
+	for (i = 0; i < count; i = start)
+	{
+		start = i + 1;
+		while (start < count && ids[start] == ids[start - 1] + 1)
+			start++;
+		if (start - 1 > i)
+			NWL_StrBufAppendf(&sb, "%s%u-%u", sb.Len ? "," : "", ids[i], ids[start - 1]);
+		else
+			NWL_StrBufAppendf(&sb, "%s%u", sb.Len ? "," : "", ids[i]);
+	}
+	return sb.Buf;
+}
+
+// Summarize usable processors, the APIC IDs are printed as ranges.
+static void
+PrintMADTTopology(PNODE pNode, UINT32* ids, UINT32 count, UINT32 total, UINT32 enabled, UINT32 online)
+{
+	UINT32 bits = 0;
+	LPCSTR ranges;
+	PNODE topo = NWL_NodeAppendNew(pNode, "Processor Topology", NFLG_ATTGROUP);
+	NWL_NodeAttrSetf(topo, "Processors", NAFLG_FMT_NUMERIC, "%u", total);
+	NWL_NodeAttrSetf(topo, "Enabled Processors", NAFLG_FMT_NUMERIC, "%u", enabled);
+	NWL_NodeAttrSetf(topo, "Online Capable Processors", NAFLG_FMT_NUMERIC, "%u", online);
+	if (count == 0)
+		return;
+	ranges = FormatIdRanges(ids, count);
+	while (bits < 32 && (ids[count - 1] >> bits))
+		bits++;
+	NWL_NodeAttrSetf(topo, "Max APIC ID", NAFLG_FMT_NUMERIC, "%u", ids[count - 1]);
+	NWL_NodeAttrSetf(topo, "APIC ID Bits", NAFLG_FMT_NUMERIC, "%u", bits);
+	NWL_NodeAttrSetBool(topo, "Contiguous APIC IDs", ids[count - 1] - ids[0] + 1 == count, 0);
+	NWL_NodeAttrSet(topo, "APIC IDs", ranges, 0);
+}
+
 static void
 PrintMADT(PNODE pNode, struct acpi_table_header* Hdr)
 {
 	struct acpi_madt* madt = (struct acpi_madt*)Hdr;
+	PNODE entries;
+	UINT32 offset;
+	UINT32 count = 0, total = 0, enabled = 0, online = 0;
+	UINT32* ids;
 	if (Hdr->length < sizeof(struct acpi_madt))
 		return;
 	NWL_NodeAttrSetf(pNode, "Local APIC Address", 0, "%08Xh", madt->lapic_addr);
 	NWL_NodeAttrSetBool(pNode, "PC-AT-compatible", madt->flags & 0x01, 0);
-	// TODO: print interrupt controller structures
+	// one APIC ID per processor entry at most
+	ids = malloc((Hdr->length / sizeof(struct acpi_madt_lapic) + 1) * sizeof(UINT32));
+	if (!ids)
+		return;
+	entries = NWL_NodeAppendNew(pNode, "Interrupt Controllers", NFLG_TABLE);
+	for (offset = sizeof(struct acpi_madt);
+		offset + sizeof(struct acpi_madt_entry_header) <= Hdr->length;
+		offset += ((struct acpi_madt_entry_header*)((UINT8*)Hdr + offset))->len)
+	{
+		struct acpi_madt_entry_header* e = (struct acpi_madt_entry_header*)((UINT8*)Hdr + offset);
+		PNODE tab;
+		UINT32 flags = 0, id = 0, online_capable = ACPI_MADT_ONLINE_CAPABLE;
+		BOOL cpu = FALSE;
+		if (e->len < sizeof(struct acpi_madt_entry_header) || offset + e->len > Hdr->length)
+			break;
+		tab = NWL_NodeAppendNew(entries, MadtTypeToStr(e->type), NFLG_TABLE_ROW);
+		NWL_NodeAttrSetf(tab, "Type", NAFLG_FMT_NUMERIC, "%u", e->type);
+		switch (e->type)
+		{
+		case ACPI_MADT_LAPIC:
+		{
+			struct acpi_madt_lapic* p = (struct acpi_madt_lapic*)e;
+			if (e->len < sizeof(*p))
+				break;
+			NWL_NodeAttrSetf(tab, "Processor UID", NAFLG_FMT_NUMERIC, "%u", p->processor_id);
+			NWL_NodeAttrSetf(tab, "APIC ID", NAFLG_FMT_NUMERIC, "%u", p->apic_id);
+			PrintProcessorFlags(tab, p->flags, online_capable);
+			cpu = TRUE;
+			flags = p->flags;
+			id = p->apic_id;
+			break;
+		}
+		case ACPI_MADT_IOAPIC:
+		{
+			struct acpi_madt_ioapic* p = (struct acpi_madt_ioapic*)e;
+			if (e->len < sizeof(*p))
+				break;
+			NWL_NodeAttrSetf(tab, "I/O APIC ID", NAFLG_FMT_NUMERIC, "%u", p->id);
+			NWL_NodeAttrSetf(tab, "Address", 0, "%08Xh", p->addr);
+			NWL_NodeAttrSetf(tab, "GSI Base", NAFLG_FMT_NUMERIC, "%u", p->gsi_base);
+			break;
+		}
+		case ACPI_MADT_INT_OVERRIDE:
+		{
+			struct acpi_madt_int_override* p = (struct acpi_madt_int_override*)e;
+			if (e->len < sizeof(*p))
+				break;
+			NWL_NodeAttrSetf(tab, "Bus", NAFLG_FMT_NUMERIC, "%u", p->bus);
+			NWL_NodeAttrSetf(tab, "Source IRQ", NAFLG_FMT_NUMERIC, "%u", p->source);
+			NWL_NodeAttrSetf(tab, "GSI", NAFLG_FMT_NUMERIC, "%u", p->gsi);
+			PrintMpsIntiFlags(tab, p->flags);
+			break;
+		}
+		case ACPI_MADT_NMI_SOURCE:
+		{
+			struct acpi_madt_nmi_source* p = (struct acpi_madt_nmi_source*)e;
+			if (e->len < sizeof(*p))
+				break;
+			NWL_NodeAttrSetf(tab, "GSI", NAFLG_FMT_NUMERIC, "%u", p->gsi);
+			PrintMpsIntiFlags(tab, p->flags);
+			break;
+		}
+		case ACPI_MADT_LAPIC_NMI:
+		{
+			struct acpi_madt_lapic_nmi* p = (struct acpi_madt_lapic_nmi*)e;
+			if (e->len < sizeof(*p))
+				break;
+			if (p->processor_id == 0xFF)
+				NWL_NodeAttrSet(tab, "Processor UID", "All", 0);
+			else
+				NWL_NodeAttrSetf(tab, "Processor UID", NAFLG_FMT_NUMERIC, "%u", p->processor_id);
+			NWL_NodeAttrSetf(tab, "LINT#", NAFLG_FMT_NUMERIC, "%u", p->lint);
+			PrintMpsIntiFlags(tab, p->flags);
+			break;
+		}
+		case ACPI_MADT_LAPIC_OVERRIDE:
+		{
+			struct acpi_madt_lapic_override* p = (struct acpi_madt_lapic_override*)e;
+			if (e->len < sizeof(*p))
+				break;
+			NWL_NodeAttrSetf(tab, "Local APIC Address", 0, "%016llXh", p->addr);
+			break;
+		}
+		case ACPI_MADT_X2APIC:
+		{
+			struct acpi_madt_x2apic* p = (struct acpi_madt_x2apic*)e;
+			if (e->len < sizeof(*p))
+				break;
+			NWL_NodeAttrSetf(tab, "Processor UID", NAFLG_FMT_NUMERIC, "%u", p->uid);
+			NWL_NodeAttrSetf(tab, "x2APIC ID", NAFLG_FMT_NUMERIC, "%u", p->x2apic_id);
+			PrintProcessorFlags(tab, p->flags, online_capable);
+			cpu = TRUE;
+			flags = p->flags;
+			id = p->x2apic_id;
+			break;
+		}
+		case ACPI_MADT_X2APIC_NMI:
+		{
+			struct acpi_madt_x2apic_nmi* p = (struct acpi_madt_x2apic_nmi*)e;
+			if (e->len < sizeof(*p))
+				break;
+			if (p->uid == 0xFFFFFFFF)
+				NWL_NodeAttrSet(tab, "Processor UID", "All", 0);
+			else
+				NWL_NodeAttrSetf(tab, "Processor UID", NAFLG_FMT_NUMERIC, "%u", p->uid);
+			NWL_NodeAttrSetf(tab, "LINT#", NAFLG_FMT_NUMERIC, "%u", p->lint);
+			PrintMpsIntiFlags(tab, p->flags);
+			break;
+		}
+		case ACPI_MADT_GICC:
+		{
+			struct acpi_madt_gicc* p = (struct acpi_madt_gicc*)e;
+			// 76 bytes before ACPI 6.0
+			if (e->len < offsetof(struct acpi_madt_gicc, efficiency_class))
+				break;
+			// GICC flags: online capable is bit 3
+			online_capable = (1U << 3);
+			NWL_NodeAttrSetf(tab, "Processor UID", NAFLG_FMT_NUMERIC, "%u", p->uid);
+			NWL_NodeAttrSetf(tab, "CPU Interface Number", NAFLG_FMT_NUMERIC, "%u", p->cpu_interface_number);
+			NWL_NodeAttrSetf(tab, "MPIDR", 0, "0x%llX", p->mpidr);
+			NWL_NodeAttrSetf(tab, "Base Address", 0, "%016llXh", p->base_addr);
+			if (e->len >= offsetof(struct acpi_madt_gicc, reserved2))
+				NWL_NodeAttrSetf(tab, "Efficiency Class", NAFLG_FMT_NUMERIC, "%u", p->efficiency_class);
+			PrintProcessorFlags(tab, p->flags, online_capable);
+			cpu = TRUE;
+			flags = p->flags;
+			// Aff3:Aff2:Aff1:Aff0 packed into 32 bits
+			id = (UINT32)(((p->mpidr >> 8) & 0xFF000000ULL) | (p->mpidr & 0x00FFFFFFULL));
+			break;
+		}
+		case ACPI_MADT_GICD:
+		{
+			struct acpi_madt_gicd* p = (struct acpi_madt_gicd*)e;
+			if (e->len < sizeof(*p))
+				break;
+			NWL_NodeAttrSetf(tab, "GIC ID", NAFLG_FMT_NUMERIC, "%u", p->gic_id);
+			NWL_NodeAttrSetf(tab, "Base Address", 0, "%016llXh", p->base_addr);
+			NWL_NodeAttrSetf(tab, "GIC Version", NAFLG_FMT_NUMERIC, "%u", p->version);
+			break;
+		}
+		case ACPI_MADT_GIC_MSI:
+		{
+			struct acpi_madt_gic_msi* p = (struct acpi_madt_gic_msi*)e;
+			if (e->len < sizeof(*p))
+				break;
+			NWL_NodeAttrSetf(tab, "MSI Frame ID", NAFLG_FMT_NUMERIC, "%u", p->frame_id);
+			NWL_NodeAttrSetf(tab, "Base Address", 0, "%016llXh", p->base_addr);
+			NWL_NodeAttrSetf(tab, "SPI Count", NAFLG_FMT_NUMERIC, "%u", p->spi_count);
+			NWL_NodeAttrSetf(tab, "SPI Base", NAFLG_FMT_NUMERIC, "%u", p->spi_base);
+			break;
+		}
+		case ACPI_MADT_GICR:
+		{
+			struct acpi_madt_gicr* p = (struct acpi_madt_gicr*)e;
+			if (e->len < sizeof(*p))
+				break;
+			NWL_NodeAttrSetf(tab, "Base Address", 0, "%016llXh", p->base_addr);
+			NWL_NodeAttrSetf(tab, "Discovery Range Length", 0, "0x%X", p->length);
+			break;
+		}
+		case ACPI_MADT_GIC_ITS:
+		{
+			struct acpi_madt_gic_its* p = (struct acpi_madt_gic_its*)e;
+			if (e->len < sizeof(*p))
+				break;
+			NWL_NodeAttrSetf(tab, "ITS ID", NAFLG_FMT_NUMERIC, "%u", p->its_id);
+			NWL_NodeAttrSetf(tab, "Base Address", 0, "%016llXh", p->base_addr);
+			break;
+		}
+		}
+		if (!cpu)
+			continue;
+		total++;
+		if (flags & ACPI_MADT_ENABLED)
+			enabled++;
+		else if (flags & online_capable)
+			online++;
+		else
+			continue;
+		ids[count++] = id;
+	}
+	PrintMADTTopology(pNode, ids, count, total, enabled, online);
+	free(ids);
 }
 
 static void
@@ -105,14 +395,1219 @@ PrintFADT(PNODE pNode, struct acpi_table_header* Hdr)
 		NWL_NodeAttrSetf(pNode, "PM Timer", 0, "0x%08X", fadt->pm_tmr_blk);
 }
 
+static void
+PrintMCFG(PNODE pNode, struct acpi_table_header* Hdr)
+{
+	struct acpi_mcfg* mcfg = (struct acpi_mcfg*)Hdr;
+	PNODE windows;
+	UINT32 i, count;
+	if (Hdr->length < sizeof(struct acpi_mcfg))
+		return;
+	count = (Hdr->length - sizeof(struct acpi_mcfg)) / sizeof(struct acpi_mcfg_alloc);
+	windows = NWL_NodeAppendNew(pNode, "ECAM Windows", NFLG_TABLE);
+	for (i = 0; i < count; i++)
+	{
+		struct acpi_mcfg_alloc* p = &mcfg->entry[i];
+		PNODE tab = NWL_NodeAppendNew(windows, "Window", NFLG_TABLE_ROW);
+		NWL_NodeAttrSetf(tab, "Base Address", 0, "%016llXh", p->base_addr);
+		NWL_NodeAttrSetf(tab, "Segment", NAFLG_FMT_NUMERIC, "%u", p->segment);
+		NWL_NodeAttrSetf(tab, "Start Bus", NAFLG_FMT_NUMERIC, "%u", p->start_bus);
+		NWL_NodeAttrSetf(tab, "End Bus", NAFLG_FMT_NUMERIC, "%u", p->end_bus);
+		// Each bus decodes 32 devices * 8 functions * 4 KB
+		NWL_NodeAttrSet(tab, "Size", NWL_GetHumanSize(((UINT64)p->end_bus - p->start_bus + 1) << 20,
+			d_human_sizes, 1024), NAFLG_FMT_HUMAN_SIZE);
+	}
+}
+
+static void
+PrintNsAttr(PNODE pNode, LPCSTR Key, UINT64 Ns)
+{
+	NWL_NodeAttrSetf(pNode, Key, NAFLG_FMT_NUMERIC, "%llu.%03llu", Ns / 1000000, (Ns / 1000) % 1000);
+}
+
+// FBPT and S3PT live in firmware reserved memory, read them through the driver.
+// NWL_ReadMemory takes a DWORD_PTR, x86 builds cannot reach a table above 4 GB.
+static struct acpi_fpdt_perf_table*
+ReadFpdtPerfTable(PNODE pNode, UINT64 Addr, LPCSTR Signature)
+{
+	struct acpi_fpdt_perf_table hdr;
+	struct acpi_fpdt_perf_table* ret;
+	CHAR key[] = "XXXX Status";
+	if (Addr == 0)
+		return NULL;
+	memcpy(key, Signature, 4);
+	if (Addr + sizeof(hdr) - 1 > (UINT64)MAXULONG_PTR)
+	{
+		NWL_NodeAttrSet(pNode, key, "Not addressable", 0);
+		return NULL;
+	}
+	if (!NWL_ReadMemory(&hdr, (DWORD_PTR)Addr, sizeof(hdr)))
+		return NULL;
+	if (memcmp(hdr.signature, Signature, 4) != 0
+		|| hdr.length < sizeof(hdr) || hdr.length > 0x10000)
+		return NULL;
+	if (Addr + hdr.length - 1 > (UINT64)MAXULONG_PTR)
+	{
+		NWL_NodeAttrSet(pNode, key, "Not addressable", 0);
+		return NULL;
+	}
+	ret = malloc(hdr.length);
+	if (!ret)
+		return NULL;
+	if (!NWL_ReadMemory(ret, (DWORD_PTR)Addr, hdr.length))
+	{
+		free(ret);
+		return NULL;
+	}
+	return ret;
+}
+
+static void
+PrintFBPT(PNODE pNode, UINT64 Addr)
+{
+	UINT32 offset;
+	struct acpi_fpdt_perf_table* fbpt = ReadFpdtPerfTable(pNode, Addr, "FBPT");
+	if (!fbpt)
+		return;
+	for (offset = sizeof(struct acpi_fpdt_perf_table); offset + sizeof(struct acpi_fpdt_record_header) <= fbpt->length;)
+	{
+		struct acpi_fpdt_boot_performance* p = (struct acpi_fpdt_boot_performance*)((UINT8*)fbpt + offset);
+		PNODE boot;
+		if (p->header.length < sizeof(struct acpi_fpdt_record_header) || offset + p->header.length > fbpt->length)
+			break;
+		offset += p->header.length;
+		if (p->header.type != ACPI_FPDT_BOOT_PERFORMANCE || p->header.length < sizeof(struct acpi_fpdt_boot_performance))
+			continue;
+		boot = NWL_NodeAppendNew(pNode, "Boot Performance", NFLG_ATTGROUP);
+		PrintNsAttr(boot, "Reset End (ms)", p->reset_end);
+		PrintNsAttr(boot, "OS Loader Load Image Start (ms)", p->os_loader_load_image_start);
+		PrintNsAttr(boot, "OS Loader Start Image Start (ms)", p->os_loader_start_image_start);
+		PrintNsAttr(boot, "ExitBootServices Entry (ms)", p->exit_boot_services_entry);
+		PrintNsAttr(boot, "ExitBootServices Exit (ms)", p->exit_boot_services_exit);
+		// A zero timestamp means the phase was not recorded
+		if (p->reset_end && p->os_loader_load_image_start > p->reset_end)
+			PrintNsAttr(boot, "Firmware Init (ms)", p->os_loader_load_image_start - p->reset_end);
+		if (p->os_loader_load_image_start && p->os_loader_start_image_start > p->os_loader_load_image_start)
+			PrintNsAttr(boot, "OS Loader Load (ms)", p->os_loader_start_image_start - p->os_loader_load_image_start);
+		if (p->os_loader_start_image_start && p->exit_boot_services_entry > p->os_loader_start_image_start)
+			PrintNsAttr(boot, "OS Loader Run (ms)", p->exit_boot_services_entry - p->os_loader_start_image_start);
+		if (p->exit_boot_services_entry && p->exit_boot_services_exit > p->exit_boot_services_entry)
+			PrintNsAttr(boot, "ExitBootServices (ms)", p->exit_boot_services_exit - p->exit_boot_services_entry);
+		if (p->exit_boot_services_exit > p->reset_end)
+			PrintNsAttr(boot, "Firmware Boot Total (ms)", p->exit_boot_services_exit - p->reset_end);
+	}
+	free(fbpt);
+}
+
+static void
+PrintS3PT(PNODE pNode, UINT64 Addr)
+{
+	UINT32 offset;
+	PNODE s3 = NULL;
+	struct acpi_fpdt_perf_table* s3pt = ReadFpdtPerfTable(pNode, Addr, "S3PT");
+	if (!s3pt)
+		return;
+	for (offset = sizeof(struct acpi_fpdt_perf_table); offset + sizeof(struct acpi_fpdt_record_header) <= s3pt->length;)
+	{
+		struct acpi_fpdt_record_header* h = (struct acpi_fpdt_record_header*)((UINT8*)s3pt + offset);
+		if (h->length < sizeof(struct acpi_fpdt_record_header) || offset + h->length > s3pt->length)
+			break;
+		offset += h->length;
+		if (!s3)
+			s3 = NWL_NodeAppendNew(pNode, "S3 Performance", NFLG_ATTGROUP);
+		if (h->type == ACPI_FPDT_S3_RESUME && h->length >= sizeof(struct acpi_fpdt_s3_resume))
+		{
+			struct acpi_fpdt_s3_resume* p = (struct acpi_fpdt_s3_resume*)h;
+			NWL_NodeAttrSetf(s3, "Resume Count", NAFLG_FMT_NUMERIC, "%u", p->resume_count);
+			PrintNsAttr(s3, "Full Resume (ms)", p->full_resume);
+			PrintNsAttr(s3, "Average Resume (ms)", p->average_resume);
+		}
+		else if (h->type == ACPI_FPDT_S3_SUSPEND && h->length >= sizeof(struct acpi_fpdt_s3_suspend))
+		{
+			struct acpi_fpdt_s3_suspend* p = (struct acpi_fpdt_s3_suspend*)h;
+			PrintNsAttr(s3, "Suspend Start (ms)", p->suspend_start);
+			PrintNsAttr(s3, "Suspend End (ms)", p->suspend_end);
+			if (p->suspend_end > p->suspend_start)
+				PrintNsAttr(s3, "Suspend (ms)", p->suspend_end - p->suspend_start);
+		}
+	}
+	free(s3pt);
+}
+
+static void
+PrintFPDT(PNODE pNode, struct acpi_table_header* Hdr)
+{
+	UINT32 offset;
+	for (offset = sizeof(struct acpi_fpdt); offset + sizeof(struct acpi_fpdt_record_header) <= Hdr->length;)
+	{
+		struct acpi_fpdt_pointer* p = (struct acpi_fpdt_pointer*)((UINT8*)Hdr + offset);
+		if (p->header.length < sizeof(struct acpi_fpdt_record_header) || offset + p->header.length > Hdr->length)
+			break;
+		offset += p->header.length;
+		if (p->header.length < sizeof(struct acpi_fpdt_pointer))
+			continue;
+		if (p->header.type == ACPI_FPDT_FBPT_POINTER)
+		{
+			NWL_NodeAttrSetf(pNode, "FBPT Address", 0, "0x%016llx", p->addr);
+			PrintFBPT(pNode, p->addr);
+		}
+		else if (p->header.type == ACPI_FPDT_S3PT_POINTER)
+		{
+			NWL_NodeAttrSetf(pNode, "S3PT Address", 0, "0x%016llx", p->addr);
+			PrintS3PT(pNode, p->addr);
+		}
+	}
+}
+
+static struct acpi_pptt_processor*
+PpttProcessor(struct acpi_table_header* Hdr, UINT32 Offset)
+{
+	struct acpi_pptt_processor* p = (struct acpi_pptt_processor*)((UINT8*)Hdr + Offset);
+	if (Offset < sizeof(struct acpi_pptt) || Offset > Hdr->length - sizeof(struct acpi_pptt_processor))
+		return NULL;
+	if (p->header.type != ACPI_PPTT_PROCESSOR || p->header.len < sizeof(struct acpi_pptt_processor)
+		|| p->header.len > Hdr->length - Offset
+		|| p->private_resource_count > (p->header.len - sizeof(struct acpi_pptt_processor)) / sizeof(UINT32))
+		return NULL;
+	return p;
+}
+
+static struct acpi_pptt_cache*
+PpttCache(struct acpi_table_header* Hdr, UINT32 Offset)
+{
+	struct acpi_pptt_cache* p = (struct acpi_pptt_cache*)((UINT8*)Hdr + Offset);
+	if (Offset < sizeof(struct acpi_pptt) || Offset > Hdr->length - offsetof(struct acpi_pptt_cache, cache_id))
+		return NULL;
+	if (p->header.type != ACPI_PPTT_CACHE || p->header.len < offsetof(struct acpi_pptt_cache, cache_id)
+		|| p->header.len > Hdr->length - Offset)
+		return NULL;
+	return p;
+}
+
+static const CHAR*
+PpttCacheTypeToStr(struct acpi_pptt_cache* p)
+{
+	if (!(p->flags & ACPI_PPTT_TYPE_VALID))
+		return "Unified";
+	switch ((p->attributes >> 2) & 0x03)
+	{
+	case 0: return "Data";
+	case 1: return "Instruction";
+	}
+	return "Unified";
+}
+
+static const CHAR*
+PpttAllocTypeToStr(UINT8 attributes)
+{
+	switch (attributes & 0x03)
+	{
+	case 0: return "Read";
+	case 1: return "Write";
+	}
+	return "Read/Write";
+}
+
+struct pptt_cache_info
+{
+	UINT32 offset;
+	UINT32 level;
+	UINT32 last_leaf;
+	UINT32 cpu_count;
+	UINT32* cpus;
+};
+
+struct pptt_info
+{
+	struct acpi_table_header* hdr;
+	UINT32 leaf_count;
+	UINT32 cache_count;
+	struct pptt_cache_info* caches;
+};
+
+static struct pptt_cache_info*
+PpttFindCache(struct pptt_info* info, UINT32 Offset)
+{
+	UINT32 i;
+	for (i = 0; i < info->cache_count; i++)
+	{
+		if (info->caches[i].offset == Offset)
+			return &info->caches[i];
+	}
+	return NULL;
+}
+
+static BOOL
+PpttIsLeaf(struct acpi_table_header* Hdr, UINT32 Offset)
+{
+	UINT32 i;
+	struct acpi_pptt_processor* p = PpttProcessor(Hdr, Offset);
+	if (!p)
+		return FALSE;
+	if (Hdr->revision >= 2)
+		return (p->flags & ACPI_PPTT_LEAF) ? TRUE : FALSE;
+	// The leaf flag was added in revision 2, look for children instead
+	for (i = sizeof(struct acpi_pptt); i + sizeof(struct acpi_pptt_entry_header) <= Hdr->length;)
+	{
+		struct acpi_pptt_processor* c = (struct acpi_pptt_processor*)((UINT8*)Hdr + i);
+		if (c->header.len < sizeof(struct acpi_pptt_entry_header) || c->header.len > Hdr->length - i)
+			break;
+		if (PpttProcessor(Hdr, i) && c->parent == Offset)
+			return FALSE;
+		i += c->header.len;
+	}
+	return TRUE;
+}
+
+static UINT32
+PpttProcessorId(struct acpi_pptt_processor* p, UINT32 Offset)
+{
+	return (p->flags & ACPI_PPTT_ACPI_ID_VALID) ? p->acpi_processor_id : Offset;
+}
+
+// Walk from a leaf towards the root, caches private to a level
+// are numbered after the deepest cache found below it.
+static void
+PpttWalkLeaf(struct pptt_info* info, UINT32 Leaf)
+{
+	struct acpi_pptt_processor* leaf = PpttProcessor(info->hdr, Leaf);
+	UINT32 offset = Leaf, base = 0, depth;
+	UINT32 id = PpttProcessorId(leaf, Leaf);
+	for (depth = 0; depth < 16 && offset; depth++)
+	{
+		UINT32 i, max = base;
+		struct acpi_pptt_processor* p = PpttProcessor(info->hdr, offset);
+		if (!p)
+			break;
+		for (i = 0; i < p->private_resource_count; i++)
+		{
+			UINT32 c = p->private_resource[i];
+			UINT32 level = base + 1;
+			struct acpi_pptt_cache* cache;
+			while ((cache = PpttCache(info->hdr, c)) != NULL && level <= base + 8)
+			{
+				struct pptt_cache_info* ci = PpttFindCache(info, c);
+				if (ci && ci->last_leaf != Leaf)
+				{
+					ci->last_leaf = Leaf;
+					if (level > ci->level)
+						ci->level = level;
+					if (ci->cpus && ci->cpu_count < info->leaf_count)
+						ci->cpus[ci->cpu_count++] = id;
+				}
+				if (level > max)
+					max = level;
+				c = cache->next_level;
+				level++;
+			}
+		}
+		base = max;
+		offset = p->parent;
+	}
+}
+
+static void
+PrintPPTTNode(PNODE pNode, struct pptt_info* info, UINT32 Parent, UINT32 Depth)
+{
+	UINT32 offset;
+	PNODE list = NULL;
+	struct acpi_table_header* Hdr = info->hdr;
+	if (Depth >= 16)
+		return;
+	for (offset = sizeof(struct acpi_pptt); offset + sizeof(struct acpi_pptt_entry_header) <= Hdr->length;)
+	{
+		struct acpi_pptt_processor* p = (struct acpi_pptt_processor*)((UINT8*)Hdr + offset);
+		PNODE tab;
+		UINT32 i, cur = offset;
+		NWL_STRBUF sb;
+		if (p->header.len < sizeof(struct acpi_pptt_entry_header) || p->header.len > Hdr->length - offset)
+			break;
+		offset += p->header.len;
+		if (!PpttProcessor(Hdr, cur) || p->parent != Parent)
+			continue;
+		if (!list)
+			list = NWL_NodeAppendNew(pNode, Depth ? "Children" : "Topology", NFLG_TABLE);
+		tab = NWL_NodeAppendNew(list, "Node", NFLG_TABLE_ROW);
+		if (p->flags & ACPI_PPTT_PHYSICAL_PACKAGE)
+			NWL_NodeAttrSet(tab, "Type", "Package", 0);
+		else if (p->flags & ACPI_PPTT_THREAD)
+			NWL_NodeAttrSet(tab, "Type", "Thread", 0);
+		else if (PpttIsLeaf(Hdr, cur))
+			NWL_NodeAttrSet(tab, "Type", "Processor", 0);
+		else
+			NWL_NodeAttrSet(tab, "Type", "Group", 0);
+		if (p->flags & ACPI_PPTT_ACPI_ID_VALID)
+			NWL_NodeAttrSetf(tab, "ACPI Processor ID", NAFLG_FMT_NUMERIC, "%u", p->acpi_processor_id);
+		NWL_NodeAttrSetBool(tab, "Identical Implementation", p->flags & ACPI_PPTT_IDENTICAL, 0);
+		NWL_StrBufInit(&sb, NWLC->NwBuf, NWINFO_BUFSZ);
+		for (i = 0; i < p->private_resource_count; i++)
+		{
+			struct acpi_pptt_cache* cache = PpttCache(Hdr, p->private_resource[i]);
+			struct pptt_cache_info* ci = PpttFindCache(info, p->private_resource[i]);
+			if (!cache || !ci)
+				continue;
+			NWL_StrBufAppendf(&sb, "%sL%u %s %s", sb.Len ? ", " : "",
+				ci->level, PpttCacheTypeToStr(cache), NWL_GetHumanSize(cache->size, d_human_sizes, 1024));
+		}
+		if (sb.Len)
+			NWL_NodeAttrSet(tab, "Private Caches", sb.Buf, 0);
+		PrintPPTTNode(tab, info, cur, Depth + 1);
+	}
+}
+
+static void
+PrintPPTT(PNODE pNode, struct acpi_table_header* Hdr)
+{
+	struct pptt_info info = { .hdr = Hdr };
+	UINT32 offset, i, packages = 0;
+	PNODE sharing;
+	if (Hdr->length < sizeof(struct acpi_pptt))
+		return;
+	for (offset = sizeof(struct acpi_pptt); offset + sizeof(struct acpi_pptt_entry_header) <= Hdr->length;)
+	{
+		struct acpi_pptt_processor* p = (struct acpi_pptt_processor*)((UINT8*)Hdr + offset);
+		if (p->header.len < sizeof(struct acpi_pptt_entry_header) || p->header.len > Hdr->length - offset)
+			break;
+		if (PpttProcessor(Hdr, offset))
+		{
+			if (p->flags & ACPI_PPTT_PHYSICAL_PACKAGE)
+				packages++;
+			if (PpttIsLeaf(Hdr, offset))
+				info.leaf_count++;
+		}
+		else if (PpttCache(Hdr, offset))
+			info.cache_count++;
+		offset += p->header.len;
+	}
+	NWL_NodeAttrSetf(pNode, "Packages", NAFLG_FMT_NUMERIC, "%u", packages);
+	NWL_NodeAttrSetf(pNode, "Processors", NAFLG_FMT_NUMERIC, "%u", info.leaf_count);
+	NWL_NodeAttrSetf(pNode, "Caches", NAFLG_FMT_NUMERIC, "%u", info.cache_count);
+	if (info.cache_count)
+	{
+		info.caches = calloc(info.cache_count, sizeof(struct pptt_cache_info));
+		if (!info.caches)
+			return;
+	}
+
+	info.cache_count = 0;
+	for (offset = sizeof(struct acpi_pptt); offset + sizeof(struct acpi_pptt_entry_header) <= Hdr->length;)
+	{
+		struct acpi_pptt_entry_header* h = (struct acpi_pptt_entry_header*)((UINT8*)Hdr + offset);
+		if (h->len < sizeof(struct acpi_pptt_entry_header) || h->len > Hdr->length - offset)
+			break;
+		if (PpttCache(Hdr, offset))
+		{
+			info.caches[info.cache_count].offset = offset;
+			info.caches[info.cache_count].cpus = calloc(info.leaf_count ? info.leaf_count : 1, sizeof(UINT32));
+			info.cache_count++;
+		}
+		offset += h->len;
+	}
+	for (offset = sizeof(struct acpi_pptt); offset + sizeof(struct acpi_pptt_entry_header) <= Hdr->length;)
+	{
+		struct acpi_pptt_entry_header* h = (struct acpi_pptt_entry_header*)((UINT8*)Hdr + offset);
+		if (h->len < sizeof(struct acpi_pptt_entry_header) || h->len > Hdr->length - offset)
+			break;
+		if (PpttIsLeaf(Hdr, offset))
+			PpttWalkLeaf(&info, offset);
+		offset += h->len;
+	}
+
+	PrintPPTTNode(pNode, &info, 0, 0);
+
+	sharing = NWL_NodeAppendNew(pNode, "Cache Sharing", NFLG_TABLE);
+	for (i = 0; i < info.cache_count; i++)
+	{
+		struct pptt_cache_info* ci = &info.caches[i];
+		struct acpi_pptt_cache* p = PpttCache(Hdr, ci->offset);
+		PNODE tab = NWL_NodeAppendNew(sharing, "Cache", NFLG_TABLE_ROW);
+		if (ci->level)
+			NWL_NodeAttrSetf(tab, "Level", NAFLG_FMT_NUMERIC, "%u", ci->level);
+		NWL_NodeAttrSet(tab, "Type", PpttCacheTypeToStr(p), 0);
+		if (p->flags & ACPI_PPTT_SIZE_VALID)
+			NWL_NodeAttrSet(tab, "Size", NWL_GetHumanSize(p->size, d_human_sizes, 1024), NAFLG_FMT_HUMAN_SIZE);
+		if (p->flags & ACPI_PPTT_SETS_VALID)
+			NWL_NodeAttrSetf(tab, "Sets", NAFLG_FMT_NUMERIC, "%u", p->sets);
+		if (p->flags & ACPI_PPTT_ASSOC_VALID)
+			NWL_NodeAttrSetf(tab, "Associativity", NAFLG_FMT_NUMERIC, "%u", p->associativity);
+		if (p->flags & ACPI_PPTT_LINE_VALID)
+			NWL_NodeAttrSetf(tab, "Line Size", NAFLG_FMT_NUMERIC, "%u", p->line_size);
+		if (p->flags & ACPI_PPTT_ALLOC_VALID)
+			NWL_NodeAttrSet(tab, "Allocation", PpttAllocTypeToStr(p->attributes), 0);
+		if (p->flags & ACPI_PPTT_POLICY_VALID)
+			NWL_NodeAttrSet(tab, "Write Policy", (p->attributes & 0x10) ? "Write-Through" : "Write-Back", 0);
+		if (Hdr->revision >= 3 && p->header.len >= sizeof(struct acpi_pptt_cache)
+			&& (p->flags & ACPI_PPTT_CACHE_ID_VALID))
+			NWL_NodeAttrSetf(tab, "Cache ID", NAFLG_FMT_NUMERIC, "%u", p->cache_id);
+		NWL_NodeAttrSetf(tab, "Shared By", NAFLG_FMT_NUMERIC, "%u", ci->cpu_count);
+		if (ci->cpu_count)
+			NWL_NodeAttrSet(tab, "Processor IDs", FormatIdRanges(ci->cpus, ci->cpu_count), 0);
+		free(ci->cpus);
+	}
+	free(info.caches);
+}
+
+static UINT32
+SratLapicDomain(struct acpi_srat_lapic* p)
+{
+	return p->proximity_domain_lo | ((UINT32)p->proximity_domain_hi[0] << 8)
+		| ((UINT32)p->proximity_domain_hi[1] << 16) | ((UINT32)p->proximity_domain_hi[2] << 24);
+}
+
+static const CHAR*
+SratTypeToStr(UINT8 type)
+{
+	switch (type)
+	{
+	case ACPI_SRAT_LAPIC: return "Processor Local APIC Affinity";
+	case ACPI_SRAT_MEMORY: return "Memory Affinity";
+	case ACPI_SRAT_X2APIC: return "Processor Local x2APIC Affinity";
+	case ACPI_SRAT_GICC: return "GICC Affinity";
+	case ACPI_SRAT_GIC_ITS: return "GIC ITS Affinity";
+	case ACPI_SRAT_GENERIC_INITIATOR: return "Generic Initiator Affinity";
+	}
+	return "Reserved";
+}
+
+static void
+PrintSRAT(PNODE pNode, struct acpi_table_header* Hdr)
+{
+	struct acpi_srat* srat = (struct acpi_srat*)Hdr;
+	PNODE entries;
+	UINT32 offset;
+	if (Hdr->length < sizeof(struct acpi_srat))
+		return;
+	NWL_NodeAttrSetf(pNode, "Table Revision", NAFLG_FMT_NUMERIC, "%u", srat->table_revision);
+	entries = NWL_NodeAppendNew(pNode, "Affinity", NFLG_TABLE);
+	for (offset = sizeof(struct acpi_srat); offset + sizeof(struct acpi_srat_entry_header) <= Hdr->length;)
+	{
+		struct acpi_srat_entry_header* h = (struct acpi_srat_entry_header*)((UINT8*)Hdr + offset);
+		PNODE tab;
+		if (h->len < sizeof(struct acpi_srat_entry_header) || offset + h->len > Hdr->length)
+			break;
+		offset += h->len;
+		tab = NWL_NodeAppendNew(entries, "Entry", NFLG_TABLE_ROW);
+		NWL_NodeAttrSet(tab, "Type", SratTypeToStr(h->type), 0);
+		switch (h->type)
+		{
+		case ACPI_SRAT_LAPIC:
+		{
+			struct acpi_srat_lapic* p = (struct acpi_srat_lapic*)h;
+			if (h->len < sizeof(struct acpi_srat_lapic))
+				break;
+			NWL_NodeAttrSetf(tab, "Proximity Domain", NAFLG_FMT_NUMERIC, "%u", SratLapicDomain(p));
+			NWL_NodeAttrSetf(tab, "APIC ID", NAFLG_FMT_NUMERIC, "%u", p->apic_id);
+			NWL_NodeAttrSetBool(tab, "Enabled", p->flags & ACPI_SRAT_ENABLED, 0);
+			NWL_NodeAttrSetf(tab, "Clock Domain", NAFLG_FMT_NUMERIC, "%u", p->clock_domain);
+			break;
+		}
+		case ACPI_SRAT_MEMORY:
+		{
+			struct acpi_srat_memory* p = (struct acpi_srat_memory*)h;
+			if (h->len < sizeof(struct acpi_srat_memory))
+				break;
+			NWL_NodeAttrSetf(tab, "Proximity Domain", NAFLG_FMT_NUMERIC, "%u", p->proximity_domain);
+			NWL_NodeAttrSetf(tab, "Base Address", 0, "%016llXh", p->base_addr);
+			NWL_NodeAttrSet(tab, "Length",
+				NWL_GetHumanSize(p->length, d_human_sizes, 1024), NAFLG_FMT_HUMAN_SIZE);
+			NWL_NodeAttrSetBool(tab, "Enabled", p->flags & ACPI_SRAT_ENABLED, 0);
+			NWL_NodeAttrSetBool(tab, "Hot Pluggable", p->flags & ACPI_SRAT_HOT_PLUGGABLE, 0);
+			NWL_NodeAttrSetBool(tab, "Non-Volatile", p->flags & ACPI_SRAT_NON_VOLATILE, 0);
+			break;
+		}
+		case ACPI_SRAT_X2APIC:
+		{
+			struct acpi_srat_x2apic* p = (struct acpi_srat_x2apic*)h;
+			if (h->len < sizeof(struct acpi_srat_x2apic))
+				break;
+			NWL_NodeAttrSetf(tab, "Proximity Domain", NAFLG_FMT_NUMERIC, "%u", p->proximity_domain);
+			NWL_NodeAttrSetf(tab, "x2APIC ID", NAFLG_FMT_NUMERIC, "%u", p->x2apic_id);
+			NWL_NodeAttrSetBool(tab, "Enabled", p->flags & ACPI_SRAT_ENABLED, 0);
+			NWL_NodeAttrSetf(tab, "Clock Domain", NAFLG_FMT_NUMERIC, "%u", p->clock_domain);
+			break;
+		}
+		case ACPI_SRAT_GICC:
+		{
+			struct acpi_srat_gicc* p = (struct acpi_srat_gicc*)h;
+			if (h->len < sizeof(struct acpi_srat_gicc))
+				break;
+			NWL_NodeAttrSetf(tab, "Proximity Domain", NAFLG_FMT_NUMERIC, "%u", p->proximity_domain);
+			NWL_NodeAttrSetf(tab, "ACPI Processor UID", NAFLG_FMT_NUMERIC, "%u", p->uid);
+			NWL_NodeAttrSetBool(tab, "Enabled", p->flags & ACPI_SRAT_ENABLED, 0);
+			NWL_NodeAttrSetf(tab, "Clock Domain", NAFLG_FMT_NUMERIC, "%u", p->clock_domain);
+			break;
+		}
+		}
+	}
+}
+
+static LPCSTR
+FormatSlitRow(struct acpi_slit* slit, UINT64 row)
+{
+	UINT64 j;
+	NWL_STRBUF sb;
+	NWL_StrBufInit(&sb, NWLC->NwBuf, NWINFO_BUFSZ);
+	for (j = 0; j < slit->count; j++)
+		NWL_StrBufAppendf(&sb, "%s%u", sb.Len ? " " : "", slit->entry[row * slit->count + j]);
+	return sb.Buf;
+}
+
+static void
+PrintSLIT(PNODE pNode, struct acpi_table_header* Hdr)
+{
+	struct acpi_slit* slit = (struct acpi_slit*)Hdr;
+	PNODE matrix;
+	UINT64 i;
+	if (Hdr->length < sizeof(struct acpi_slit))
+		return;
+	NWL_NodeAttrSetf(pNode, "Localities", NAFLG_FMT_NUMERIC, "%llu", slit->count);
+	if (slit->count == 0 || slit->count > 0xFFFF
+		|| sizeof(struct acpi_slit) + slit->count * slit->count > Hdr->length)
+		return;
+	matrix = NWL_NodeAppendNew(pNode, "Distances", NFLG_TABLE);
+	for (i = 0; i < slit->count; i++)
+	{
+		PNODE row = NWL_NodeAppendNew(matrix, "Locality", NFLG_TABLE_ROW);
+		NWL_NodeAttrSetf(row, "Proximity Domain", NAFLG_FMT_NUMERIC, "%llu", i);
+		NWL_NodeAttrSet(row, "Distance", FormatSlitRow(slit, i), 0);
+	}
+}
+
+static const CHAR*
+HmatTypeToStr(UINT16 type)
+{
+	switch (type)
+	{
+	case ACPI_HMAT_PROXIMITY: return "Memory Proximity Domain Attributes";
+	case ACPI_HMAT_LOCALITY: return "System Locality Latency and Bandwidth";
+	case ACPI_HMAT_CACHE: return "Memory Side Cache Information";
+	}
+	return "Reserved";
+}
+
+static const CHAR*
+HmatDataTypeToStr(UINT8 type)
+{
+	switch (type)
+	{
+	case 0: return "Access Latency";
+	case 1: return "Read Latency";
+	case 2: return "Write Latency";
+	case 3: return "Access Bandwidth";
+	case 4: return "Read Bandwidth";
+	case 5: return "Write Bandwidth";
+	}
+	return "Reserved";
+}
+
+static const CHAR*
+HmatHierarchyToStr(UINT8 flags)
+{
+	switch (flags & 0x0F)
+	{
+	case 0: return "Memory";
+	case 1: return "Last Level Memory Side Cache";
+	case 2: return "1st Level Memory Side Cache";
+	case 3: return "2nd Level Memory Side Cache";
+	case 4: return "3rd Level Memory Side Cache";
+	}
+	return "Reserved";
+}
+
+static BOOL
+HmatLocalityFits(struct acpi_hmat_locality* p)
+{
+	UINT64 size = sizeof(struct acpi_hmat_locality);
+	if (p->header.length < size)
+		return FALSE;
+	size += ((UINT64)p->initiator_count + p->target_count) * sizeof(UINT32);
+	size += (UINT64)p->initiator_count * p->target_count * sizeof(UINT16);
+	return size <= p->header.length;
+}
+
+static void
+PrintHMAT(PNODE pNode, struct acpi_table_header* Hdr)
+{
+	PNODE entries;
+	UINT32 offset;
+	if (Hdr->length < sizeof(struct acpi_hmat))
+		return;
+	entries = NWL_NodeAppendNew(pNode, "Structures", NFLG_TABLE);
+	for (offset = sizeof(struct acpi_hmat); offset + sizeof(struct acpi_hmat_entry_header) <= Hdr->length;)
+	{
+		struct acpi_hmat_entry_header* h = (struct acpi_hmat_entry_header*)((UINT8*)Hdr + offset);
+		PNODE tab;
+		if (h->length < sizeof(struct acpi_hmat_entry_header) || h->length > Hdr->length - offset)
+			break;
+		offset += h->length;
+		tab = NWL_NodeAppendNew(entries, "Structure", NFLG_TABLE_ROW);
+		NWL_NodeAttrSet(tab, "Type", HmatTypeToStr(h->type), 0);
+		switch (h->type)
+		{
+		case ACPI_HMAT_PROXIMITY:
+		{
+			struct acpi_hmat_proximity* p = (struct acpi_hmat_proximity*)h;
+			if (h->length < offsetof(struct acpi_hmat_proximity, reserved2))
+				break;
+			if (p->flags & 0x01)
+				NWL_NodeAttrSetf(tab, "Initiator Proximity Domain", NAFLG_FMT_NUMERIC, "%u", p->initiator_pd);
+			NWL_NodeAttrSetf(tab, "Memory Proximity Domain", NAFLG_FMT_NUMERIC, "%u", p->memory_pd);
+			break;
+		}
+		case ACPI_HMAT_LOCALITY:
+		{
+			struct acpi_hmat_locality* p = (struct acpi_hmat_locality*)h;
+			if (!HmatLocalityFits(p))
+				break;
+			NWL_NodeAttrSet(tab, "Memory Hierarchy", HmatHierarchyToStr(p->flags), 0);
+			NWL_NodeAttrSet(tab, "Data Type", HmatDataTypeToStr(p->data_type), 0);
+			NWL_NodeAttrSetf(tab, "Initiators", NAFLG_FMT_NUMERIC, "%u", p->initiator_count);
+			NWL_NodeAttrSetf(tab, "Targets", NAFLG_FMT_NUMERIC, "%u", p->target_count);
+			NWL_NodeAttrSetf(tab, "Entry Base Unit", NAFLG_FMT_NUMERIC, "%llu", p->entry_base_unit);
+			break;
+		}
+		case ACPI_HMAT_CACHE:
+		{
+			struct acpi_hmat_cache* p = (struct acpi_hmat_cache*)h;
+			if (h->length < sizeof(struct acpi_hmat_cache))
+				break;
+			NWL_NodeAttrSetf(tab, "Memory Proximity Domain", NAFLG_FMT_NUMERIC, "%u", p->memory_pd);
+			NWL_NodeAttrSet(tab, "Cache Size",
+				NWL_GetHumanSize(p->cache_size, d_human_sizes, 1024), NAFLG_FMT_HUMAN_SIZE);
+			NWL_NodeAttrSetf(tab, "Cache Level", NAFLG_FMT_NUMERIC, "%u", (p->cache_attributes >> 4) & 0x0F);
+			NWL_NodeAttrSetf(tab, "Total Cache Levels", NAFLG_FMT_NUMERIC, "%u", p->cache_attributes & 0x0F);
+			NWL_NodeAttrSetf(tab, "Cache Line Size", NAFLG_FMT_NUMERIC, "%u", p->cache_attributes >> 16);
+			break;
+		}
+		}
+	}
+}
+
+// Look up a memory-level HMAT entry for the initiator/target pair.
+// Latencies are returned in picoseconds and bandwidths in MB/s.
+static BOOL
+HmatLookup(struct acpi_table_header* Hdr, UINT8 DataType, UINT32 Initiator, UINT32 Target, UINT64* Value)
+{
+	UINT32 offset;
+	for (offset = sizeof(struct acpi_hmat); offset + sizeof(struct acpi_hmat_entry_header) <= Hdr->length;)
+	{
+		struct acpi_hmat_locality* p = (struct acpi_hmat_locality*)((UINT8*)Hdr + offset);
+		UINT32* initiators;
+		UINT32* targets;
+		UINT16* entry;
+		UINT32 i, j;
+		if (p->header.length < sizeof(struct acpi_hmat_entry_header) || p->header.length > Hdr->length - offset)
+			break;
+		offset += p->header.length;
+		if (p->header.type != ACPI_HMAT_LOCALITY || (p->flags & 0x0F) != 0
+			|| p->data_type != DataType || !HmatLocalityFits(p))
+			continue;
+		initiators = (UINT32*)(p + 1);
+		targets = initiators + p->initiator_count;
+		entry = (UINT16*)(targets + p->target_count);
+		for (i = 0; i < p->initiator_count && initiators[i] != Initiator; i++)
+			;
+		for (j = 0; j < p->target_count && targets[j] != Target; j++)
+			;
+		if (i >= p->initiator_count || j >= p->target_count)
+			continue;
+		if (entry[i * p->target_count + j] == 0 || entry[i * p->target_count + j] == 0xFFFF)
+			return FALSE;
+		*Value = entry[i * p->target_count + j] * p->entry_base_unit;
+		return TRUE;
+	}
+	return FALSE;
+}
+
+struct numa_domain
+{
+	UINT32 pd;
+	UINT32 cpu_count;
+	UINT32* cpus;
+	UINT64 mem_size;
+};
+
+static struct numa_domain*
+NumaGetDomain(struct numa_domain** domains, UINT32* count, UINT32 pd)
+{
+	UINT32 i;
+	struct numa_domain* p;
+	for (i = 0; i < *count; i++)
+	{
+		if ((*domains)[i].pd == pd)
+			return &(*domains)[i];
+	}
+	p = realloc(*domains, (*count + 1) * sizeof(struct numa_domain));
+	if (!p)
+		return NULL;
+	*domains = p;
+	p = &p[(*count)++];
+	ZeroMemory(p, sizeof(struct numa_domain));
+	p->pd = pd;
+	return p;
+}
+
+static void
+NumaAddCpu(struct numa_domain* d, UINT32 id, UINT32 max)
+{
+	if (!d->cpus)
+		d->cpus = calloc(max, sizeof(UINT32));
+	if (d->cpus && d->cpu_count < max)
+		d->cpus[d->cpu_count++] = id;
+}
+
+static void
+PrintNUMAAccess(PNODE pNode, struct acpi_table_header* hmat,
+	struct numa_domain* domains, UINT32 count, UINT32 target)
+{
+	static const CHAR* names[6] =
+	{
+		"Access Latency (ns)", "Read Latency (ns)", "Write Latency (ns)",
+		"Access Bandwidth (MB/s)", "Read Bandwidth (MB/s)", "Write Bandwidth (MB/s)",
+	};
+	UINT32 i;
+	UINT8 t;
+	PNODE access = NULL;
+	for (i = 0; i < count; i++)
+	{
+		PNODE row = NULL;
+		for (t = 0; t < 6; t++)
+		{
+			UINT64 value;
+			if (!HmatLookup(hmat, t, domains[i].pd, target, &value))
+				continue;
+			if (!row)
+			{
+				if (!access)
+					access = NWL_NodeAppendNew(pNode, "Memory Access", NFLG_TABLE);
+				row = NWL_NodeAppendNew(access, "Initiator", NFLG_TABLE_ROW);
+				NWL_NodeAttrSetf(row, "Initiator Proximity Domain", NAFLG_FMT_NUMERIC, "%u", domains[i].pd);
+			}
+			if (t <= 2)
+				NWL_NodeAttrSetf(row, names[t], NAFLG_FMT_NUMERIC, "%llu.%llu", value / 1000, (value % 1000) / 100);
+			else
+				NWL_NodeAttrSetf(row, names[t], NAFLG_FMT_NUMERIC, "%llu", value);
+		}
+	}
+}
+
+// Correlate SRAT, SLIT and HMAT into a per proximity domain view.
+static void
+PrintNUMA(PNODE pNode)
+{
+	struct acpi_table_header* srat = NWL_GetAcpi('TARS');
+	struct acpi_slit* slit = NWL_GetAcpi('TILS');
+	struct acpi_table_header* hmat = NWL_GetAcpi('TAMH');
+	struct numa_domain* domains = NULL;
+	UINT32 i, count = 0, offset, max_cpus;
+	PNODE numa, list;
+
+	if (!srat || srat->length < sizeof(struct acpi_srat))
+		return;
+	if (slit && (slit->header.length < sizeof(struct acpi_slit) || slit->count > 0xFFFF
+		|| sizeof(struct acpi_slit) + slit->count * slit->count > slit->header.length))
+		slit = NULL;
+	if (hmat && hmat->length < sizeof(struct acpi_hmat))
+		hmat = NULL;
+	max_cpus = srat->length / sizeof(struct acpi_srat_lapic);
+
+	for (offset = sizeof(struct acpi_srat); offset + sizeof(struct acpi_srat_entry_header) <= srat->length;)
+	{
+		struct acpi_srat_entry_header* h = (struct acpi_srat_entry_header*)((UINT8*)srat + offset);
+		struct numa_domain* d = NULL;
+		if (h->len < sizeof(struct acpi_srat_entry_header) || offset + h->len > srat->length)
+			break;
+		offset += h->len;
+		if (h->type == ACPI_SRAT_LAPIC && h->len >= sizeof(struct acpi_srat_lapic))
+		{
+			struct acpi_srat_lapic* p = (struct acpi_srat_lapic*)h;
+			if ((p->flags & ACPI_SRAT_ENABLED) && (d = NumaGetDomain(&domains, &count, SratLapicDomain(p))))
+				NumaAddCpu(d, p->apic_id, max_cpus);
+		}
+		else if (h->type == ACPI_SRAT_X2APIC && h->len >= sizeof(struct acpi_srat_x2apic))
+		{
+			struct acpi_srat_x2apic* p = (struct acpi_srat_x2apic*)h;
+			if ((p->flags & ACPI_SRAT_ENABLED) && (d = NumaGetDomain(&domains, &count, p->proximity_domain)))
+				NumaAddCpu(d, p->x2apic_id, max_cpus);
+		}
+		else if (h->type == ACPI_SRAT_GICC && h->len >= sizeof(struct acpi_srat_gicc))
+		{
+			struct acpi_srat_gicc* p = (struct acpi_srat_gicc*)h;
+			if ((p->flags & ACPI_SRAT_ENABLED) && (d = NumaGetDomain(&domains, &count, p->proximity_domain)))
+				NumaAddCpu(d, p->uid, max_cpus);
+		}
+		else if (h->type == ACPI_SRAT_MEMORY && h->len >= sizeof(struct acpi_srat_memory))
+		{
+			struct acpi_srat_memory* p = (struct acpi_srat_memory*)h;
+			if ((p->flags & ACPI_SRAT_ENABLED) && (d = NumaGetDomain(&domains, &count, p->proximity_domain)))
+				d->mem_size += p->length;
+		}
+	}
+
+	numa = NWL_NodeAppendNew(pNode, "NUMA", NFLG_TABLE_ROW);
+	NWL_NodeAttrSetf(numa, "Proximity Domains", NAFLG_FMT_NUMERIC, "%u", count);
+	if (slit)
+		NWL_NodeAttrSetf(numa, "Localities", NAFLG_FMT_NUMERIC, "%llu", slit->count);
+	list = NWL_NodeAppendNew(numa, "Domains", NFLG_TABLE);
+	for (i = 0; i < count; i++)
+	{
+		struct numa_domain* d = &domains[i];
+		PNODE tab = NWL_NodeAppendNew(list, "Domain", NFLG_TABLE_ROW);
+		PNODE mem = NULL;
+		NWL_NodeAttrSetf(tab, "Proximity Domain", NAFLG_FMT_NUMERIC, "%u", d->pd);
+		NWL_NodeAttrSetf(tab, "Processors", NAFLG_FMT_NUMERIC, "%u", d->cpu_count);
+		if (d->cpu_count)
+			NWL_NodeAttrSet(tab, "APIC IDs", FormatIdRanges(d->cpus, d->cpu_count), 0);
+		NWL_NodeAttrSet(tab, "Memory Size",
+			NWL_GetHumanSize(d->mem_size, d_human_sizes, 1024), NAFLG_FMT_HUMAN_SIZE);
+		if (slit && d->pd < slit->count)
+			NWL_NodeAttrSet(tab, "Distances", FormatSlitRow(slit, d->pd), 0);
+		for (offset = sizeof(struct acpi_srat); offset + sizeof(struct acpi_srat_entry_header) <= srat->length;)
+		{
+			struct acpi_srat_memory* p = (struct acpi_srat_memory*)((UINT8*)srat + offset);
+			PNODE range;
+			if (p->header.len < sizeof(struct acpi_srat_entry_header) || offset + p->header.len > srat->length)
+				break;
+			offset += p->header.len;
+			if (p->header.type != ACPI_SRAT_MEMORY || p->header.len < sizeof(struct acpi_srat_memory)
+				|| !(p->flags & ACPI_SRAT_ENABLED) || p->proximity_domain != d->pd)
+				continue;
+			if (!mem)
+				mem = NWL_NodeAppendNew(tab, "Memory Ranges", NFLG_TABLE);
+			range = NWL_NodeAppendNew(mem, "Range", NFLG_TABLE_ROW);
+			NWL_NodeAttrSetf(range, "Base Address", 0, "%016llXh", p->base_addr);
+			NWL_NodeAttrSetf(range, "End Address", 0, "%016llXh", p->base_addr + p->length - 1);
+			NWL_NodeAttrSet(range, "Length",
+				NWL_GetHumanSize(p->length, d_human_sizes, 1024), NAFLG_FMT_HUMAN_SIZE);
+			NWL_NodeAttrSetBool(range, "Hot Pluggable", p->flags & ACPI_SRAT_HOT_PLUGGABLE, 0);
+			NWL_NodeAttrSetBool(range, "Non-Volatile", p->flags & ACPI_SRAT_NON_VOLATILE, 0);
+		}
+		if (hmat)
+			PrintNUMAAccess(tab, hmat, domains, count, d->pd);
+	}
+
+	for (i = 0; i < count; i++)
+		free(domains[i].cpus);
+	free(domains);
+}
+
+static LPCSTR
+AmlTypeToStr(UINT8 Type)
+{
+	switch (Type)
+	{
+	case AML_TYPE_DEVICE: return "Device";
+	case AML_TYPE_PROCESSOR: return "Processor";
+	case AML_TYPE_POWER_RESOURCE: return "Power Resource";
+	case AML_TYPE_THERMAL_ZONE: return "Thermal Zone";
+	}
+	return "Unknown";
+}
+
+static BOOL
+AmlChildObject(PAML_NAMESPACE Ns, UINT32 Node, LPCSTR Name, PAML_OBJ Obj)
+{
+	UINT32 child = NWL_AmlChild(Ns, Node, Name);
+	return child != AML_NONE && NWL_AmlGetObject(Ns, child, Obj);
+}
+
+static BOOL
+AmlChildInteger(PAML_NAMESPACE Ns, UINT32 Node, LPCSTR Name, UINT64* Value)
+{
+	AML_OBJ obj;
+	return AmlChildObject(Ns, Node, Name, &obj) && NWL_AmlObjInteger(&obj, Value);
+}
+
+static BOOL
+AmlElementInteger(CONST AML_OBJ* Pkg, UINT32 Index, UINT64* Value)
+{
+	AML_OBJ obj;
+	return NWL_AmlObjPackageElement(Pkg, Index, &obj) && NWL_AmlObjInteger(&obj, Value);
+}
+
+// Temperatures are in tenths of Kelvin
+static void
+PrintAmlTemp(PNODE pNode, PAML_NAMESPACE Ns, UINT32 Node, LPCSTR Name, LPCSTR Key)
+{
+	UINT64 v;
+	INT64 t;
+	if (!AmlChildInteger(Ns, Node, Name, &v) || v == 0 || v > 0xFFFF)
+		return;
+	t = (INT64)v - 2732;
+	NWL_NodeAttrSetf(pNode, Key, NAFLG_FMT_NUMERIC, "%s%lld.%lld",
+		t < 0 ? "-" : "", (t < 0 ? -t : t) / 10, (t < 0 ? -t : t) % 10);
+}
+
+static void
+PrintAmlIds(PNODE pNode, PAML_NAMESPACE Ns, UINT32 Node)
+{
+	AML_OBJ obj;
+	UINT64 v;
+	UINT32 i;
+	CHAR id[16];
+	if (AmlChildObject(Ns, Node, "_HID", &obj) && NWL_AmlObjId(&obj, id, sizeof(id)))
+		NWL_NodeAttrSet(pNode, "HID", id, 0);
+	if (AmlChildObject(Ns, Node, "_CID", &obj))
+	{
+		UINT32 count = NWL_AmlObjPackageCount(&obj);
+		if (count == 0 && NWL_AmlObjId(&obj, id, sizeof(id)))
+			NWL_NodeAttrSet(pNode, "CID", id, 0);
+		else if (count)
+		{
+			NWL_STRBUF sb;
+			NWL_StrBufInit(&sb, NWLC->NwBuf, NWINFO_BUFSZ);
+			for (i = 0; i < count; i++)
+			{
+				AML_OBJ elem;
+				if (!NWL_AmlObjPackageElement(&obj, i, &elem) || !NWL_AmlObjId(&elem, id, sizeof(id)))
+					continue;
+				NWL_StrBufAppendf(&sb, "%s%s", sb.Len ? "," : "", id);
+			}
+			if (sb.Len)
+				NWL_NodeAttrSet(pNode, "CID", sb.Buf, 0);
+		}
+	}
+	if (AmlChildObject(Ns, Node, "_UID", &obj))
+	{
+		if (NWL_AmlObjInteger(&obj, &v))
+			NWL_NodeAttrSetf(pNode, "UID", NAFLG_FMT_NUMERIC, "%llu", v);
+		else if (NWL_AmlObjId(&obj, id, sizeof(id)))
+			NWL_NodeAttrSet(pNode, "UID", id, 0);
+	}
+	if (AmlChildInteger(Ns, Node, "_ADR", &v))
+		NWL_NodeAttrSetf(pNode, "Address", 0, "0x%llX", v);
+}
+
+// _PR0-_PR3 list the power resources a device needs in D0-D3hot, _PS0-_PS3 set the state
+static void
+PrintAmlPowerStates(PNODE pNode, PAML_NAMESPACE Ns, UINT32 Node)
+{
+	CHAR name[5] = "_PS0";
+	CHAR key[] = "Power Resources D0";
+	CHAR d;
+	UINT32 i;
+	NWL_STRBUF sb;
+	NWL_StrBufInit(&sb, NWLC->NwBuf, NWINFO_BUFSZ);
+	for (d = '0'; d <= '3'; d++)
+	{
+		name[3] = d;
+		if (NWL_AmlChild(Ns, Node, name) != AML_NONE)
+			NWL_StrBufAppendf(&sb, "%sD%c", sb.Len ? "," : "", d);
+	}
+	if (sb.Len)
+		NWL_NodeAttrSet(pNode, "Power States", sb.Buf, 0);
+
+	name[2] = 'R';
+	for (d = '0'; d <= '3'; d++)
+	{
+		AML_OBJ obj;
+		UINT32 count;
+		CHAR path[128];
+		name[3] = d;
+		key[sizeof(key) - 2] = d;
+		if (!AmlChildObject(Ns, Node, name, &obj) || (count = NWL_AmlObjPackageCount(&obj)) == 0)
+			continue;
+		NWL_StrBufInit(&sb, NWLC->NwBuf, NWINFO_BUFSZ);
+		for (i = 0; i < count; i++)
+		{
+			AML_OBJ elem;
+			UINT32 ref;
+			if (!NWL_AmlObjPackageElement(&obj, i, &elem)
+				|| (ref = NWL_AmlObjReference(Ns, &elem)) == AML_NONE)
+				continue;
+			NWL_StrBufAppendf(&sb, "%s%s", sb.Len ? "," : "", NWL_AmlGetPath(Ns, ref, path, sizeof(path)));
+		}
+		if (sb.Len)
+			NWL_NodeAttrSet(pNode, key, sb.Buf, 0);
+	}
+}
+
+static void
+PrintAmlCst(PNODE pNode, PAML_NAMESPACE Ns, UINT32 Node)
+{
+	AML_OBJ cst;
+	UINT32 i, count;
+	PNODE list = NULL;
+	if (!AmlChildObject(Ns, Node, "_CST", &cst) || (count = NWL_AmlObjPackageCount(&cst)) < 2)
+		return;
+	// Count, then { Register, Type, Latency, Power } per state
+	for (i = 1; i < count; i++)
+	{
+		AML_OBJ state, reg;
+		UINT64 type, latency, power;
+		CONST UINT8* gas;
+		UINT32 len;
+		PNODE tab;
+		if (!NWL_AmlObjPackageElement(&cst, i, &state)
+			|| !AmlElementInteger(&state, 1, &type)
+			|| !AmlElementInteger(&state, 2, &latency)
+			|| !AmlElementInteger(&state, 3, &power))
+			continue;
+		if (!list)
+			list = NWL_NodeAppendNew(pNode, "C-States", NFLG_TABLE);
+		tab = NWL_NodeAppendNew(list, "C-State", NFLG_TABLE_ROW);
+		NWL_NodeAttrSetf(tab, "Type", 0, "C%llu", type);
+		NWL_NodeAttrSetf(tab, "Latency (us)", NAFLG_FMT_NUMERIC, "%llu", latency);
+		NWL_NodeAttrSetf(tab, "Power (mW)", NAFLG_FMT_NUMERIC, "%llu", power);
+		// Generic Register Descriptor: 0x82, length (word), space id, width, offset, access size, address (qword)
+		if (!NWL_AmlObjPackageElement(&state, 0, &reg) || !NWL_AmlObjBuffer(&reg, &gas, &len)
+			|| len < 15 || gas[0] != 0x82)
+			continue;
+		switch (gas[3])
+		{
+		case 0x00:
+			NWL_NodeAttrSetf(tab, "Register", 0, "Memory 0x%llX", *(UINT64*)(gas + 7));
+			break;
+		case 0x01:
+			NWL_NodeAttrSetf(tab, "Register", 0, "I/O 0x%llX", *(UINT64*)(gas + 7));
+			break;
+		case 0x7F:
+			NWL_NodeAttrSetf(tab, "Register", 0, "FFixedHW 0x%llX", *(UINT64*)(gas + 7));
+			break;
+		default:
+			NWL_NodeAttrSetf(tab, "Register", 0, "Space %u 0x%llX", gas[3], *(UINT64*)(gas + 7));
+		}
+	}
+}
+
+static void
+PrintAmlPss(PNODE pNode, PAML_NAMESPACE Ns, UINT32 Node)
+{
+	AML_OBJ pss;
+	UINT32 i, count;
+	PNODE list = NULL;
+	if (!AmlChildObject(Ns, Node, "_PSS", &pss) || (count = NWL_AmlObjPackageCount(&pss)) == 0)
+		return;
+	for (i = 0; i < count; i++)
+	{
+		AML_OBJ state;
+		UINT64 v[6];
+		UINT32 j;
+		PNODE tab;
+		if (!NWL_AmlObjPackageElement(&pss, i, &state))
+			continue;
+		for (j = 0; j < 6; j++)
+		{
+			if (!AmlElementInteger(&state, j, &v[j]))
+				break;
+		}
+		if (j < 6)
+			continue;
+		if (!list)
+			list = NWL_NodeAppendNew(pNode, "P-States", NFLG_TABLE);
+		tab = NWL_NodeAppendNew(list, "P-State", NFLG_TABLE_ROW);
+		NWL_NodeAttrSetf(tab, "Frequency (MHz)", NAFLG_FMT_NUMERIC, "%llu", v[0]);
+		NWL_NodeAttrSetf(tab, "Power (mW)", NAFLG_FMT_NUMERIC, "%llu", v[1]);
+		NWL_NodeAttrSetf(tab, "Latency (us)", NAFLG_FMT_NUMERIC, "%llu", v[2]);
+		NWL_NodeAttrSetf(tab, "Bus Master Latency (us)", NAFLG_FMT_NUMERIC, "%llu", v[3]);
+		NWL_NodeAttrSetf(tab, "Control", 0, "0x%llX", v[4]);
+		NWL_NodeAttrSetf(tab, "Status", 0, "0x%llX", v[5]);
+	}
+}
+
+static void
+PrintAmlObject(PNODE pNode, PAML_NAMESPACE Ns, UINT32 Node)
+{
+	PAML_NODE n = &Ns->Nodes[Node];
+	CHAR path[128];
+	UINT64 v;
+	PNODE tab = NWL_NodeAppendNew(pNode, "Object", NFLG_TABLE_ROW);
+	NWL_NodeAttrSet(tab, "Path", NWL_AmlGetPath(Ns, Node, path, sizeof(path)), 0);
+	NWL_NodeAttrSet(tab, "Type", AmlTypeToStr(n->Type), 0);
+	switch (n->Type)
+	{
+	case AML_TYPE_DEVICE:
+		PrintAmlIds(tab, Ns, Node);
+		PrintAmlPowerStates(tab, Ns, Node);
+		break;
+	case AML_TYPE_PROCESSOR:
+		// ProcID (byte), PblkAddr (dword), PblkLen (byte)
+		// A Name() redefining the path leaves a shorter data object here
+		if (n->Data && n->End - n->Data >= 6)
+		{
+			UINT32 pblk;
+			memcpy(&pblk, n->Data + 1, sizeof(pblk));
+			NWL_NodeAttrSetf(tab, "Processor ID", NAFLG_FMT_NUMERIC, "%u", n->Data[0]);
+			NWL_NodeAttrSetf(tab, "PBLK Address", 0, "0x%X", pblk);
+			NWL_NodeAttrSetf(tab, "PBLK Length", NAFLG_FMT_NUMERIC, "%u", n->Data[5]);
+		}
+		PrintAmlIds(tab, Ns, Node);
+		break;
+	case AML_TYPE_POWER_RESOURCE:
+		// SystemLevel (byte), ResourceOrder (word)
+		if (n->Data && n->End - n->Data >= 3)
+		{
+			UINT16 order;
+			memcpy(&order, n->Data + 1, sizeof(order));
+			NWL_NodeAttrSetf(tab, "System Level", 0, "S%u", n->Data[0]);
+			NWL_NodeAttrSetf(tab, "Resource Order", NAFLG_FMT_NUMERIC, "%u", order);
+		}
+		break;
+	case AML_TYPE_THERMAL_ZONE:
+		PrintAmlTemp(tab, Ns, Node, "_CRT", "Critical (C)");
+		PrintAmlTemp(tab, Ns, Node, "_HOT", "Hot (C)");
+		PrintAmlTemp(tab, Ns, Node, "_PSV", "Passive (C)");
+		if (AmlChildInteger(Ns, Node, "_TC1", &v))
+			NWL_NodeAttrSetf(tab, "TC1", NAFLG_FMT_NUMERIC, "%llu", v);
+		if (AmlChildInteger(Ns, Node, "_TC2", &v))
+			NWL_NodeAttrSetf(tab, "TC2", NAFLG_FMT_NUMERIC, "%llu", v);
+		// Tenths of seconds
+		if (AmlChildInteger(Ns, Node, "_TSP", &v))
+			NWL_NodeAttrSetf(tab, "Sampling Period (s)", NAFLG_FMT_NUMERIC, "%llu.%llu", v / 10, v % 10);
+		PrintAmlPowerStates(tab, Ns, Node);
+		break;
+	}
+	PrintAmlCst(tab, Ns, Node);
+	PrintAmlPss(tab, Ns, Node);
+}
+
+// Static power management objects from the DSDT and SSDT namespace.
+static void
+PrintAML(PNODE pNode)
+{
+	PAML_NAMESPACE Ns = NWL_AmlLoad();
+	UINT32 i, objects = 0;
+	PNODE aml, list;
+
+	if (!Ns)
+		return;
+	if (Ns->Tables == 0)
+		goto out;
+
+	for (i = 1; i < Ns->Count; i++)
+	{
+		UINT8 type = Ns->Nodes[i].Type;
+		if (type == AML_TYPE_DEVICE || type == AML_TYPE_PROCESSOR
+			|| type == AML_TYPE_POWER_RESOURCE || type == AML_TYPE_THERMAL_ZONE)
+			objects++;
+	}
+	aml = NWL_NodeAppendNew(pNode, "AML Namespace", NFLG_TABLE_ROW);
+	NWL_NodeAttrSetf(aml, "Tables", NAFLG_FMT_NUMERIC, "%u", Ns->Tables);
+	NWL_NodeAttrSetf(aml, "Names", NAFLG_FMT_NUMERIC, "%u", Ns->Count);
+	NWL_NodeAttrSetf(aml, "Objects", NAFLG_FMT_NUMERIC, "%u", objects);
+	NWL_NodeAttrSetf(aml, "Parse Errors", NAFLG_FMT_NUMERIC, "%u", Ns->Errors);
+	list = NWL_NodeAppendNew(aml, "Objects", NFLG_TABLE);
+	for (i = 1; i < Ns->Count; i++)
+	{
+		UINT8 type = Ns->Nodes[i].Type;
+		if (type == AML_TYPE_DEVICE || type == AML_TYPE_PROCESSOR
+			|| type == AML_TYPE_POWER_RESOURCE || type == AML_TYPE_THERMAL_ZONE)
+			PrintAmlObject(list, Ns, i);
+	}
+out:
+	NWL_AmlFree(Ns);
+}
+
 static PNODE PrintTableHeader(PNODE pNode, struct acpi_table_header* Hdr)
 {
 	PNODE tab = NWL_NodeAppendNew(pNode, "Table", NFLG_TABLE_ROW);
+	struct acpi_dir_entry* entry = NWL_GetAcpiDirEntry(Hdr);
+	BOOL checksum_ok = entry ? entry->checksum_ok : (NWL_AcpiChecksum(Hdr, Hdr->length) == 0);
 	PrintU8Str(tab, "Signature", Hdr->signature, 4);
 	NWL_NodeAttrSetf(tab, "Revision", 0, "0x%02x", Hdr->revision);
 	NWL_NodeAttrSetf(tab, "Length", 0, "0x%x", Hdr->length);
 	NWL_NodeAttrSetf(tab, "Checksum", 0, "0x%02x", Hdr->checksum);
-	NWL_NodeAttrSet(tab, "Checksum Status", NWL_AcpiChecksum(Hdr, Hdr->length) == 0 ? "OK" : "ERR", 0);
+	NWL_NodeAttrSet(tab, "Checksum Status", checksum_ok ? "OK" : "ERR", 0);
 	PrintU8Str(tab, "OEM ID", Hdr->oemid, 6);
 	PrintU8Str(tab, "OEM Table ID", Hdr->oemtable, 8);
 	NWL_NodeAttrSetf(tab, "OEM Revision", 0, "0x%lx", Hdr->oemrev);
@@ -134,6 +1629,18 @@ static void PrintTableInfo(PNODE pNode, struct acpi_table_header* Hdr)
 		PrintWPBT(tab, Hdr);
 	else if (memcmp(Hdr->signature, "FACP", 4) == 0)
 		PrintFADT(tab, Hdr);
+	else if (memcmp(Hdr->signature, "SRAT", 4) == 0)
+		PrintSRAT(tab, Hdr);
+	else if (memcmp(Hdr->signature, "SLIT", 4) == 0)
+		PrintSLIT(tab, Hdr);
+	else if (memcmp(Hdr->signature, "HMAT", 4) == 0)
+		PrintHMAT(tab, Hdr);
+	else if (memcmp(Hdr->signature, "FPDT", 4) == 0)
+		PrintFPDT(tab, Hdr);
+	else if (memcmp(Hdr->signature, "PPTT", 4) == 0)
+		PrintPPTT(tab, Hdr);
+	else if (memcmp(Hdr->signature, "MCFG", 4) == 0)
+		PrintMCFG(tab, Hdr);
 }
 
 static void
@@ -158,7 +1665,6 @@ PrintXSDT(PNODE pNode, struct acpi_table_header* Hdr)
 		entry = NWL_NodeAppendNew(entries, name, NFLG_TABLE_ROW);
 		NWL_NodeAttrSetf(entry, "Address", 0, "0x%016llx", xsdt->entry[i]);
 		PrintTableInfo(pNode, t);
-		free(t);
 	}
 }
 
@@ -184,7 +1690,6 @@ PrintRSDT(PNODE pNode, struct acpi_table_header* Hdr)
 		entry = NWL_NodeAppendNew(entries, name, NFLG_TABLE_ROW);
 		NWL_NodeAttrSetf(entry, "Address", 0, "0x%08x", rsdt->entry[i]);
 		PrintTableInfo(pNode, t);
-		free(t);
 	}
 }
 
@@ -217,10 +1722,11 @@ PNODE NW_Acpi(VOID)
 	{
 		struct acpi_table_header* AcpiHdr = NWL_GetAcpi(NWLC->AcpiTable);
 		if (AcpiHdr)
-		{
 			PrintTableInfo(pNode, AcpiHdr);
-			free(AcpiHdr);
-		}
+		if (NWLC->AcpiTable == 'TARS' || NWLC->AcpiTable == 'TILS' || NWLC->AcpiTable == 'TAMH')
+			PrintNUMA(pNode);
+		if (NWLC->AcpiTable == 'TDSD' || NWLC->AcpiTable == 'TDSS')
+			PrintAML(pNode);
 		return pNode;
 	}
 	if (NWLC->NwRsdp)
@@ -228,6 +1734,8 @@ PNODE NW_Acpi(VOID)
 	if (NWLC->NwXsdt)
 		PrintXSDT(pNode, (struct acpi_table_header*)NWLC->NwXsdt);
 	else if (NWLC->NwRsdt)
-		PrintRSDT(pNode, (struct acpi_table_header*)NWLC->NwXsdt);
+		PrintRSDT(pNode, (struct acpi_table_header*)NWLC->NwRsdt);
+	PrintNUMA(pNode);
+	PrintAML(pNode);
 	return pNode;
 }
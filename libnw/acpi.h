@@ -77,6 +77,412 @@ struct acpi_madt
 	struct acpi_madt_entry_header entries[0];
 };
 
+#define ACPI_MADT_LAPIC				0x00
+#define ACPI_MADT_IOAPIC			0x01
+#define ACPI_MADT_INT_OVERRIDE		0x02
+#define ACPI_MADT_NMI_SOURCE		0x03
+#define ACPI_MADT_LAPIC_NMI			0x04
+#define ACPI_MADT_LAPIC_OVERRIDE	0x05
+#define ACPI_MADT_IOSAPIC			0x06
+#define ACPI_MADT_LSAPIC			0x07
+#define ACPI_MADT_PLATFORM_INT		0x08
+#define ACPI_MADT_X2APIC			0x09
+#define ACPI_MADT_X2APIC_NMI		0x0A
+#define ACPI_MADT_GICC				0x0B
+#define ACPI_MADT_GICD				0x0C
+#define ACPI_MADT_GIC_MSI			0x0D
+#define ACPI_MADT_GICR				0x0E
+#define ACPI_MADT_GIC_ITS			0x0F
+
+#define ACPI_MADT_ENABLED			(1U << 0)
+#define ACPI_MADT_ONLINE_CAPABLE	(1U << 1)
+
+struct acpi_madt_lapic
+{
+	struct acpi_madt_entry_header header;
+	UINT8 processor_id;
+	UINT8 apic_id;
+	UINT32 flags;
+};
+
+struct acpi_madt_ioapic
+{
+	struct acpi_madt_entry_header header;
+	UINT8 id;
+	UINT8 reserved;
+	UINT32 addr;
+	UINT32 gsi_base;
+};
+
+struct acpi_madt_int_override
+{
+	struct acpi_madt_entry_header header;
+	UINT8 bus;
+	UINT8 source;
+	UINT32 gsi;
+	UINT16 flags;
+};
+
+struct acpi_madt_nmi_source
+{
+	struct acpi_madt_entry_header header;
+	UINT16 flags;
+	UINT32 gsi;
+};
+
+struct acpi_madt_lapic_nmi
+{
+	struct acpi_madt_entry_header header;
+	UINT8 processor_id;
+	UINT16 flags;
+	UINT8 lint;
+};
+
+struct acpi_madt_lapic_override
+{
+	struct acpi_madt_entry_header header;
+	UINT16 reserved;
+	UINT64 addr;
+};
+
+struct acpi_madt_x2apic
+{
+	struct acpi_madt_entry_header header;
+	UINT16 reserved;
+	UINT32 x2apic_id;
+	UINT32 flags;
+	UINT32 uid;
+};
+
+struct acpi_madt_x2apic_nmi
+{
+	struct acpi_madt_entry_header header;
+	UINT16 flags;
+	UINT32 uid;
+	UINT8 lint;
+	UINT8 reserved[3];
+};
+
+struct acpi_madt_gicc
+{
+	struct acpi_madt_entry_header header;
+	UINT16 reserved;
+	UINT32 cpu_interface_number;
+	UINT32 uid;
+	UINT32 flags;
+	UINT32 parking_version;
+	UINT32 perf_gsiv;
+	UINT64 parked_addr;
+	UINT64 base_addr;
+	UINT64 gicv_addr;
+	UINT64 gich_addr;
+	UINT32 vgic_gsiv;
+	UINT64 gicr_base_addr;
+	UINT64 mpidr;
+	UINT8 efficiency_class;
+	UINT8 reserved2;
+	UINT16 spe_gsiv;
+};
+
+struct acpi_madt_gicd
+{
+	struct acpi_madt_entry_header header;
+	UINT16 reserved;
+	UINT32 gic_id;
+	UINT64 base_addr;
+	UINT32 reserved2;
+	UINT8 version;
+	UINT8 reserved3[3];
+};
+
+struct acpi_madt_gic_msi
+{
+	struct acpi_madt_entry_header header;
+	UINT16 reserved;
+	UINT32 frame_id;
+	UINT64 base_addr;
+	UINT32 flags;
+	UINT16 spi_count;
+	UINT16 spi_base;
+};
+
+struct acpi_madt_gicr
+{
+	struct acpi_madt_entry_header header;
+	UINT16 reserved;
+	UINT64 base_addr;
+	UINT32 length;
+};
+
+struct acpi_madt_gic_its
+{
+	struct acpi_madt_entry_header header;
+	UINT16 reserved;
+	UINT32 its_id;
+	UINT64 base_addr;
+	UINT32 reserved2;
+};
+
+struct acpi_srat
+{
+	struct acpi_table_header header;
+	UINT32 table_revision;
+	UINT64 reserved;
+};
+
+#define ACPI_SRAT_LAPIC				0x00
+#define ACPI_SRAT_MEMORY			0x01
+#define ACPI_SRAT_X2APIC			0x02
+#define ACPI_SRAT_GICC				0x03
+#define ACPI_SRAT_GIC_ITS			0x04
+#define ACPI_SRAT_GENERIC_INITIATOR	0x05
+
+#define ACPI_SRAT_ENABLED			(1U << 0)
+#define ACPI_SRAT_HOT_PLUGGABLE		(1U << 1)
+#define ACPI_SRAT_NON_VOLATILE		(1U << 2)
+
+struct acpi_srat_entry_header
+{
+	UINT8 type;
+	UINT8 len;
+};
+
+struct acpi_srat_lapic
+{
+	struct acpi_srat_entry_header header;
+	UINT8 proximity_domain_lo;
+	UINT8 apic_id;
+	UINT32 flags;
+	UINT8 sapic_eid;
+	UINT8 proximity_domain_hi[3];
+	UINT32 clock_domain;
+};
+
+struct acpi_srat_memory
+{
+	struct acpi_srat_entry_header header;
+	UINT32 proximity_domain;
+	UINT16 reserved;
+	UINT64 base_addr;
+	UINT64 length;
+	UINT32 reserved2;
+	UINT32 flags;
+	UINT64 reserved3;
+};
+
+struct acpi_srat_x2apic
+{
+	struct acpi_srat_entry_header header;
+	UINT16 reserved;
+	UINT32 proximity_domain;
+	UINT32 x2apic_id;
+	UINT32 flags;
+	UINT32 clock_domain;
+	UINT32 reserved2;
+};
+
+struct acpi_srat_gicc
+{
+	struct acpi_srat_entry_header header;
+	UINT32 proximity_domain;
+	UINT32 uid;
+	UINT32 flags;
+	UINT32 clock_domain;
+};
+
+struct acpi_slit
+{
+	struct acpi_table_header header;
+	UINT64 count;
+	UINT8 entry[0];
+};
+
+struct acpi_hmat
+{
+	struct acpi_table_header header;
+	UINT32 reserved;
+};
+
+#define ACPI_HMAT_PROXIMITY			0x00
+#define ACPI_HMAT_LOCALITY			0x01
+#define ACPI_HMAT_CACHE				0x02
+
+struct acpi_hmat_entry_header
+{
+	UINT16 type;
+	UINT16 reserved;
+	UINT32 length;
+};
+
+struct acpi_hmat_proximity
+{
+	struct acpi_hmat_entry_header header;
+	UINT16 flags;
+	UINT16 reserved;
+	UINT32 initiator_pd;
+	UINT32 memory_pd;
+	UINT32 reserved2;
+	UINT64 reserved3;
+	UINT64 reserved4;
+};
+
+struct acpi_hmat_locality
+{
+	struct acpi_hmat_entry_header header;
+	UINT8 flags;
+	UINT8 data_type;
+	UINT8 min_transfer_size;
+	UINT8 reserved;
+	UINT32 initiator_count;
+	UINT32 target_count;
+	UINT32 reserved2;
+	UINT64 entry_base_unit;
+	// UINT32 initiator_pd[initiator_count];
+	// UINT32 target_pd[target_count];
+	// UINT16 entry[initiator_count][target_count];
+};
+
+struct acpi_hmat_cache
+{
+	struct acpi_hmat_entry_header header;
+	UINT32 memory_pd;
+	UINT32 reserved;
+	UINT64 cache_size;
+	UINT32 cache_attributes;
+	UINT16 reserved2;
+	UINT16 smbios_handle_count;
+};
+
+struct acpi_fpdt
+{
+	struct acpi_table_header header;
+};
+
+#define ACPI_FPDT_FBPT_POINTER		0x0000
+#define ACPI_FPDT_S3PT_POINTER		0x0001
+
+#define ACPI_FPDT_S3_RESUME			0x0000
+#define ACPI_FPDT_S3_SUSPEND		0x0001
+#define ACPI_FPDT_BOOT_PERFORMANCE	0x0002
+
+struct acpi_fpdt_record_header
+{
+	UINT16 type;
+	UINT8 length;
+	UINT8 revision;
+};
+
+struct acpi_fpdt_pointer
+{
+	struct acpi_fpdt_record_header header;
+	UINT32 reserved;
+	UINT64 addr;
+};
+
+// FBPT and S3PT share the same header
+struct acpi_fpdt_perf_table
+{
+	UINT8 signature[4];
+	UINT32 length;
+};
+
+// Timestamps are in nanoseconds
+struct acpi_fpdt_boot_performance
+{
+	struct acpi_fpdt_record_header header;
+	UINT32 reserved;
+	UINT64 reset_end;
+	UINT64 os_loader_load_image_start;
+	UINT64 os_loader_start_image_start;
+	UINT64 exit_boot_services_entry;
+	UINT64 exit_boot_services_exit;
+};
+
+struct acpi_fpdt_s3_resume
+{
+	struct acpi_fpdt_record_header header;
+	UINT32 resume_count;
+	UINT64 full_resume;
+	UINT64 average_resume;
+};
+
+struct acpi_fpdt_s3_suspend
+{
+	struct acpi_fpdt_record_header header;
+	UINT64 suspend_start;
+	UINT64 suspend_end;
+};
+
+struct acpi_pptt
+{
+	struct acpi_table_header header;
+};
+
+#define ACPI_PPTT_PROCESSOR			0x00
+#define ACPI_PPTT_CACHE				0x01
+#define ACPI_PPTT_ID				0x02
+
+#define ACPI_PPTT_PHYSICAL_PACKAGE	(1U << 0)
+#define ACPI_PPTT_ACPI_ID_VALID		(1U << 1)
+#define ACPI_PPTT_THREAD			(1U << 2)
+#define ACPI_PPTT_LEAF				(1U << 3)
+#define ACPI_PPTT_IDENTICAL			(1U << 4)
+
+#define ACPI_PPTT_SIZE_VALID		(1U << 0)
+#define ACPI_PPTT_SETS_VALID		(1U << 1)
+#define ACPI_PPTT_ASSOC_VALID		(1U << 2)
+#define ACPI_PPTT_ALLOC_VALID		(1U << 3)
+#define ACPI_PPTT_TYPE_VALID		(1U << 4)
+#define ACPI_PPTT_POLICY_VALID		(1U << 5)
+#define ACPI_PPTT_LINE_VALID		(1U << 6)
+#define ACPI_PPTT_CACHE_ID_VALID	(1U << 7)
+
+struct acpi_pptt_entry_header
+{
+	UINT8 type;
+	UINT8 len;
+	UINT16 reserved;
+};
+
+struct acpi_pptt_processor
+{
+	struct acpi_pptt_entry_header header;
+	UINT32 flags;
+	UINT32 parent;
+	UINT32 acpi_processor_id;
+	UINT32 private_resource_count;
+	UINT32 private_resource[0];
+};
+
+struct acpi_pptt_cache
+{
+	struct acpi_pptt_entry_header header;
+	UINT32 flags;
+	UINT32 next_level;
+	UINT32 size;
+	UINT32 sets;
+	UINT8 associativity;
+	UINT8 attributes;
+	UINT16 line_size;
+	UINT32 cache_id; // revision 3
+};
+
+struct acpi_mcfg_alloc
+{
+	UINT64 base_addr;
+	UINT16 segment;
+	UINT8 start_bus;
+	UINT8 end_bus;
+	UINT32 reserved;
+};
+
+struct acpi_mcfg
+{
+	struct acpi_table_header header;
+	UINT64 reserved;
+	struct acpi_mcfg_alloc entry[0];
+};
+
 struct acpi_bgrt
 {
 	struct acpi_table_header header;
@@ -197,3 +603,18 @@ struct acpi_fadt
 };
 
 #pragma pack()
+
+struct acpi_dir_entry
+{
+	UINT64 addr;		// physical address, 0 if read through GetSystemFirmwareTable
+	UINT32 instance;	// index among the tables with the same signature
+	BOOL checksum_ok;
+	struct acpi_table_header* table;
+};
+
+struct acpi_dir
+{
+	UINT32 count;
+	UINT32 capacity;
+	struct acpi_dir_entry* entries;
+};
@@ -0,0 +1,1153 @@
+// SPDX-License-Identifier: Unlicense
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libnw.h"
+#include "utils.h"
+#include "acpi.h"
+#include "aml.h"
+
+// Read-only AML walker. Only the namespace-defining opcodes are interpreted,
+// method bodies are skipped and everything else is skipped by its encoding.
+
+#define AML_MAX_DEPTH		64
+#define AML_MAX_SEGS		32
+
+#define AML_OP_ZERO			0x00
+#define AML_OP_ONE			0x01
+#define AML_OP_ALIAS		0x06
+#define AML_OP_NAME			0x08
+#define AML_OP_BYTE			0x0A
+#define AML_OP_WORD			0x0B
+#define AML_OP_DWORD		0x0C
+#define AML_OP_STRING		0x0D
+#define AML_OP_QWORD		0x0E
+#define AML_OP_SCOPE		0x10
+#define AML_OP_BUFFER		0x11
+#define AML_OP_PACKAGE		0x12
+#define AML_OP_VARPACKAGE	0x13
+#define AML_OP_METHOD		0x14
+#define AML_OP_EXTERNAL		0x15
+#define AML_OP_DUAL_NAME	0x2E
+#define AML_OP_MULTI_NAME	0x2F
+#define AML_OP_EXT			0x5B
+#define AML_OP_ROOT_CHAR	0x5C
+#define AML_OP_PARENT_CHAR	0x5E
+#define AML_OP_IF			0xA0
+#define AML_OP_ELSE			0xA1
+#define AML_OP_WHILE		0xA2
+#define AML_OP_RETURN		0xA4
+#define AML_OP_ONES			0xFF
+
+#define AML_EXT_MUTEX		0x01
+#define AML_EXT_EVENT		0x02
+#define AML_EXT_CREATE_FIELD	0x13
+#define AML_EXT_REGION		0x80
+#define AML_EXT_FIELD		0x81
+#define AML_EXT_DEVICE		0x82
+#define AML_EXT_PROCESSOR	0x83
+#define AML_EXT_POWER_RES	0x84
+#define AML_EXT_THERMAL_ZONE	0x85
+#define AML_EXT_INDEX_FIELD	0x86
+#define AML_EXT_BANK_FIELD	0x87
+#define AML_EXT_DATA_REGION	0x88
+
+// Operand encodings: T = TermArg, S = SuperName, N = NameString, b/w/d = byte/word/dword
+static const struct
+{
+	UINT16 Op;
+	LPCSTR Args;
+} aml_ops[] =
+{
+	{ 0x70, "TS" },		// Store
+	{ 0x71, "S" },		// RefOf
+	{ 0x72, "TTS" },	// Add
+	{ 0x73, "TTS" },	// Concat
+	{ 0x74, "TTS" },	// Subtract
+	{ 0x75, "S" },		// Increment
+	{ 0x76, "S" },		// Decrement
+	{ 0x77, "TTS" },	// Multiply
+	{ 0x78, "TTSS" },	// Divide
+	{ 0x79, "TTS" },	// ShiftLeft
+	{ 0x7A, "TTS" },	// ShiftRight
+	{ 0x7B, "TTS" },	// And
+	{ 0x7C, "TTS" },	// NAnd
+	{ 0x7D, "TTS" },	// Or
+	{ 0x7E, "TTS" },	// NOr
+	{ 0x7F, "TTS" },	// XOr
+	{ 0x80, "TS" },		// Not
+	{ 0x81, "TS" },		// FindSetLeftBit
+	{ 0x82, "TS" },		// FindSetRightBit
+	{ 0x83, "T" },		// DerefOf
+	{ 0x84, "TTS" },	// ConcatRes
+	{ 0x85, "TTS" },	// Mod
+	{ 0x86, "ST" },		// Notify
+	{ 0x87, "S" },		// SizeOf
+	{ 0x88, "TTS" },	// Index
+	{ 0x89, "TbTbTT" },	// Match
+	{ 0x8E, "S" },		// ObjectType
+	{ 0x90, "TT" },		// LAnd
+	{ 0x91, "TT" },		// LOr
+	{ 0x92, "T" },		// LNot
+	{ 0x93, "TT" },		// LEqual
+	{ 0x94, "TT" },		// LGreater
+	{ 0x95, "TT" },		// LLess
+	{ 0x96, "TS" },		// ToBuffer
+	{ 0x97, "TS" },		// ToDecimalString
+	{ 0x98, "TS" },		// ToHexString
+	{ 0x99, "TS" },		// ToInteger
+	{ 0x9C, "TTS" },	// ToString
+	{ 0x9D, "TS" },		// CopyObject
+	{ 0x9E, "TTTS" },	// Mid
+	{ 0x9F, "" },		// Continue
+	{ 0xA3, "" },		// Noop
+	{ 0xA4, "T" },		// Return
+	{ 0xA5, "" },		// Break
+	{ 0xCC, "" },		// BreakPoint
+	{ 0x5B12, "SS" },	// CondRefOf
+	{ 0x5B1F, "TTTTTT" },	// LoadTable
+	{ 0x5B20, "NS" },	// Load
+	{ 0x5B21, "T" },	// Stall
+	{ 0x5B22, "T" },	// Sleep
+	{ 0x5B23, "Sw" },	// Acquire
+	{ 0x5B24, "S" },	// Signal
+	{ 0x5B25, "ST" },	// Wait
+	{ 0x5B26, "S" },	// Reset
+	{ 0x5B27, "S" },	// Release
+	{ 0x5B28, "TS" },	// FromBCD
+	{ 0x5B29, "TS" },	// ToBCD
+	{ 0x5B2A, "S" },	// Unload
+	{ 0x5B32, "bdT" },	// Fatal
+};
+
+static BOOL
+IsLeadNameChar(UINT8 c)
+{
+	return c == '_' || (c >= 'A' && c <= 'Z');
+}
+
+static BOOL
+IsNameStart(UINT8 c)
+{
+	return c == AML_OP_ROOT_CHAR || c == AML_OP_PARENT_CHAR
+		|| c == AML_OP_DUAL_NAME || c == AML_OP_MULTI_NAME || IsLeadNameChar(c);
+}
+
+static UINT32
+AmlSeg(LPCSTR Name)
+{
+	CHAR seg[4] = { '_', '_', '_', '_' };
+	UINT32 v;
+	int i;
+	for (i = 0; i < 4 && Name[i]; i++)
+		seg[i] = Name[i];
+	memcpy(&v, seg, sizeof(v));
+	return v;
+}
+
+static UINT32
+AmlHashKey(UINT32 Parent, UINT32 Name)
+{
+	UINT32 h = (Name * 0x9E3779B1U) ^ (Parent * 0x85EBCA6BU);
+	return h ^ (h >> 15);
+}
+
+static UINT32
+AmlLookup(PAML_NAMESPACE Ns, UINT32 Parent, UINT32 Name)
+{
+	UINT32 i, mask;
+	if (Ns->HashSize == 0)
+		return AML_NONE;
+	mask = Ns->HashSize - 1;
+	for (i = AmlHashKey(Parent, Name) & mask; Ns->Hash[i] != AML_NONE; i = (i + 1) & mask)
+	{
+		PAML_NODE n = &Ns->Nodes[Ns->Hash[i]];
+		if (n->Parent == Parent && n->Name == Name)
+			return Ns->Hash[i];
+	}
+	return AML_NONE;
+}
+
+static VOID
+AmlHashInsert(PAML_NAMESPACE Ns, UINT32 Index)
+{
+	UINT32 mask = Ns->HashSize - 1;
+	UINT32 i = AmlHashKey(Ns->Nodes[Index].Parent, Ns->Nodes[Index].Name) & mask;
+	while (Ns->Hash[i] != AML_NONE)
+		i = (i + 1) & mask;
+	Ns->Hash[i] = Index;
+}
+
+static BOOL
+AmlHashGrow(PAML_NAMESPACE Ns)
+{
+	UINT32 i;
+	UINT32 size = Ns->HashSize ? Ns->HashSize * 2 : 256;
+	UINT32* hash = malloc(size * sizeof(UINT32));
+	if (!hash)
+		return FALSE;
+	memset(hash, 0xFF, size * sizeof(UINT32));
+	free(Ns->Hash);
+	Ns->Hash = hash;
+	Ns->HashSize = size;
+	// The root is never hashed, it has no (parent, name) of its own
+	for (i = 1; i < Ns->Count; i++)
+		AmlHashInsert(Ns, i);
+	return TRUE;
+}
+
+static UINT32
+AmlAddNode(PAML_NAMESPACE Ns, UINT32 Parent, UINT32 Name, UINT8 Type)
+{
+	PAML_NODE n;
+	PAML_NODE p;
+	UINT32 idx = AmlLookup(Ns, Parent, Name);
+	if (idx != AML_NONE)
+	{
+		n = &Ns->Nodes[idx];
+		if (Type != AML_TYPE_UNKNOWN && Type != AML_TYPE_EXTERNAL
+			&& (n->Type == AML_TYPE_UNKNOWN || n->Type == AML_TYPE_EXTERNAL))
+			n->Type = Type;
+		return idx;
+	}
+
+	if (Ns->Count >= Ns->Capacity)
+	{
+		UINT32 cap = Ns->Capacity ? Ns->Capacity * 2 : 256;
+		PAML_NODE nodes = realloc(Ns->Nodes, cap * sizeof(AML_NODE));
+		if (!nodes)
+			return AML_NONE;
+		Ns->Nodes = nodes;
+		Ns->Capacity = cap;
+	}
+	if ((Ns->Count + 1) * 2 > Ns->HashSize && !AmlHashGrow(Ns))
+		return AML_NONE;
+
+	idx = Ns->Count++;
+	n = &Ns->Nodes[idx];
+	ZeroMemory(n, sizeof(AML_NODE));
+	n->Name = Name;
+	n->Type = Type;
+	n->Parent = Parent;
+	n->Child = AML_NONE;
+	n->LastChild = AML_NONE;
+	n->Next = AML_NONE;
+	n->Target = AML_NONE;
+
+	p = &Ns->Nodes[Parent];
+	if (p->LastChild == AML_NONE)
+		p->Child = idx;
+	else
+		Ns->Nodes[p->LastChild].Next = idx;
+	p->LastChild = idx;
+
+	AmlHashInsert(Ns, idx);
+	return idx;
+}
+
+static UINT32
+AmlFollow(PAML_NAMESPACE Ns, UINT32 Node)
+{
+	int i;
+	for (i = 0; i < 8 && Node != AML_NONE && Ns->Nodes[Node].Type == AML_TYPE_ALIAS; i++)
+		Node = Ns->Nodes[Node].Target;
+	return Node;
+}
+
+// PkgLength includes its own encoding bytes
+static CONST UINT8*
+AmlPkgLength(CONST UINT8* p, CONST UINT8* end, CONST UINT8** pkg_end)
+{
+	UINT32 i, n, len;
+	if (p >= end)
+		return NULL;
+	n = p[0] >> 6;
+	if ((SIZE_T)(end - p) < n + 1)
+		return NULL;
+	if (n == 0)
+		len = p[0] & 0x3F;
+	else
+	{
+		len = p[0] & 0x0F;
+		for (i = 1; i <= n; i++)
+			len |= (UINT32)p[i] << (4 + 8 * (i - 1));
+	}
+	if (len < n + 1 || len > (SIZE_T)(end - p))
+		return NULL;
+	*pkg_end = p + len;
+	return p + n + 1;
+}
+
+static CONST UINT8*
+AmlNameEnd(CONST UINT8* p, CONST UINT8* end)
+{
+	UINT32 segs;
+	if (p < end && *p == AML_OP_ROOT_CHAR)
+		p++;
+	else
+	{
+		while (p < end && *p == AML_OP_PARENT_CHAR)
+			p++;
+	}
+	if (p >= end)
+		return NULL;
+	switch (*p)
+	{
+	case AML_OP_ZERO:
+		return p + 1;
+	case AML_OP_DUAL_NAME:
+		segs = 2;
+		p++;
+		break;
+	case AML_OP_MULTI_NAME:
+		if (p + 1 >= end)
+			return NULL;
+		segs = p[1];
+		p += 2;
+		break;
+	default:
+		if (!IsLeadNameChar(*p))
+			return NULL;
+		segs = 1;
+	}
+	if ((SIZE_T)(end - p) < segs * 4)
+		return NULL;
+	return p + segs * 4;
+}
+
+// Resolve a NameString. Definitions (Create != AML_NONE) create missing
+// path components, references use the upward search rule for single segments.
+static UINT32
+AmlResolve(PAML_NAMESPACE Ns, UINT32 Scope, CONST UINT8* p, UINT32 Create)
+{
+	UINT32 cur = Scope;
+	UINT32 i, segs;
+	BOOL prefix = FALSE;
+	if (*p == AML_OP_ROOT_CHAR)
+	{
+		cur = AML_ROOT;
+		prefix = TRUE;
+		p++;
+	}
+	else
+	{
+		while (*p == AML_OP_PARENT_CHAR)
+		{
+			cur = Ns->Nodes[cur].Parent;
+			prefix = TRUE;
+			p++;
+		}
+	}
+	switch (*p)
+	{
+	case AML_OP_ZERO:
+		return prefix ? cur : AML_NONE;
+	case AML_OP_DUAL_NAME:
+		segs = 2;
+		p++;
+		break;
+	case AML_OP_MULTI_NAME:
+		segs = p[1];
+		p += 2;
+		break;
+	default:
+		segs = 1;
+	}
+
+	if (segs == 1 && !prefix && Create == AML_NONE)
+	{
+		UINT32 name;
+		memcpy(&name, p, sizeof(name));
+		for (;;)
+		{
+			UINT32 n = AmlLookup(Ns, cur, name);
+			if (n != AML_NONE)
+				return n;
+			if (cur == AML_ROOT)
+				return AML_NONE;
+			cur = Ns->Nodes[cur].Parent;
+		}
+	}
+
+	for (i = 0; i < segs; i++, p += 4)
+	{
+		UINT32 name;
+		memcpy(&name, p, sizeof(name));
+		if (Create == AML_NONE)
+			cur = AmlLookup(Ns, cur, name);
+		else
+			cur = AmlAddNode(Ns, cur, name, (UINT8)(i == segs - 1 ? Create : AML_TYPE_UNKNOWN));
+		if (cur == AML_NONE)
+			return AML_NONE;
+	}
+	return cur;
+}
+
+static CONST UINT8*
+AmlParseTermArg(PAML_NAMESPACE Ns, CONST UINT8* p, CONST UINT8* end, UINT32 Scope, BOOL Invoke, int Depth)
+{
+	CONST UINT8* q;
+	UINT16 code;
+	LPCSTR args = NULL;
+	size_t i;
+
+	if (Depth > AML_MAX_DEPTH || p >= end)
+		return NULL;
+
+	switch (*p)
+	{
+	case AML_OP_ZERO:
+	case AML_OP_ONE:
+	case AML_OP_ONES:
+		return p + 1;
+	case AML_OP_BYTE:
+		return end - p >= 2 ? p + 2 : NULL;
+	case AML_OP_WORD:
+		return end - p >= 3 ? p + 3 : NULL;
+	case AML_OP_DWORD:
+		return end - p >= 5 ? p + 5 : NULL;
+	case AML_OP_QWORD:
+		return end - p >= 9 ? p + 9 : NULL;
+	case AML_OP_STRING:
+		q = memchr(p + 1, 0, end - p - 1);
+		return q ? q + 1 : NULL;
+	case AML_OP_BUFFER:
+	case AML_OP_PACKAGE:
+	case AML_OP_VARPACKAGE:
+		return AmlPkgLength(p + 1, end, &q) ? q : NULL;
+	}
+
+	// Local0-7, Arg0-6
+	if (*p >= 0x60 && *p <= 0x6E)
+		return p + 1;
+
+	if (IsNameStart(*p))
+	{
+		q = AmlNameEnd(p, end);
+		if (!q)
+			return NULL;
+		if (Invoke && Ns)
+		{
+			UINT32 n = AmlFollow(Ns, AmlResolve(Ns, Scope, p, AML_NONE));
+			if (n != AML_NONE && Ns->Nodes[n].Type == AML_TYPE_METHOD)
+			{
+				for (i = 0; q && i < Ns->Nodes[n].ArgCount; i++)
+					q = AmlParseTermArg(Ns, q, end, Scope, TRUE, Depth + 1);
+			}
+		}
+		return q;
+	}
+
+	if (*p == AML_OP_EXT)
+	{
+		if (end - p < 2)
+			return NULL;
+		// Debug, Revision, Timer
+		if (p[1] == 0x30 || p[1] == 0x31 || p[1] == 0x33)
+			return p + 2;
+		code = 0x5B00 | p[1];
+		q = p + 2;
+	}
+	else
+	{
+		code = *p;
+		q = p + 1;
+	}
+
+	for (i = 0; i < _countof(aml_ops); i++)
+	{
+		if (aml_ops[i].Op == code)
+		{
+			args = aml_ops[i].Args;
+			break;
+		}
+	}
+	if (!args)
+		return NULL;
+
+	for (; *args && q; args++)
+	{
+		switch (*args)
+		{
+		case 'T':
+		case 'S':
+			q = AmlParseTermArg(Ns, q, end, Scope, TRUE, Depth + 1);
+			break;
+		case 'N':
+			q = AmlNameEnd(q, end);
+			break;
+		case 'b':
+			q = end - q >= 1 ? q + 1 : NULL;
+			break;
+		case 'w':
+			q = end - q >= 2 ? q + 2 : NULL;
+			break;
+		case 'd':
+			q = end - q >= 4 ? q + 4 : NULL;
+			break;
+		}
+	}
+	return q;
+}
+
+static BOOL
+AmlParseTermList(PAML_NAMESPACE Ns, CONST UINT8* p, CONST UINT8* end, UINT32 Scope, int Depth);
+
+// Object with a PkgLength, a name and a nested term list: Device, ThermalZone, Processor, PowerResource
+static CONST UINT8*
+AmlParseNamedScope(PAML_NAMESPACE Ns, CONST UINT8* p, CONST UINT8* end, UINT32 Scope,
+	UINT8 Type, UINT32 Fixed, int Depth)
+{
+	CONST UINT8* pe;
+	CONST UINT8* name_end;
+	UINT32 n;
+	CONST UINT8* q = AmlPkgLength(p, end, &pe);
+	if (!q)
+		return NULL;
+	name_end = AmlNameEnd(q, pe);
+	if (!name_end || (SIZE_T)(pe - name_end) < Fixed)
+		return NULL;
+	n = AmlResolve(Ns, Scope, q, Type);
+	if (n != AML_NONE)
+	{
+		if (Fixed)
+		{
+			Ns->Nodes[n].Data = name_end;
+			Ns->Nodes[n].End = name_end + Fixed;
+		}
+		AmlParseTermList(Ns, name_end + Fixed, pe, n, Depth + 1);
+	}
+	return pe;
+}
+
+static CONST UINT8*
+AmlParseExtOp(PAML_NAMESPACE Ns, CONST UINT8* p, CONST UINT8* end, UINT32 Scope, int Depth)
+{
+	CONST UINT8* q;
+	CONST UINT8* pe;
+	int i;
+	if (end - p < 2)
+		return NULL;
+	switch (p[1])
+	{
+	case AML_EXT_DEVICE:
+		return AmlParseNamedScope(Ns, p + 2, end, Scope, AML_TYPE_DEVICE, 0, Depth);
+	case AML_EXT_THERMAL_ZONE:
+		return AmlParseNamedScope(Ns, p + 2, end, Scope, AML_TYPE_THERMAL_ZONE, 0, Depth);
+	case AML_EXT_PROCESSOR:
+		// ProcID (byte), PblkAddr (dword), PblkLen (byte)
+		return AmlParseNamedScope(Ns, p + 2, end, Scope, AML_TYPE_PROCESSOR, 6, Depth);
+	case AML_EXT_POWER_RES:
+		// SystemLevel (byte), ResourceOrder (word)
+		return AmlParseNamedScope(Ns, p + 2, end, Scope, AML_TYPE_POWER_RESOURCE, 3, Depth);
+	case AML_EXT_FIELD:
+	case AML_EXT_INDEX_FIELD:
+	case AML_EXT_BANK_FIELD:
+		return AmlPkgLength(p + 2, end, &pe) ? pe : NULL;
+	case AML_EXT_REGION:
+		q = AmlNameEnd(p + 2, end);
+		if (!q || q >= end)
+			return NULL;
+		AmlResolve(Ns, Scope, p + 2, AML_TYPE_REGION);
+		q = AmlParseTermArg(Ns, q + 1, end, Scope, TRUE, Depth);
+		return q ? AmlParseTermArg(Ns, q, end, Scope, TRUE, Depth) : NULL;
+	case AML_EXT_DATA_REGION:
+		q = AmlNameEnd(p + 2, end);
+		if (!q)
+			return NULL;
+		AmlResolve(Ns, Scope, p + 2, AML_TYPE_REGION);
+		for (i = 0; i < 3 && q; i++)
+			q = AmlParseTermArg(Ns, q, end, Scope, TRUE, Depth);
+		return q;
+	case AML_EXT_MUTEX:
+		q = AmlNameEnd(p + 2, end);
+		if (!q || q >= end)
+			return NULL;
+		AmlResolve(Ns, Scope, p + 2, AML_TYPE_MUTEX);
+		return q + 1;
+	case AML_EXT_EVENT:
+		q = AmlNameEnd(p + 2, end);
+		if (!q)
+			return NULL;
+		AmlResolve(Ns, Scope, p + 2, AML_TYPE_EVENT);
+		return q;
+	case AML_EXT_CREATE_FIELD:
+		q = p + 2;
+		for (i = 0; i < 3 && q; i++)
+			q = AmlParseTermArg(Ns, q, end, Scope, TRUE, Depth);
+		if (!q || !(pe = AmlNameEnd(q, end)))
+			return NULL;
+		AmlResolve(Ns, Scope, q, AML_TYPE_FIELD);
+		return pe;
+	}
+	return AmlParseTermArg(Ns, p, end, Scope, TRUE, Depth);
+}
+
+static BOOL
+AmlParseTermList(PAML_NAMESPACE Ns, CONST UINT8* p, CONST UINT8* end, UINT32 Scope, int Depth)
+{
+	if (Depth > AML_MAX_DEPTH)
+	{
+		Ns->Errors++;
+		return FALSE;
+	}
+	while (p < end)
+	{
+		CONST UINT8* q = NULL;
+		CONST UINT8* pe;
+		CONST UINT8* name_end;
+		UINT32 n;
+
+		switch (*p)
+		{
+		case AML_OP_SCOPE:
+			q = AmlPkgLength(p + 1, end, &pe);
+			if (!q || !(name_end = AmlNameEnd(q, pe)))
+			{
+				q = NULL;
+				break;
+			}
+			n = AmlResolve(Ns, Scope, q, AML_NONE);
+			if (n == AML_NONE)
+				n = AmlResolve(Ns, Scope, q, AML_TYPE_SCOPE);
+			if (n != AML_NONE)
+				AmlParseTermList(Ns, name_end, pe, AmlFollow(Ns, n), Depth + 1);
+			q = pe;
+			break;
+		case AML_OP_NAME:
+			name_end = AmlNameEnd(p + 1, end);
+			if (!name_end)
+				break;
+			q = AmlParseTermArg(Ns, name_end, end, Scope, FALSE, Depth);
+			if (!q)
+				break;
+			n = AmlResolve(Ns, Scope, p + 1, AML_TYPE_NAME);
+			if (n != AML_NONE)
+			{
+				Ns->Nodes[n].Data = name_end;
+				Ns->Nodes[n].End = q;
+			}
+			break;
+		case AML_OP_ALIAS:
+			name_end = AmlNameEnd(p + 1, end);
+			if (!name_end || !(q = AmlNameEnd(name_end, end)))
+				break;
+			n = AmlResolve(Ns, Scope, name_end, AML_TYPE_ALIAS);
+			if (n != AML_NONE)
+				Ns->Nodes[n].Target = AmlResolve(Ns, Scope, p + 1, AML_NONE);
+			break;
+		case AML_OP_METHOD:
+			q = AmlPkgLength(p + 1, end, &pe);
+			if (!q || !(name_end = AmlNameEnd(q, pe)) || name_end >= pe)
+			{
+				q = NULL;
+				break;
+			}
+			n = AmlResolve(Ns, Scope, q, AML_TYPE_METHOD);
+			if (n != AML_NONE)
+			{
+				Ns->Nodes[n].ArgCount = name_end[0] & 0x07;
+				Ns->Nodes[n].Data = name_end + 1;
+				Ns->Nodes[n].End = pe;
+			}
+			q = pe;
+			break;
+		case AML_OP_EXTERNAL:
+			// NameString, ObjectType (byte), ArgumentCount (byte)
+			name_end = AmlNameEnd(p + 1, end);
+			if (!name_end || end - name_end < 2)
+				break;
+			n = AmlResolve(Ns, Scope, p + 1, AML_TYPE_EXTERNAL);
+			if (n != AML_NONE && name_end[0] == 8 && Ns->Nodes[n].Type == AML_TYPE_EXTERNAL)
+			{
+				Ns->Nodes[n].Type = AML_TYPE_METHOD;
+				Ns->Nodes[n].ArgCount = name_end[1] & 0x07;
+			}
+			q = name_end + 2;
+			break;
+		case 0x8A: // CreateDWordField
+		case 0x8B: // CreateWordField
+		case 0x8C: // CreateByteField
+		case 0x8D: // CreateBitField
+		case 0x8F: // CreateQWordField
+			q = AmlParseTermArg(Ns, p + 1, end, Scope, TRUE, Depth);
+			if (q)
+				q = AmlParseTermArg(Ns, q, end, Scope, TRUE, Depth);
+			if (!q || !(name_end = AmlNameEnd(q, end)))
+			{
+				q = NULL;
+				break;
+			}
+			AmlResolve(Ns, Scope, q, AML_TYPE_FIELD);
+			q = name_end;
+			break;
+		case AML_OP_IF:
+			// Both branches are walked, so objects defined under either show up
+			q = AmlPkgLength(p + 1, end, &pe);
+			if (!q)
+				break;
+			q = AmlParseTermArg(Ns, q, pe, Scope, TRUE, Depth);
+			if (q)
+				AmlParseTermList(Ns, q, pe, Scope, Depth + 1);
+			q = pe;
+			break;
+		case AML_OP_ELSE:
+			q = AmlPkgLength(p + 1, end, &pe);
+			if (!q)
+				break;
+			AmlParseTermList(Ns, q, pe, Scope, Depth + 1);
+			q = pe;
+			break;
+		case AML_OP_WHILE:
+			q = AmlPkgLength(p + 1, end, &pe) ? pe : NULL;
+			break;
+		case AML_OP_EXT:
+			q = AmlParseExtOp(Ns, p, end, Scope, Depth);
+			break;
+		default:
+			q = AmlParseTermArg(Ns, p, end, Scope, TRUE, Depth);
+		}
+
+		if (!q)
+		{
+			Ns->Errors++;
+			return FALSE;
+		}
+		p = q;
+	}
+	return TRUE;
+}
+
+PAML_NAMESPACE
+NWL_AmlCreate(VOID)
+{
+	static LPCSTR predefined[] = { "_GPE", "_PR_", "_SB_", "_SI_", "_TZ_" };
+	PAML_NODE root;
+	size_t i;
+	PAML_NAMESPACE Ns = calloc(1, sizeof(AML_NAMESPACE));
+	if (!Ns)
+		return NULL;
+	Ns->Capacity = 256;
+	Ns->Nodes = malloc(Ns->Capacity * sizeof(AML_NODE));
+	if (!Ns->Nodes || !AmlHashGrow(Ns))
+	{
+		NWL_AmlFree(Ns);
+		return NULL;
+	}
+	root = &Ns->Nodes[AML_ROOT];
+	ZeroMemory(root, sizeof(AML_NODE));
+	root->Name = AmlSeg("\\");
+	root->Type = AML_TYPE_SCOPE;
+	root->Parent = AML_ROOT;
+	root->Child = AML_NONE;
+	root->LastChild = AML_NONE;
+	root->Next = AML_NONE;
+	root->Target = AML_NONE;
+	Ns->Count = 1;
+	for (i = 0; i < _countof(predefined); i++)
+		AmlAddNode(Ns, AML_ROOT, AmlSeg(predefined[i]), AML_TYPE_SCOPE);
+	return Ns;
+}
+
+VOID
+NWL_AmlFree(PAML_NAMESPACE Ns)
+{
+	if (!Ns)
+		return;
+	free(Ns->Nodes);
+	free(Ns->Hash);
+	free(Ns->HidIndex);
+	free(Ns);
+}
+
+BOOL
+NWL_AmlParseTable(PAML_NAMESPACE Ns, CONST VOID* Table)
+{
+	CONST struct acpi_table_header* hdr = Table;
+	if (!Ns || !hdr || hdr->length < sizeof(struct acpi_table_header))
+		return FALSE;
+	Ns->Tables++;
+	return AmlParseTermList(Ns, (CONST UINT8*)Table + sizeof(struct acpi_table_header), (CONST UINT8*)Table + hdr->length, AML_ROOT, 0);
+}
+
+static int
+AmlHidCompare(const void* a, const void* b)
+{
+	CONST AML_HID* x = a;
+	CONST AML_HID* y = b;
+	int r = strcmp(x->Hid, y->Hid);
+	if (r)
+		return r;
+	return (x->Node > y->Node) - (x->Node < y->Node);
+}
+
+VOID
+NWL_AmlBuildHidIndex(PAML_NAMESPACE Ns)
+{
+	UINT32 hid = AmlSeg("_HID");
+	UINT32 i, count = 0;
+
+	free(Ns->HidIndex);
+	Ns->HidIndex = NULL;
+	Ns->HidCount = 0;
+
+	for (i = 1; i < Ns->Count; i++)
+	{
+		if (Ns->Nodes[i].Name == hid)
+			count++;
+	}
+	if (count == 0)
+		return;
+	Ns->HidIndex = malloc(count * sizeof(AML_HID));
+	if (!Ns->HidIndex)
+		return;
+
+	for (i = 1; i < Ns->Count; i++)
+	{
+		AML_OBJ obj;
+		PAML_HID p = &Ns->HidIndex[Ns->HidCount];
+		if (Ns->Nodes[i].Name != hid || !NWL_AmlGetObject(Ns, i, &obj))
+			continue;
+		if (!NWL_AmlObjId(&obj, p->Hid, sizeof(p->Hid)))
+			continue;
+		p->Node = Ns->Nodes[i].Parent;
+		Ns->HidCount++;
+	}
+	qsort(Ns->HidIndex, Ns->HidCount, sizeof(AML_HID), AmlHidCompare);
+}
+
+PAML_NAMESPACE
+NWL_AmlLoad(VOID)
+{
+	UINT32 i;
+	PAML_NAMESPACE Ns = NWL_AmlCreate();
+	if (!Ns)
+		return NULL;
+	// Tables loaded at runtime by Load/LoadTable are not visible here
+	NWL_AmlParseTable(Ns, NWL_GetAcpi('TDSD'));
+	for (i = 0; ; i++)
+	{
+		PVOID ssdt = NWL_GetAcpiInstance('TDSS', i);
+		if (!ssdt)
+			break;
+		NWL_AmlParseTable(Ns, ssdt);
+	}
+	NWL_AmlBuildHidIndex(Ns);
+	return Ns;
+}
+
+UINT32
+NWL_AmlChild(PAML_NAMESPACE Ns, UINT32 Parent, LPCSTR Name)
+{
+	return AmlLookup(Ns, Parent, AmlSeg(Name));
+}
+
+UINT32
+NWL_AmlFindPath(PAML_NAMESPACE Ns, UINT32 Scope, LPCSTR Path)
+{
+	UINT32 cur = Scope;
+	BOOL prefix = FALSE;
+	int i;
+	if (*Path == '\\')
+	{
+		cur = AML_ROOT;
+		prefix = TRUE;
+		Path++;
+	}
+	else
+	{
+		while (*Path == '^')
+		{
+			cur = Ns->Nodes[cur].Parent;
+			prefix = TRUE;
+			Path++;
+		}
+	}
+	if (*Path == '\0')
+		return cur;
+	if (!prefix && !strchr(Path, '.'))
+	{
+		UINT32 name = AmlSeg(Path);
+		for (;;)
+		{
+			UINT32 n = AmlLookup(Ns, cur, name);
+			if (n != AML_NONE || cur == AML_ROOT)
+				return n;
+			cur = Ns->Nodes[cur].Parent;
+		}
+	}
+	while (*Path && cur != AML_NONE)
+	{
+		CHAR seg[5] = { 0 };
+		for (i = 0; i < 4 && *Path && *Path != '.'; i++)
+			seg[i] = *Path++;
+		while (*Path && *Path != '.')
+			Path++;
+		if (*Path == '.')
+			Path++;
+		cur = AmlLookup(Ns, cur, AmlSeg(seg));
+	}
+	return cur;
+}
+
+UINT32
+NWL_AmlFindHid(PAML_NAMESPACE Ns, LPCSTR Hid, UINT32 Nth)
+{
+	UINT32 lo = 0, hi = Ns->HidCount;
+	while (lo < hi)
+	{
+		UINT32 mid = lo + (hi - lo) / 2;
+		if (strcmp(Ns->HidIndex[mid].Hid, Hid) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if (lo + Nth >= Ns->HidCount || strcmp(Ns->HidIndex[lo + Nth].Hid, Hid) != 0)
+		return AML_NONE;
+	return Ns->HidIndex[lo + Nth].Node;
+}
+
+LPCSTR
+NWL_AmlGetPath(PAML_NAMESPACE Ns, UINT32 Node, CHAR* Buf, SIZE_T Size)
+{
+	UINT32 chain[AML_MAX_SEGS];
+	UINT32 depth = 0;
+	NWL_STRBUF sb;
+	NWL_StrBufInit(&sb, Buf, Size);
+	NWL_StrBufAppendChar(&sb, '\\');
+	while (Node != AML_ROOT && Node != AML_NONE && depth < AML_MAX_SEGS)
+	{
+		chain[depth++] = Node;
+		Node = Ns->Nodes[Node].Parent;
+	}
+	while (depth--)
+	{
+		CHAR seg[4];
+		int len = 4;
+		memcpy(seg, &Ns->Nodes[chain[depth]].Name, sizeof(seg));
+		while (len > 1 && seg[len - 1] == '_')
+			len--;
+		NWL_StrBufAppendBytes(&sb, seg, len);
+		if (depth)
+			NWL_StrBufAppendChar(&sb, '.');
+	}
+	return sb.Buf;
+}
+
+BOOL
+NWL_AmlGetObject(PAML_NAMESPACE Ns, UINT32 Node, PAML_OBJ Obj)
+{
+	int i;
+	for (i = 0; i < 4; i++)
+	{
+		PAML_NODE n;
+		CONST UINT8* p;
+		CONST UINT8* q;
+		Node = AmlFollow(Ns, Node);
+		if (Node == AML_NONE)
+			return FALSE;
+		n = &Ns->Nodes[Node];
+		if (!n->Data)
+			return FALSE;
+		if (n->Type == AML_TYPE_NAME)
+		{
+			Obj->Data = n->Data;
+			Obj->End = n->End;
+			Obj->Scope = n->Parent;
+			return TRUE;
+		}
+		if (n->Type != AML_TYPE_METHOD)
+			return FALSE;
+
+		// Method whose body is a single Return of a constant or a named object
+		p = n->Data;
+		if (p >= n->End || *p != AML_OP_RETURN)
+			return FALSE;
+		p++;
+		if (p < n->End && IsNameStart(*p))
+		{
+			if (!AmlNameEnd(p, n->End))
+				return FALSE;
+			Node = AmlResolve(Ns, Node, p, AML_NONE);
+			continue;
+		}
+		q = AmlParseTermArg(NULL, p, n->End, Node, FALSE, 0);
+		if (!q || (*p != AML_OP_ZERO && *p != AML_OP_ONE && *p != AML_OP_ONES
+			&& (*p < AML_OP_BYTE || *p > AML_OP_VARPACKAGE)))
+			return FALSE;
+		Obj->Data = p;
+		Obj->End = q;
+		Obj->Scope = Node;
+		return TRUE;
+	}
+	return FALSE;
+}
+
+BOOL
+NWL_AmlObjInteger(CONST AML_OBJ* Obj, UINT64* Value)
+{
+	CONST UINT8* p = Obj->Data;
+	SIZE_T len = 0;
+	if (p >= Obj->End)
+		return FALSE;
+	switch (*p)
+	{
+	case AML_OP_ZERO:
+		*Value = 0;
+		return TRUE;
+	case AML_OP_ONE:
+		*Value = 1;
+		return TRUE;
+	case AML_OP_ONES:
+		*Value = ~0ULL;
+		return TRUE;
+	case AML_OP_BYTE:
+		len = 1;
+		break;
+	case AML_OP_WORD:
+		len = 2;
+		break;
+	case AML_OP_DWORD:
+		len = 4;
+		break;
+	case AML_OP_QWORD:
+		len = 8;
+		break;
+	default:
+		return FALSE;
+	}
+	if ((SIZE_T)(Obj->End - p) < len + 1)
+		return FALSE;
+	*Value = 0;
+	memcpy(Value, p + 1, len);
+	return TRUE;
+}
+
+BOOL
+NWL_AmlObjId(CONST AML_OBJ* Obj, CHAR* Buf, SIZE_T Size)
+{
+	UINT64 v;
+	UINT8 b[4];
+	if (Size == 0 || Obj->Data >= Obj->End)
+		return FALSE;
+	if (Obj->Data[0] == AML_OP_STRING)
+	{
+		NWL_STRBUF sb;
+		NWL_StrBufInit(&sb, Buf, Size);
+		NWL_StrBufAppendf(&sb, "%s", (LPCSTR)Obj->Data + 1);
+		return TRUE;
+	}
+	if (!NWL_AmlObjInteger(Obj, &v))
+		return FALSE;
+	// Compressed EISA ID, e.g. 0x030AD041 -> PNP0A03
+	b[0] = (UINT8)v;
+	b[1] = (UINT8)(v >> 8);
+	b[2] = (UINT8)(v >> 16);
+	b[3] = (UINT8)(v >> 24);
+	snprintf(Buf, Size, "%c%c%c%02X%02X",
+		((b[0] >> 2) & 0x1F) + 0x40,
+		(((b[0] & 0x03) << 3) | (b[1] >> 5)) + 0x40,
+		(b[1] & 0x1F) + 0x40,
+		b[2], b[3]);
+	return TRUE;
+}
+
+BOOL
+NWL_AmlObjBuffer(CONST AML_OBJ* Obj, CONST UINT8** Data, UINT32* Length)
+{
+	CONST UINT8* pe;
+	CONST UINT8* p;
+	CONST UINT8* q;
+	AML_OBJ size;
+	UINT64 len;
+	if (Obj->Data >= Obj->End || Obj->Data[0] != AML_OP_BUFFER)
+		return FALSE;
+	p = AmlPkgLength(Obj->Data + 1, Obj->End, &pe);
+	if (!p)
+		return FALSE;
+	q = AmlParseTermArg(NULL, p, pe, Obj->Scope, FALSE, 0);
+	size.Data = p;
+	size.End = pe;
+	size.Scope = Obj->Scope;
+	if (!q || !NWL_AmlObjInteger(&size, &len))
+		return FALSE;
+	if (len > (UINT64)(pe - q))
+		len = pe - q;
+	*Data = q;
+	*Length = (UINT32)len;
+	return TRUE;
+}
+
+static CONST UINT8*
+AmlPackageElements(CONST AML_OBJ* Obj, CONST UINT8** End, UINT32* Count)
+{
+	CONST UINT8* p;
+	CONST UINT8* q;
+	AML_OBJ num;
+	UINT64 n = 0;
+	if (Obj->Data >= Obj->End)
+		return NULL;
+	if (Obj->Data[0] != AML_OP_PACKAGE && Obj->Data[0] != AML_OP_VARPACKAGE)
+		return NULL;
+	p = AmlPkgLength(Obj->Data + 1, Obj->End, End);
+	if (!p || p >= *End)
+		return NULL;
+	if (Obj->Data[0] == AML_OP_PACKAGE)
+	{
+		*Count = *p;
+		return p + 1;
+	}
+	q = AmlParseTermArg(NULL, p, *End, Obj->Scope, FALSE, 0);
+	num.Data = p;
+	num.End = *End;
+	num.Scope = Obj->Scope;
+	if (!q || !NWL_AmlObjInteger(&num, &n))
+		return NULL;
+	*Count = (UINT32)n;
+	return q;
+}
+
+UINT32
+NWL_AmlObjPackageCount(CONST AML_OBJ* Obj)
+{
+	CONST UINT8* pe;
+	UINT32 count = 0;
+	if (!AmlPackageElements(Obj, &pe, &count))
+		return 0;
+	return count;
+}
+
+BOOL
+NWL_AmlObjPackageElement(CONST AML_OBJ* Obj, UINT32 Index, PAML_OBJ Elem)
+{
+	CONST UINT8* pe;
+	UINT32 i, count;
+	CONST UINT8* p = AmlPackageElements(Obj, &pe, &count);
+	if (!p || Index >= count)
+		return FALSE;
+	for (i = 0; p < pe; i++)
+	{
+		CONST UINT8* q = AmlParseTermArg(NULL, p, pe, Obj->Scope, FALSE, 0);
+		if (!q)
+			return FALSE;
+		if (i == Index)
+		{
+			Elem->Data = p;
+			Elem->End = q;
+			Elem->Scope = Obj->Scope;
+			return TRUE;
+		}
+		p = q;
+	}
+	return FALSE;
+}
+
+UINT32
+NWL_AmlObjReference(PAML_NAMESPACE Ns, CONST AML_OBJ* Obj)
+{
+	if (Obj->Data >= Obj->End || !IsNameStart(Obj->Data[0]) || !AmlNameEnd(Obj->Data, Obj->End))
+		return AML_NONE;
+	return AmlFollow(Ns, AmlResolve(Ns, Obj->Scope, Obj->Data, AML_NONE));
+}
@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: Unlicense
+#pragma once
+
+#include <windows.h>
+
+// Read-only AML namespace, built from DSDT and SSDTs without executing any method.
+
+#define AML_NONE				0xFFFFFFFFU
+#define AML_ROOT				0
+
+#define AML_TYPE_UNKNOWN		0	// Created as part of a path, not defined yet
+#define AML_TYPE_SCOPE			1
+#define AML_TYPE_NAME			2
+#define AML_TYPE_METHOD			3
+#define AML_TYPE_DEVICE			4
+#define AML_TYPE_PROCESSOR		5
+#define AML_TYPE_POWER_RESOURCE	6
+#define AML_TYPE_THERMAL_ZONE	7
+#define AML_TYPE_REGION			8
+#define AML_TYPE_FIELD			9
+#define AML_TYPE_MUTEX			10
+#define AML_TYPE_EVENT			11
+#define AML_TYPE_ALIAS			12
+#define AML_TYPE_EXTERNAL		13
+
+typedef struct _AML_NODE
+{
+	UINT32 Name;						// NameSeg, e.g. '_HID' is stored as "_HID"
+	UINT8 Type;							// AML_TYPE_*
+	UINT8 ArgCount;						// Method argument count
+	UINT32 Parent;						// Parent node index, the root is its own parent
+	UINT32 Child;						// First child or AML_NONE
+	UINT32 LastChild;					// Last child or AML_NONE
+	UINT32 Next;						// Next sibling or AML_NONE
+	UINT32 Target;						// Alias target or AML_NONE
+	CONST UINT8* Data;					// Name: data object, Method: body, Processor/PowerResource: fixed fields
+	CONST UINT8* End;					// End of Data
+} AML_NODE, * PAML_NODE;
+
+typedef struct _AML_HID
+{
+	CHAR Hid[16];
+	UINT32 Node;
+} AML_HID, * PAML_HID;
+
+typedef struct _AML_NAMESPACE
+{
+	PAML_NODE Nodes;
+	UINT32 Count;
+	UINT32 Capacity;
+	UINT32* Hash;						// (parent, name) -> node index
+	UINT32 HashSize;
+	PAML_HID HidIndex;					// Sorted by Hid
+	UINT32 HidCount;
+	UINT32 Tables;
+	UINT32 Errors;						// Term lists abandoned on unknown opcodes
+} AML_NAMESPACE, * PAML_NAMESPACE;
+
+// A raw AML data object, e.g. an integer, string, buffer or package.
+typedef struct _AML_OBJ
+{
+	CONST UINT8* Data;
+	CONST UINT8* End;
+	UINT32 Scope;						// Scope used to resolve names inside the object
+} AML_OBJ, * PAML_OBJ;
+
+PAML_NAMESPACE NWL_AmlCreate(VOID);
+VOID NWL_AmlFree(PAML_NAMESPACE Ns);
+BOOL NWL_AmlParseTable(PAML_NAMESPACE Ns, CONST VOID* Table);
+PAML_NAMESPACE NWL_AmlLoad(VOID);
+VOID NWL_AmlBuildHidIndex(PAML_NAMESPACE Ns);
+
+UINT32 NWL_AmlChild(PAML_NAMESPACE Ns, UINT32 Parent, LPCSTR Name);
+UINT32 NWL_AmlFindPath(PAML_NAMESPACE Ns, UINT32 Scope, LPCSTR Path);
+UINT32 NWL_AmlFindHid(PAML_NAMESPACE Ns, LPCSTR Hid, UINT32 Nth);
+LPCSTR NWL_AmlGetPath(PAML_NAMESPACE Ns, UINT32 Node, CHAR* Buf, SIZE_T Size);
+
+BOOL NWL_AmlGetObject(PAML_NAMESPACE Ns, UINT32 Node, PAML_OBJ Obj);
+BOOL NWL_AmlObjInteger(CONST AML_OBJ* Obj, UINT64* Value);
+BOOL NWL_AmlObjId(CONST AML_OBJ* Obj, CHAR* Buf, SIZE_T Size);
+BOOL NWL_AmlObjBuffer(CONST AML_OBJ* Obj, CONST UINT8** Data, UINT32* Length);
+UINT32 NWL_AmlObjPackageCount(CONST AML_OBJ* Obj);
+BOOL NWL_AmlObjPackageElement(CONST AML_OBJ* Obj, UINT32 Index, PAML_OBJ Elem);
+UINT32 NWL_AmlObjReference(PAML_NAMESPACE Ns, CONST AML_OBJ* Obj);
@@ -2,7 +2,6 @@
 
 #include <stdlib.h>
 #include <string.h>
-#include <intrin.h>
 
 #include "libnw.h"
 #include <libcpuid.h>
@@ -39,23 +38,150 @@ GetHypervisorName(LPCSTR lpszSignature)
 	return "Unknown Hypervisor";
 }
 
+// Hyper-V TLFS, CPUID 40000003h EAX: partition privileges
+static LPCSTR HvPrivileges[32] =
+{
+	"VP Runtime", "Partition Reference Counter", "SynIC", "Synthetic Timers",
+	"APIC MSRs", "Hypercall MSRs", "VP Index", "Reset MSR",
+	"Stats MSR", "Partition Reference TSC", "Guest Idle MSR", "Frequency MSRs",
+	"Debug MSRs", "Reenlightenment Controls",
+};
+
+// Hyper-V TLFS, CPUID 40000003h EDX: features
+static LPCSTR HvFeatures[32] =
+{
+	"MWAIT", "Guest Debugging", "Performance Monitor", "CPU Dynamic Partitioning",
+	"XMM Hypercall Input", "Guest Idle State", "Hypervisor Sleep State", "NUMA Distance Query",
+	"Timer Frequencies", "Synthetic Machine Check", "Guest Crash MSRs", "Debug MSRs",
+	"NPIEP", "Disable Hypervisor", "Extended GVA Ranges Flush", "XMM Hypercall Output",
+	NULL, "SINT Polling Mode", "Hypercall MSR Lock", "Direct Synthetic Timers",
+};
+
+// Hyper-V TLFS, CPUID 40000004h EAX: implementation recommendations
+static LPCSTR HvRecommendations[32] =
+{
+	"Address Space Switch Hypercall", "Local TLB Flush Hypercall", "Remote TLB Flush Hypercall", "APIC MSRs",
+	"Reset MSR", "Relaxed Timing", "DMA Remapping", "Interrupt Remapping",
+	"x2APIC MSRs", "Deprecate AutoEOI", "Synthetic Cluster IPI", "Ex Processor Masks",
+	"Nested", "INT for MBEC", "Enlightened VMCS", "Synced Timeline",
+	NULL, "Direct Local Flush Entire", "No Non-Arch Core Sharing",
+};
+
+// Linux Documentation/virt/kvm/x86/cpuid.rst, CPUID 40000001h EAX
+static LPCSTR KvmFeatures[32] =
+{
+	"clocksource", "nop_io_delay", "mmu_op", "clocksource2",
+	"async_pf", "steal_time", "pv_eoi", "pv_unhalt",
+	NULL, "pv_tlb_flush", "async_pf_vmexit", "pv_send_ipi",
+	"poll_control", "pv_sched_yield", "async_pf_int", "msi_ext_dest_id",
+	"hc_map_gpa_range", "migration_control", NULL, NULL,
+	NULL, NULL, NULL, NULL,
+	"clocksource_stable",
+};
+
+static PNODE
+PrintHypervisorFlags(PNODE node, LPCSTR name, uint32_t value, LPCSTR flags[32])
+{
+	int i;
+	PNODE group = NWL_NodeAppendNew(node, name, NFLG_ATTGROUP);
+	for (i = 0; i < 32; i++)
+	{
+		if (flags[i])
+			NWL_NodeAttrSetBool(group, flags[i], (value >> i) & 1, 0);
+	}
+	return group;
+}
+
+static void
+PrintHyperV(PNODE node, uint32_t max_leaf)
+{
+	uint32_t regs[NUM_REGS];
+	if (max_leaf < 0x40000003U)
+		return;
+	// Interface signature "Hv#1", also exposed by other hypervisors emulating Hyper-V
+	cpuid_get_raw_leaf(0x40000001U, 0, regs);
+	if (regs[EAX] != 0x31237648U)
+		return;
+	cpuid_get_raw_leaf(0x40000003U, 0, regs);
+	PrintHypervisorFlags(node, "Hyper-V Privileges", regs[EAX], HvPrivileges);
+	PrintHypervisorFlags(node, "Hyper-V Features", regs[EDX], HvFeatures);
+	if (max_leaf < 0x40000004U)
+		return;
+	cpuid_get_raw_leaf(0x40000004U, 0, regs);
+	PrintHypervisorFlags(node, "Hyper-V Recommendations", regs[EAX], HvRecommendations);
+	if (regs[EBX] == 0xFFFFFFFFU)
+		NWL_NodeAttrSet(node, "Hyper-V Spinlock Retries", "Never Notify", 0);
+	else
+		NWL_NodeAttrSetf(node, "Hyper-V Spinlock Retries", NAFLG_FMT_NUMERIC, "%u", regs[EBX]);
+}
+
+static void
+PrintKvm(PNODE node, uint32_t base)
+{
+	uint32_t regs[NUM_REGS];
+	PNODE group;
+	cpuid_get_raw_leaf(base + 1, 0, regs);
+	group = PrintHypervisorFlags(node, "KVM Features", regs[EAX], KvmFeatures);
+	NWL_NodeAttrSetBool(group, "realtime", regs[EDX] & 1, 0);
+}
+
+// Xen puts its TSC leaf at base + 3, sub-leaf 0 ECX is the guest TSC rate in kHz
+static void
+PrintXen(PNODE node, uint32_t base, uint32_t max_leaf)
+{
+	uint32_t regs[NUM_REGS];
+	if (max_leaf < base + 3)
+		return;
+	cpuid_get_raw_leaf(base + 3, 0, regs);
+	if (regs[ECX])
+		NWL_NodeAttrSetf(node, "Hypervisor TSC Clock (MHz)", NAFLG_FMT_NUMERIC, "%.3lf", regs[ECX] / 1000.0);
+}
+
 static void
 PrintHypervisor(PNODE node)
 {
-	int cpuInfo[4] = { 0 };
-	unsigned MaxFunc = 0;
+	uint32_t regs[NUM_REGS];
+	uint32_t max_leaf;
 	char VmSign[13] = { 0 };
-	__cpuid(cpuInfo, 0);
-	MaxFunc = cpuInfo[0];
-	if (MaxFunc < 1U)
-		return;
-	__cpuid(cpuInfo, 1);
-	if (((unsigned)cpuInfo[2] & (1U << 31U)) == 0)
+	if (cpuid_get_raw_leaf(1, 0, regs) < 0 || (regs[ECX] & (1U << 31U)) == 0)
 		return;
-	__cpuid(cpuInfo, 0x40000000U);
-	memcpy(VmSign, &cpuInfo[1], 12);
+	cpuid_get_raw_leaf(0x40000000U, 0, regs);
+	max_leaf = regs[EAX];
+	memcpy(VmSign, &regs[EBX], 12);
 	NWL_NodeAttrSet(node, "Hypervisor", GetHypervisorName(VmSign), 0);
 	NWL_NodeAttrSet(node, "Hypervisor Signature", VmSign, 0);
+	// Old KVM reports 0, meaning 40000001h
+	if (max_leaf < 0x40000000U)
+		max_leaf = strcmp(VmSign, "KVMKVMKVM") == 0 ? 0x40000001U : 0x40000000U;
+	NWL_NodeAttrSetf(node, "Hypervisor Max Leaf", 0, "%08Xh", max_leaf);
+
+	PrintHyperV(node, max_leaf);
+	if (strcmp(VmSign, "KVMKVMKVM") == 0)
+		PrintKvm(node, 0x40000000U);
+	else if (strcmp(VmSign, "XenVMMXenVMM") == 0)
+		PrintXen(node, 0x40000000U, max_leaf);
+	else if (max_leaf >= 0x40000003U)
+	{
+		// KVM and Xen with Hyper-V enlightenments move their own leaves to 40000100h
+		uint32_t max_sub;
+		cpuid_get_raw_leaf(0x40000100U, 0, regs);
+		max_sub = regs[EAX];
+		memcpy(VmSign, &regs[EBX], 12);
+		if (strcmp(VmSign, "KVMKVMKVM") == 0 && max_sub >= 0x40000101U)
+			PrintKvm(node, 0x40000100U);
+		else if (strcmp(VmSign, "XenVMMXenVMM") == 0)
+			PrintXen(node, 0x40000100U, max_sub);
+	}
+
+	// VMware timing leaf, also offered by QEMU/KVM (tsc-frequency) and others
+	if (max_leaf >= 0x40000010U)
+	{
+		cpuid_get_raw_leaf(0x40000010U, 0, regs);
+		if (regs[EAX])
+			NWL_NodeAttrSetf(node, "Hypervisor TSC Clock (MHz)", NAFLG_FMT_NUMERIC, "%.3lf", regs[EAX] / 1000.0);
+		if (regs[EBX])
+			NWL_NodeAttrSetf(node, "Hypervisor APIC Bus Clock (MHz)", NAFLG_FMT_NUMERIC, "%.3lf", regs[EBX] / 1000.0);
+	}
 }
 
 static void
@@ -93,7 +219,7 @@ static int rdmsr_supported(void)
 }
 
 static void
-PrintMsr(PNODE node)
+PrintMsr(PNODE node, struct msr_session_t* session)
 {
 	int value = CPU_INVALID_VALUE;
 	if (!rdmsr_supported())
@@ -106,9 +232,9 @@ PrintMsr(PNODE node)
 		fprintf(stderr, "Cannot load driver!\n");
 		return;
 	}
-	int min_multi = cpu_msrinfo(NWLC->NwDrv, INFO_MIN_MULTIPLIER);
-	int max_multi = cpu_msrinfo(NWLC->NwDrv, INFO_MAX_MULTIPLIER);
-	int cur_multi = cpu_msrinfo(NWLC->NwDrv, INFO_CUR_MULTIPLIER);
+	int min_multi = cpu_msrinfo_session(session, INFO_MIN_MULTIPLIER);
+	int max_multi = cpu_msrinfo_session(session, INFO_MAX_MULTIPLIER);
+	int cur_multi = cpu_msrinfo_session(session, INFO_CUR_MULTIPLIER);
 	if (min_multi == CPU_INVALID_VALUE)
 		min_multi = 0;
 	if (max_multi == CPU_INVALID_VALUE)
@@ -119,78 +245,543 @@ PrintMsr(PNODE node)
 	NWL_NodeAttrSetf(nmulti, "Current", NAFLG_FMT_NUMERIC, "%.1lf", cur_multi / 100.0);
 	NWL_NodeAttrSetf(nmulti, "Max", NAFLG_FMT_NUMERIC, "%d", max_multi / 100);
 	NWL_NodeAttrSetf(nmulti, "Min", NAFLG_FMT_NUMERIC, "%d", min_multi / 100);
-	value = cpu_msrinfo(NWLC->NwDrv, INFO_TEMPERATURE);
+	value = cpu_msrinfo_session(session, INFO_TEMPERATURE);
 	if (value != CPU_INVALID_VALUE && value > 0)
 		NWL_NodeAttrSetf(node, "Temperature (C)", NAFLG_FMT_NUMERIC, "%d", value);
-	value = cpu_msrinfo(NWLC->NwDrv, INFO_THROTTLING);
+	value = cpu_msrinfo_session(session, INFO_THROTTLING);
 	if (value != CPU_INVALID_VALUE && value > 0)
 		NWL_NodeAttrSetBool(node, "Throttling", value, 0);
-	value = cpu_msrinfo(NWLC->NwDrv, INFO_VOLTAGE);
+	value = cpu_msrinfo_session(session, INFO_VOLTAGE);
 	if (value != CPU_INVALID_VALUE && value > 0)
 		NWL_NodeAttrSetf(node, "Core Voltage (V)", NAFLG_FMT_NUMERIC, "%.2lf", value / 100.0);
-	value = cpu_msrinfo(NWLC->NwDrv, INFO_BUS_CLOCK);
+	value = cpu_msrinfo_session(session, INFO_BUS_CLOCK);
 	if (value != CPU_INVALID_VALUE && value > 0)
 		NWL_NodeAttrSetf(node, "Bus Clock (MHz)", NAFLG_FMT_NUMERIC, "%.2lf", value / 100.0);
 }
 
-PNODE NW_Cpuid(VOID)
+#define IA32_MPERF 0xE7
+#define IA32_APERF 0xE8
+
+static const uint32_t perf_msrs[] = { IA32_MPERF, IA32_APERF };
+
+// Base clock in MHz from CPUID 16h, the AMD P0 P-state or the brand string, 0 if unknown.
+// The P-state MSR belongs to this machine, it is skipped for loaded dumps.
+static int
+GetBaseClock(const struct cpu_raw_data_t* raw, const struct cpu_id_t* data)
 {
-	struct cpu_raw_data_t raw = { 0 };
-	struct cpu_id_t data = { 0 };
-	int i = 0;
-	PNODE cache, feature;
-	BOOL saved_human_size;
-	PNODE node = NWL_NodeAlloc("CPUID", 0);
-	if (NWLC->CpuInfo)
-		NWL_NodeAppendChild(NWLC->NwRoot, node);
-	if (cpuid_get_raw_data(&raw) < 0)
+	int base = 0;
+	const char* at;
+	if (raw->basic_cpuid[0][EAX] >= 0x16)
+		base = raw->basic_cpuid[0x16][EAX] & 0xFFFF;
+	if (base == 0 && (data->vendor == VENDOR_AMD || data->vendor == VENDOR_HYGON)
+		&& !NWLC->CpuLoad && NWLC->NwDrv && rdmsr_supported())
 	{
-		fprintf(stderr, "Cannot obtain raw CPU data!\n");
-		return node;
+		// P0 multiplier * 100, the P-state reference is 100 MHz
+		int multi = cpu_msrinfo(NWLC->NwDrv, INFO_MAX_MULTIPLIER);
+		if (multi != CPU_INVALID_VALUE && multi > 0)
+			base = multi;
 	}
+	// "... CPU @ 3.60GHz"
+	at = strrchr(data->brand_str, '@');
+	if (base == 0 && at)
+	{
+		char* end;
+		double ghz = strtod(at + 1, &end);
+		if (ghz > 0.0 && _strnicmp(end, "GHz", 3) == 0)
+			base = (int)(ghz * 1000.0 + 0.5);
+	}
+	return base;
+}
 
-	if (cpu_identify(&raw, &data) < 0)
-		fprintf(stderr, "Error identifying the CPU: %s\n", cpuid_error());
-	PrintHypervisor(node);
-	NWL_NodeAttrSet(node, "Vendor", data.vendor_str, 0);
-	NWL_NodeAttrSet(node, "Brand", data.brand_str, 0);
-	NWL_NodeAttrSet(node, "Code Name", data.cpu_codename, 0);
-	NWL_NodeAttrSetf(node, "Family", 0, "%02Xh", data.family);
-	NWL_NodeAttrSetf(node, "Model", 0, "%02Xh", data.model);
-	NWL_NodeAttrSetf(node, "Stepping", 0, "%02Xh", data.stepping);
-	NWL_NodeAttrSetf(node, "Ext.Family", 0, "%02Xh", data.ext_family);
-	NWL_NodeAttrSetf(node, "Ext.Model", 0, "%02Xh", data.ext_model);
-
-	NWL_NodeAttrSetf(node, "Cores", NAFLG_FMT_NUMERIC, "%d", data.num_cores);
-	NWL_NodeAttrSetf(node, "Logical CPUs", NAFLG_FMT_NUMERIC, "%d", data.num_logical_cpus);
-	NWL_NodeAttrSetf(node, "Total CPUs", NAFLG_FMT_NUMERIC, "%d", cpuid_get_total_cpus());
-	cache = NWL_NodeAppendNew(node, "Cache", NFLG_ATTGROUP);
+// Nominal clocks come from CPUID 15h/16h or the AMD P-state MSRs, the timed
+// busy loop only runs on request (--cpu=measure).
+static void
+PrintClock(PNODE node, const struct cpu_raw_data_t* raw, const struct cpu_id_t* data,
+	struct msr_session_t* session)
+{
+	uint32_t max_leaf = raw->basic_cpuid[0][EAX];
+	int base = GetBaseClock(raw, data), max = 0, ref = 0, effective, clock;
+	uint64_t crystal_hz = 0;
+
+	if (max_leaf >= 0x16)
+	{
+		max = raw->basic_cpuid[0x16][EBX] & 0xFFFF;
+		ref = raw->basic_cpuid[0x16][ECX] & 0xFFFF;
+	}
+	if (max_leaf >= 0x15 && raw->basic_cpuid[0x15][EAX] && raw->basic_cpuid[0x15][EBX])
+	{
+		const uint32_t* leaf = raw->basic_cpuid[0x15];
+		crystal_hz = leaf[ECX];
+		// Crystal not enumerated, derive it from the base clock and the TSC ratio
+		if (crystal_hz == 0 && base > 0)
+			crystal_hz = (uint64_t)base * 1000000ULL * leaf[EAX] / leaf[EBX];
+		if (crystal_hz)
+		{
+			NWL_NodeAttrSetf(node, "Crystal Clock (MHz)", NAFLG_FMT_NUMERIC, "%.3lf", crystal_hz / 1000000.0);
+			NWL_NodeAttrSetf(node, "TSC Clock (MHz)", NAFLG_FMT_NUMERIC, "%.3lf",
+				(double)crystal_hz * leaf[EBX] / leaf[EAX] / 1000000.0);
+		}
+	}
+	if (base > 0)
+		NWL_NodeAttrSetf(node, "Base Clock (MHz)", NAFLG_FMT_NUMERIC, "%d", base);
+	if (max > 0)
+		NWL_NodeAttrSetf(node, "Max Clock (MHz)", NAFLG_FMT_NUMERIC, "%d", max);
+	if (ref > 0)
+		NWL_NodeAttrSetf(node, "Reference Clock (MHz)", NAFLG_FMT_NUMERIC, "%d", ref);
+	// Loaded from a dump, the clocks below belong to this machine
+	if (NWLC->CpuLoad)
+		return;
+	effective = 0;
+	if (max_leaf >= 6 && (raw->basic_cpuid[6][ECX] & 0x01) && session->handle)
+	{
+		effective = cpu_msrinfo_session(session, INFO_EFFECTIVE_CLOCK);
+		if (effective == CPU_INVALID_VALUE)
+			effective = 0;
+	}
+	if (effective > 0)
+		NWL_NodeAttrSetf(node, "Effective Clock (MHz)", NAFLG_FMT_NUMERIC, "%d", effective);
+
+	if (NWLC->CpuMeasure)
+		clock = cpu_clock_measure(200, 1);
+	else if (effective > 0)
+		clock = effective;
+	else if (base > 0)
+		clock = base;
+	else
+		clock = cpu_clock_by_os();
+	NWL_NodeAttrSetf(node, "CPU Clock (MHz)", NAFLG_FMT_NUMERIC, "%d", clock);
+}
+
+static void
+PrintCache(PNODE node, const struct cpu_id_t* data)
+{
+	BOOL saved_human_size;
+	PNODE cache = NWL_NodeAppendNew(node, "Cache", NFLG_ATTGROUP);
 	saved_human_size = NWLC->HumanSize;
 	NWLC->HumanSize = TRUE;
-	if (data.l1_data_cache > 0)
+	if (data->l1_data_cache > 0)
 		NWL_NodeAttrSetf(cache, "L1 D", 0, "%d * %s, %d-way",
-			data.num_cores, NWL_GetHumanSize(data.l1_data_cache, kb_human_sizes, 1024), data.l1_data_assoc);
-	if (data.l1_instruction_cache > 0)
+			data->num_cores, NWL_GetHumanSize(data->l1_data_cache, kb_human_sizes, 1024), data->l1_data_assoc);
+	if (data->l1_instruction_cache > 0)
 		NWL_NodeAttrSetf(cache, "L1 I", 0, "%d * %s, %d-way",
-			data.num_cores, NWL_GetHumanSize(data.l1_instruction_cache, kb_human_sizes, 1024), data.l1_instruction_assoc);
-	if (data.l2_cache > 0)
+			data->num_cores, NWL_GetHumanSize(data->l1_instruction_cache, kb_human_sizes, 1024), data->l1_instruction_assoc);
+	if (data->l2_cache > 0)
 		NWL_NodeAttrSetf(cache, "L2", 0, "%d * %s, %d-way",
-			data.num_cores, NWL_GetHumanSize(data.l2_cache, kb_human_sizes, 1024), data.l2_assoc);
-	if (data.l3_cache > 0)
-		NWL_NodeAttrSetf(cache, "L3", 0, "%s, %d-way", NWL_GetHumanSize(data.l3_cache, kb_human_sizes, 1024), data.l3_assoc);
-	if (data.l4_cache > 0)
-		NWL_NodeAttrSetf(cache, "L4", 0, "%s, %d-way", NWL_GetHumanSize(data.l4_cache, kb_human_sizes, 1024), data.l4_assoc);
+			data->num_cores, NWL_GetHumanSize(data->l2_cache, kb_human_sizes, 1024), data->l2_assoc);
+	if (data->l3_cache > 0)
+		NWL_NodeAttrSetf(cache, "L3", 0, "%s, %d-way", NWL_GetHumanSize(data->l3_cache, kb_human_sizes, 1024), data->l3_assoc);
+	if (data->l4_cache > 0)
+		NWL_NodeAttrSetf(cache, "L4", 0, "%s, %d-way", NWL_GetHumanSize(data->l4_cache, kb_human_sizes, 1024), data->l4_assoc);
 	NWLC->HumanSize = saved_human_size;
+}
+
+// One row per core type (e.g. P-cores and E-cores on hybrid CPUs)
+static void
+PrintCoreTypes(PNODE node, struct system_id_t* system)
+{
+	uint8_t i;
+	int j;
+	char mask[__MASK_SETSIZE + 1];
+	PNODE types = NWL_NodeAppendNew(node, "Core Types", NFLG_TABLE);
+	for (i = 0; i < system->num_cpu_types; i++)
+	{
+		struct cpu_id_t* data = &system->cpu_types[i];
+		PNODE tab = NWL_NodeAppendNew(types, "Core Type", NFLG_TABLE_ROW);
+		NWL_STRBUF sb;
+		NWL_NodeAttrSet(tab, "Purpose", cpu_purpose_str(data->purpose), 0);
+		NWL_NodeAttrSet(tab, "Code Name", data->cpu_codename, 0);
+		NWL_NodeAttrSetf(tab, "Cores", NAFLG_FMT_NUMERIC, "%d", data->num_cores);
+		NWL_NodeAttrSetf(tab, "Logical CPUs", NAFLG_FMT_NUMERIC, "%d", data->num_logical_cpus);
+		NWL_NodeAttrSet(tab, "Affinity Mask",
+			affinity_mask_str_r(&data->affinity_mask, mask, sizeof(mask)), 0);
+		PrintCache(tab, data);
+		NWL_StrBufInit(&sb, NWLC->NwBuf, NWINFO_BUFSZ);
+		for (j = 0; j < NUM_CPU_FEATURES; j++)
+		{
+			if (data->flags[j])
+				NWL_StrBufAppendf(&sb, "%s%s", sb.Len ? " " : "", cpu_feature_str(j));
+		}
+		NWL_NodeAttrSet(tab, "Features", sb.Buf, 0);
+	}
+}
+
+// Binary when the file name ends with ".bin", upstream-compatible text otherwise
+static void
+DumpRawData(struct cpu_raw_data_array_t* raw_array, struct cpu_raw_data_t* raw)
+{
+	size_t len = strlen(NWLC->CpuDump);
+	int ret;
+	if (raw_array->num_raw == 0)
+		ret = cpuid_serialize_raw_data(raw, NWLC->CpuDump);
+	else if (len > 4 && _stricmp(NWLC->CpuDump + len - 4, ".bin") == 0)
+		ret = cpuid_serialize_all_raw_data_binary(raw_array, NWLC->CpuDump);
+	else
+		ret = cpuid_serialize_all_raw_data(raw_array, NWLC->CpuDump);
+	if (ret < 0)
+		fprintf(stderr, "Cannot dump raw CPU data to %s: %s\n", NWLC->CpuDump, cpuid_error());
+}
+
+PNODE NW_Cpuid(VOID)
+{
+	struct cpu_raw_data_array_t raw_array = { 0 };
+	struct system_id_t system = { 0 };
+	struct cpu_raw_data_t raw = { 0 };
+	struct cpu_id_t single = { 0 };
+	struct msr_session_t session = { 0 };
+	const struct cpu_raw_data_t* main_raw = &raw;
+	const struct cpu_id_t* data = &single;
+	int i = 0, cores = 0, logical_cpus = 0;
+	PNODE feature;
+	PNODE node = NWL_NodeAlloc("CPUID", 0);
+	if (NWLC->CpuInfo)
+		NWL_NodeAppendChild(NWLC->NwRoot, node);
+
+	// Identify every core type, fall back to the current CPU only
+	if (NWLC->CpuLoad)
+	{
+		if (cpuid_deserialize_all_raw_data(&raw_array, NWLC->CpuLoad) < 0 || raw_array.num_raw == 0)
+		{
+			fprintf(stderr, "Cannot load raw CPU data from %s: %s\n", NWLC->CpuLoad, cpuid_error());
+			goto out;
+		}
+		if (cpu_identify_all(&raw_array, &system) < 0)
+			fprintf(stderr, "Error identifying the CPU: %s\n", cpuid_error());
+	}
+	else if (cpuid_get_all_raw_data_parallel(&raw_array) >= 0 && raw_array.num_raw > 0)
+	{
+		if (cpu_identify_all(&raw_array, &system) < 0)
+			fprintf(stderr, "Error identifying the CPU: %s\n", cpuid_error());
+	}
+	if (system.num_cpu_types > 0)
+	{
+		main_raw = &raw_array.raw[0];
+		data = &system.cpu_types[0];
+		for (i = 0; i < system.num_cpu_types; i++)
+		{
+			cores += system.cpu_types[i].num_cores;
+			logical_cpus += system.cpu_types[i].num_logical_cpus;
+		}
+	}
+	else if (NWLC->CpuLoad)
+	{
+		raw = raw_array.raw[0];
+		if (cpu_identify(&raw, &single) < 0)
+			fprintf(stderr, "Error identifying the CPU: %s\n", cpuid_error());
+		cores = single.num_cores;
+		logical_cpus = single.num_logical_cpus;
+	}
+	else
+	{
+		if (cpuid_get_raw_data(&raw) < 0)
+		{
+			fprintf(stderr, "Cannot obtain raw CPU data!\n");
+			goto out;
+		}
+		if (cpu_identify(&raw, &single) < 0)
+			fprintf(stderr, "Error identifying the CPU: %s\n", cpuid_error());
+		cores = single.num_cores;
+		logical_cpus = single.num_logical_cpus;
+	}
+
+	if (NWLC->CpuDump)
+		DumpRawData(&raw_array, &raw);
+
+	if (!NWLC->CpuLoad)
+		PrintHypervisor(node);
+	NWL_NodeAttrSet(node, "Vendor", data->vendor_str, 0);
+	NWL_NodeAttrSet(node, "Brand", data->brand_str, 0);
+	NWL_NodeAttrSet(node, "Code Name", data->cpu_codename, 0);
+	NWL_NodeAttrSetf(node, "Family", 0, "%02Xh", data->family);
+	NWL_NodeAttrSetf(node, "Model", 0, "%02Xh", data->model);
+	NWL_NodeAttrSetf(node, "Stepping", 0, "%02Xh", data->stepping);
+	NWL_NodeAttrSetf(node, "Ext.Family", 0, "%02Xh", data->ext_family);
+	NWL_NodeAttrSetf(node, "Ext.Model", 0, "%02Xh", data->ext_model);
+
+	NWL_NodeAttrSetf(node, "Cores", NAFLG_FMT_NUMERIC, "%d", cores);
+	NWL_NodeAttrSetf(node, "Logical CPUs", NAFLG_FMT_NUMERIC, "%d", logical_cpus);
+	NWL_NodeAttrSetf(node, "Total CPUs", NAFLG_FMT_NUMERIC, "%d",
+		NWLC->CpuLoad ? (int)raw_array.num_raw : cpuid_get_total_cpus());
+	NWL_NodeAttrSetBool(node, "Hybrid", system.num_cpu_types > 1, 0);
+	PrintCache(node, data);
 	NWL_NodeAttrSetf(node, "SSE Units", 0, "%d bits (%s)",
-		data.sse_size, data.detection_hints[CPU_HINT_SSE_SIZE_AUTH] ? "authoritative" : "non-authoritative");
+		data->sse_size, data->detection_hints[CPU_HINT_SSE_SIZE_AUTH] ? "authoritative" : "non-authoritative");
 	feature = NWL_NodeAppendNew(node, "Features", NFLG_ATTGROUP);
 	for (i = 0; i < NUM_CPU_FEATURES; i++)
 	{
-		NWL_NodeAttrSetBool(feature, cpu_feature_str(i), data.flags[i], 0);
+		NWL_NodeAttrSetBool(feature, cpu_feature_str(i), data->flags[i], 0);
 	}
+	if (system.num_cpu_types > 0)
+		PrintCoreTypes(node, &system);
 
-	NWL_NodeAttrSetf(node, "CPU Clock (MHz)", NAFLG_FMT_NUMERIC, "%d", cpu_clock_measure(200, 1));
-	PrintSgx(node, &raw, &data);
-	PrintMsr(node);
+	// One APERF/MPERF/TSC window for every clock derived from it
+	if (NWLC->NwDrv && !NWLC->CpuLoad && rdmsr_supported())
+		cpu_msr_session_begin(NWLC->NwDrv, &session, 1);
+	PrintClock(node, main_raw, data, &session);
+	PrintSgx(node, main_raw, data);
+	if (!NWLC->CpuLoad)
+		PrintMsr(node, &session);
+	// Differs from run to run, only printed on request and never for loaded dumps
+	if (NWLC->CpuDebug && !NWLC->CpuLoad)
+		NWL_NodeAttrSetf(node, "CPUID Executed", NAFLG_FMT_NUMERIC, "%ld", cpuid_get_exec_count());
+out:
+	cpuid_free_system_id(&system);
+	cpuid_free_raw_data_array(&raw_array);
 	return node;
 }
+
+#define MONITOR_RING_SIZE 256
+#define MONITOR_MIN_INTERVAL 10
+#define MONITOR_WINDOW 1000
+
+struct monitor_sample
+{
+	int multiplier;
+	int temperature;
+	int voltage;
+	int throttling;
+	int clock;
+};
+
+// Single producer (the sampler pinned to the CPU), single consumer (the main thread).
+// A full ring drops new samples instead of blocking the sampler.
+struct monitor_cpu
+{
+	struct monitor_sample ring[MONITOR_RING_SIZE];
+	volatile LONG head;
+	volatile LONG tail;
+	volatile LONG dropped;
+	DWORD cpu;
+	GROUP_AFFINITY affinity;
+	HANDLE thread;
+	struct monitor_t* mon;
+	// Sampler cost, read by the main thread only
+	ULONG64 cycles;
+	ULONGLONG ticks;
+};
+
+struct monitor_t
+{
+	HANDLE stop;
+	DWORD interval;
+	double base;
+	BOOL aperf;
+};
+
+struct monitor_stat
+{
+	int min;
+	int max;
+	double sum;
+	int count;
+};
+
+static HANDLE monitor_stop;
+
+static BOOL WINAPI
+MonitorCtrlHandler(DWORD dwCtrlType)
+{
+	(void)dwCtrlType;
+	SetEvent(monitor_stop);
+	return TRUE;
+}
+
+static DWORD WINAPI
+MonitorThread(LPVOID lpParameter)
+{
+	struct monitor_cpu* cpu = lpParameter;
+	struct monitor_t* mon = cpu->mon;
+	uint64_t p0[2] = { 0 }, p1[2];
+	BOOL first = TRUE;
+
+	if (!SetThreadGroupAffinity(GetCurrentThread(), &cpu->affinity, NULL))
+		return 1;
+	do
+	{
+		struct monitor_sample sample;
+		LONG head = cpu->head;
+		sample.multiplier = cpu_msrinfo(NWLC->NwDrv, INFO_CUR_MULTIPLIER);
+		sample.temperature = cpu_msrinfo(NWLC->NwDrv, INFO_TEMPERATURE);
+		sample.voltage = cpu_msrinfo(NWLC->NwDrv, INFO_VOLTAGE);
+		sample.throttling = cpu_msrinfo(NWLC->NwDrv, INFO_THROTTLING);
+		sample.clock = 0;
+		// MPERF only counts in C0, so the ratio is the average clock while busy
+		if (mon->aperf && cpu_rdmsr_batch(NWLC->NwDrv, -1, perf_msrs, p1, NULL, 2) == 2)
+		{
+			if (!first && p1[0] > p0[0] && p1[1] > p0[1])
+				sample.clock = (int)((double)(p1[1] - p0[1]) * mon->base / (double)(p1[0] - p0[0]));
+			p0[0] = p1[0];
+			p0[1] = p1[1];
+			first = FALSE;
+		}
+		if (head - cpu->tail >= MONITOR_RING_SIZE)
+			InterlockedIncrement(&cpu->dropped);
+		else
+		{
+			cpu->ring[head & (MONITOR_RING_SIZE - 1)] = sample;
+			InterlockedExchange(&cpu->head, head + 1);
+		}
+	} while (WaitForSingleObject(mon->stop, mon->interval) == WAIT_TIMEOUT);
+	return 0;
+}
+
+static void
+StatAdd(struct monitor_stat* stat, int value)
+{
+	if (value == CPU_INVALID_VALUE || value <= 0)
+		return;
+	if (stat->count == 0 || value < stat->min)
+		stat->min = value;
+	if (stat->count == 0 || value > stat->max)
+		stat->max = value;
+	stat->sum += value;
+	stat->count++;
+}
+
+static void
+PrintStat(PNODE node, LPCSTR name, const struct monitor_stat* stat, double scale, LPCSTR fmt)
+{
+	PNODE group;
+	if (stat->count == 0)
+		return;
+	group = NWL_NodeAppendNew(node, name, NFLG_ATTGROUP);
+	NWL_NodeAttrSetf(group, "Min", NAFLG_FMT_NUMERIC, fmt, stat->min / scale);
+	NWL_NodeAttrSetf(group, "Avg", NAFLG_FMT_NUMERIC, fmt, stat->sum / stat->count / scale);
+	NWL_NodeAttrSetf(group, "Max", NAFLG_FMT_NUMERIC, fmt, stat->max / scale);
+}
+
+// Cycles the sampler thread ran since the last window, relative to the TSC rate
+static void
+PrintMonitorLoad(PNODE row, struct monitor_cpu* cpu)
+{
+	ULONG64 cycles;
+	ULONGLONG ticks = GetTickCount64();
+	if (!QueryThreadCycleTime(cpu->thread, &cycles))
+		return;
+	if (cpu->mon->base > 0.0 && ticks > cpu->ticks)
+		NWL_NodeAttrSetf(row, "Sampler Load (%)", NAFLG_FMT_NUMERIC, "%.3lf",
+			(double)(cycles - cpu->cycles) / (cpu->mon->base * 1000.0 * (double)(ticks - cpu->ticks)) * 100.0);
+	cpu->cycles = cycles;
+	cpu->ticks = ticks;
+}
+
+static void
+PrintMonitorCpu(PNODE table, struct monitor_cpu* cpu)
+{
+	struct monitor_stat clock = { 0 }, multi = { 0 }, temp = { 0 }, volt = { 0 };
+	LONG head = cpu->head;
+	LONG tail = cpu->tail;
+	LONG dropped = InterlockedExchange(&cpu->dropped, 0);
+	int samples = 0, throttled = 0;
+	PNODE row = NWL_NodeAppendNew(table, "CPU", NFLG_TABLE_ROW);
+
+	MemoryBarrier();
+	for (; tail != head; tail++)
+	{
+		const struct monitor_sample* s = &cpu->ring[tail & (MONITOR_RING_SIZE - 1)];
+		StatAdd(&clock, s->clock);
+		StatAdd(&multi, s->multiplier);
+		StatAdd(&temp, s->temperature);
+		StatAdd(&volt, s->voltage);
+		if (s->throttling != CPU_INVALID_VALUE && s->throttling > 0)
+			throttled++;
+		samples++;
+	}
+	InterlockedExchange(&cpu->tail, tail);
+
+	NWL_NodeAttrSetf(row, "CPU", NAFLG_FMT_NUMERIC, "%lu", cpu->cpu);
+	NWL_NodeAttrSetf(row, "Samples", NAFLG_FMT_NUMERIC, "%d", samples);
+	NWL_NodeAttrSetf(row, "Dropped", NAFLG_FMT_NUMERIC, "%ld", dropped);
+	PrintStat(row, "Effective Clock (MHz)", &clock, 1.0, "%.0lf");
+	PrintStat(row, "Multiplier", &multi, 100.0, "%.1lf");
+	PrintStat(row, "Temperature (C)", &temp, 1.0, "%.1lf");
+	PrintStat(row, "Voltage (V)", &volt, 100.0, "%.2lf");
+	NWL_NodeAttrSetf(row, "Throttled Samples", NAFLG_FMT_NUMERIC, "%d", throttled);
+	PrintMonitorLoad(row, cpu);
+}
+
+// Stream per-core min/avg/max every second until Ctrl+C.
+// WinRing0 can only read MSRs on the calling CPU, so one sampler thread is pinned to each CPU.
+VOID NW_Monitor(DWORD dwInterval)
+{
+	struct cpu_raw_data_t raw = { 0 };
+	struct cpu_id_t data = { 0 };
+	struct monitor_t mon = { 0 };
+	struct msr_session_t session = { 0 };
+	struct monitor_cpu* cpus = NULL;
+	DWORD i, count = 0, window = 0;
+
+	if (NWLC->NwFile == NULL)
+		return;
+	if (NWLC->NwDrv == NULL)
+	{
+		fprintf(stderr, "Cannot load driver!\n");
+		return;
+	}
+	if (!rdmsr_supported())
+	{
+		fprintf(stderr, "rdmsr not supported\n");
+		return;
+	}
+	if (cpuid_get_raw_data(&raw) < 0 || cpu_identify(&raw, &data) < 0)
+	{
+		fprintf(stderr, "Error identifying the CPU: %s\n", cpuid_error());
+		return;
+	}
+	// cpu_msrinfo initializes itself on first use, do it before the samplers start
+	cpu_msrinfo(NWLC->NwDrv, INFO_CUR_MULTIPLIER);
+
+	mon.interval = dwInterval < MONITOR_MIN_INTERVAL ? MONITOR_MIN_INTERVAL : dwInterval;
+	// MPERF ticks at the TSC rate, the same reference INFO_EFFECTIVE_CLOCK uses
+	if (cpu_msr_session_begin(NWLC->NwDrv, &session, 10) == 0 && session.mark.sys_clock > 0)
+		mon.base = (double)session.mark.tsc / (double)session.mark.sys_clock;
+	mon.aperf = mon.base > 0.0 && raw.basic_cpuid[0][EAX] >= 6 && (raw.basic_cpuid[6][ECX] & 0x01);
+	mon.stop = monitor_stop = CreateEventW(NULL, TRUE, FALSE, NULL);
+	if (mon.stop == NULL)
+		return;
+
+	count = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+	cpus = calloc(count, sizeof(struct monitor_cpu));
+	if (cpus == NULL)
+		goto out;
+	for (i = 0; i < count; i++)
+	{
+		cpus[i].cpu = i;
+		cpus[i].mon = &mon;
+		cpus[i].ticks = GetTickCount64();
+		if (cpuid_get_cpu_group_affinity((logical_cpu_t)i, &cpus[i].affinity))
+			cpus[i].thread = CreateThread(NULL, 64 * 1024, MonitorThread, &cpus[i],
+				STACK_SIZE_PARAM_IS_A_RESERVATION, NULL);
+	}
+	SetConsoleCtrlHandler(MonitorCtrlHandler, TRUE);
+
+	while (WaitForSingleObject(mon.stop, mon.interval > MONITOR_WINDOW ? mon.interval : MONITOR_WINDOW) == WAIT_TIMEOUT)
+	{
+		PNODE node = NWL_NodeAlloc("Monitor", 0);
+		PNODE table;
+		NWL_NodeAttrSetf(node, "Window", NAFLG_FMT_NUMERIC, "%lu", ++window);
+		NWL_NodeAttrSetf(node, "Interval (ms)", NAFLG_FMT_NUMERIC, "%lu", mon.interval);
+		table = NWL_NodeAppendNew(node, "CPUs", NFLG_TABLE);
+		for (i = 0; i < count; i++)
+		{
+			if (cpus[i].thread)
+				PrintMonitorCpu(table, &cpus[i]);
+		}
+		NWL_NodeToFormat(node, NWLC->NwFile, NWLC->NwFormat, 0);
+		fprintf(NWLC->NwFile, "\n");
+		fflush(NWLC->NwFile);
+		NWL_NodeFree(node, 1);
+	}
+
+	SetConsoleCtrlHandler(MonitorCtrlHandler, FALSE);
+	for (i = 0; i < count; i++)
+	{
+		if (cpus[i].thread == NULL)
+			continue;
+		WaitForSingleObject(cpus[i].thread, INFINITE);
+		CloseHandle(cpus[i].thread);
+	}
+out:
+	free(cpus);
+	CloseHandle(mon.stop);
+	monitor_stop = NULL;
+}
@@ -518,3 +518,17 @@ INT NWL_NodeToLua(PNODE node, FILE* file, INT flags)
 	fprintf(file, "}");
 	return nodes;
 }
+
+INT NWL_NodeToFormat(PNODE node, FILE* file, INT format, INT flags)
+{
+	switch (format)
+	{
+	case FORMAT_YAML:
+		return NWL_NodeToYaml(node, file, flags);
+	case FORMAT_JSON:
+		return NWL_NodeToJson(node, file, flags);
+	case FORMAT_LUA:
+		return NWL_NodeToLua(node, file, flags);
+	}
+	return 0;
+}
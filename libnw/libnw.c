@@ -22,7 +22,7 @@ BOOL NW_Init(PNWLIB_CONTEXT pContext)
 	NWLC = pContext;
 	NWLC->NwFile = stdout;
 	NWLC->AcpiTable = 0;
-	NWLC->SmbiosType = 127;
+	NWLC->SmbiosType = NULL;
 	NWLC->NwRoot = NWL_NodeAlloc("NWinfo", 0);
 	NWLC->NwDrv = cpu_msr_driver_open();
 	NWLC->NwRsdp = NWL_GetRsdp();
@@ -62,22 +62,14 @@ VOID NW_Print(LPCSTR lpFileName)
 		NW_Usb();
 	if (NWLC->BatteryInfo)
 		NW_Battery();
-	switch (NWLC->NwFormat)
-	{
-	case FORMAT_YAML:
-		NWL_NodeToYaml(NWLC->NwRoot, NWLC->NwFile, 0);
-		break;
-	case FORMAT_JSON:
-		NWL_NodeToJson(NWLC->NwRoot, NWLC->NwFile, 0);
-		break;
-	case FORMAT_LUA:
-		NWL_NodeToLua(NWLC->NwRoot, NWLC->NwFile, 0);
-		break;
-	}
+	if (NWLC->TscInfo)
+		NW_Tsc();
+	NWL_NodeToFormat(NWLC->NwRoot, NWLC->NwFile, NWLC->NwFormat, 0);
 }
 
 VOID NW_Fini(VOID)
 {
+	NWL_FreeAcpiDir();
 	if (NWLC->NwRsdp)
 		free(NWLC->NwRsdp);
 	if (NWLC->NwRsdt)
@@ -16,6 +16,7 @@ struct msr_driver_t;
 struct acpi_rsdp_v2;
 struct acpi_rsdt;
 struct acpi_xsdt;
+struct acpi_dir;
 
 typedef struct _NWLIB_CONTEXT
 {
@@ -32,15 +33,21 @@ typedef struct _NWLIB_CONTEXT
 	BOOL UsbInfo;
 	BOOL SpdInfo;
 	BOOL BatteryInfo;
+	BOOL TscInfo;
 
 	DWORD AcpiTable;
 	BOOL ActiveNet;
-	UINT8 SmbiosType;
+	BOOL CpuMeasure;
+	BOOL CpuDebug;
+	LPCSTR CpuDump;
+	LPCSTR CpuLoad;
+	LPCSTR SmbiosType;
 	LPCSTR PciClass;
 
 	struct acpi_rsdp_v2* NwRsdp;
 	struct acpi_rsdt* NwRsdt;
 	struct acpi_xsdt* NwXsdt;
+	struct acpi_dir* NwAcpiDir;
 
 	struct msr_driver_t* NwDrv;
 	struct _NODE* NwRoot;
@@ -61,6 +68,7 @@ VOID NW_Print(LPCSTR lpFileName);
 VOID NW_Fini(VOID);
 
 VOID NW_Beep(int argc, char* argv[]);
+VOID NW_Monitor(DWORD dwInterval);
 
 PNODE NW_Acpi(VOID);
 PNODE NW_Cpuid(VOID);
@@ -73,6 +81,7 @@ PNODE NW_Spd(VOID);
 PNODE NW_System(VOID);
 PNODE NW_Usb(VOID);
 PNODE NW_Battery(VOID);
+PNODE NW_Tsc(VOID);
 
 #ifdef __cplusplus
 } /* extern "C" */
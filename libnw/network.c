@@ -127,13 +127,10 @@ PNODE NW_Network (VOID)
 		NWL_NodeAttrSet(nic, "Type", IfTypeToStr(pCurrAddresses->IfType), 0);
 		if (pCurrAddresses->PhysicalAddressLength != 0)
 		{
-			NWLC->NwBuf[0] = '\0';
-			for (i = 0; i < pCurrAddresses->PhysicalAddressLength; i++)
-			{
-				snprintf(NWLC->NwBuf, NWINFO_BUFSZ, "%s%.2X%s", NWLC->NwBuf,
-					pCurrAddresses->PhysicalAddress[i], (i == (pCurrAddresses->PhysicalAddressLength - 1)) ? "" : "-");
-			}
-			NWL_NodeAttrSet(nic, "MAC Address", NWLC->NwBuf, 0);
+			NWL_STRBUF sb;
+			NWL_StrBufInit(&sb, NWLC->NwBuf, NWINFO_BUFSZ);
+			NWL_StrBufAppendHex(&sb, pCurrAddresses->PhysicalAddress, pCurrAddresses->PhysicalAddressLength, "-");
+			NWL_NodeAttrSet(nic, "MAC Address", sb.Buf, 0);
 		}
 
 		NWL_NodeAttrSet(nic, "Status", (pCurrAddresses->OperStatus == IfOperStatusUp) ? "Active" : "Deactive", 0);
@@ -7,14 +7,13 @@
 static const char* mem_human_sizes[6] =
 { "B", "KB", "MB", "GB", "TB", "PB", };
 
-static const char* LocateString(const char* str, UINT i)
+static const char* LocateString(PSMBIOS_ENTRY e, UINT i)
 {
-	static const char nul[] = "NULL";
-	if (0 == i || 0 == *str)
-		return nul;
-	while (--i)
-		str += strlen((char*)str) + 1;
-	return str;
+	if (0 == i)
+		return "NULL";
+	if (i > e->StrCount)
+		return "BAD INDEX";
+	return e->Strings + e->StrOffsets[i - 1];
 }
 
 static const char* toPointString(void* p)
@@ -22,27 +21,155 @@ static const char* toPointString(void* p)
 	return (char*)p + ((PSMBIOSHEADER)p)->Length;
 }
 
-static void ProcBIOSInfo(PNODE tab, void* p)
+static PSMBIOS_INDEX smbios_index;
+
+static UINT32 HashHandle(WORD Handle, UINT32 Mask)
 {
-	PBIOSInfo pBIOS = (PBIOSInfo)p;
-	const char* str = toPointString(p);
-	NWL_NodeAttrSet(tab, "Description", "BIOS Information", 0);
-	if (pBIOS->Header.Length < 0x12) // 2.0
-		return;
-	NWL_NodeAttrSet(tab, "Vendor", LocateString(str, pBIOS->Vendor), 0);
-	NWL_NodeAttrSet(tab, "Version", LocateString(str, pBIOS->Version), 0);
-	NWL_NodeAttrSetf(tab, "Starting Segment", 0, "%04Xh", pBIOS->StartingAddrSeg);
-	NWL_NodeAttrSet(tab, "Release Date", LocateString(str, pBIOS->ReleaseDate), 0);
-	NWL_NodeAttrSetf(tab, "Image Size (K)", NAFLG_FMT_NUMERIC, "%u", (pBIOS->ROMSize + 1) * 64);
-	NWL_NodeAttrSetf(tab, "BIOS Characteristics", 0, "0x%016llX", pBIOS->Characteristics);
-	if (pBIOS->Header.Length < 0x18) // 2.4
-		return;
-	if (pBIOS->MajorRelease != 0xff || pBIOS->MinorRelease != 0xff)
-		NWL_NodeAttrSetf(tab, "System BIOS Version", 0, "%u.%u", pBIOS->MajorRelease, pBIOS->MinorRelease);
-	if (pBIOS->ECFirmwareMajor != 0xff || pBIOS->ECFirmwareMinor != 0xff)
-		NWL_NodeAttrSetf(tab, "EC Firmware Version", 0, "%u.%u", pBIOS->ECFirmwareMajor, pBIOS->ECFirmwareMinor);
+	return (Handle * 2654435761U) & Mask;
+}
+
+static BOOL SmbiosIndexAppend(PSMBIOS_INDEX idx, PSMBIOSHEADER pHeader, UINT32 StrFirst)
+{
+	UINT32 i = idx->Count;
+	if (idx->Count >= idx->Capacity)
+	{
+		UINT32 cap = idx->Capacity ? idx->Capacity * 2 : 64;
+		PSMBIOS_ENTRY entries = realloc(idx->Entries, cap * sizeof(SMBIOS_ENTRY));
+		if (!entries)
+			return FALSE;
+		idx->Entries = entries;
+		idx->Capacity = cap;
+	}
+	idx->Entries[i].Header = pHeader;
+	idx->Entries[i].Strings = toPointString(pHeader);
+	idx->Entries[i].StrOffsets = NULL;
+	idx->Entries[i].StrFirst = StrFirst;
+	idx->Entries[i].StrCount = idx->StrPoolCount - StrFirst;
+	idx->Entries[i].NextOfType = SMBIOS_INDEX_NONE;
+	if (idx->TypeLast[pHeader->Type] == SMBIOS_INDEX_NONE)
+		idx->TypeFirst[pHeader->Type] = i;
+	else
+		idx->Entries[idx->TypeLast[pHeader->Type]].NextOfType = i;
+	idx->TypeLast[pHeader->Type] = i;
+	idx->Count++;
+	return TRUE;
+}
+
+static BOOL SmbiosIndexAddString(PSMBIOS_INDEX idx, UINT32 Offset)
+{
+	if (idx->StrPoolCount >= idx->StrPoolCapacity)
+	{
+		UINT32 cap = idx->StrPoolCapacity ? idx->StrPoolCapacity * 2 : 256;
+		UINT32* pool = realloc(idx->StrPool, cap * sizeof(UINT32));
+		if (!pool)
+			return FALSE;
+		idx->StrPool = pool;
+		idx->StrPoolCapacity = cap;
+	}
+	idx->StrPool[idx->StrPoolCount++] = Offset;
+	return TRUE;
+}
+
+static VOID SmbiosIndexFree(PSMBIOS_INDEX idx)
+{
+	free(idx->Entries);
+	free(idx->Hash);
+	free(idx->StrPool);
+	ZeroMemory(idx, sizeof(SMBIOS_INDEX));
+}
+
+static BOOL SmbiosIndexBuild(PSMBIOS_INDEX idx, LPBYTE Addr, UINT Len)
+{
+	LPBYTE p = Addr;
+	LPBYTE lastAddress = Addr + Len;
+	UINT32 i, size;
+
+	ZeroMemory(idx, sizeof(SMBIOS_INDEX));
+	memset(idx->TypeFirst, 0xFF, sizeof(idx->TypeFirst));
+	memset(idx->TypeLast, 0xFF, sizeof(idx->TypeLast));
+
+	while (p + sizeof(SMBIOSHEADER) <= lastAddress)
+	{
+		PSMBIOSHEADER pHeader = (PSMBIOSHEADER)p;
+		LPBYTE str = p + pHeader->Length; // point to struct end
+		LPBYTE nt = str;
+		UINT32 first = idx->StrPoolCount;
+		if (pHeader->Length < sizeof(SMBIOSHEADER) || nt + 1 >= lastAddress)
+			break;
+		// record string offsets while skipping the string area
+		while (nt < lastAddress && *nt)
+		{
+			if (!SmbiosIndexAddString(idx, (UINT32)(nt - str)))
+				goto fail;
+			while (nt < lastAddress && *nt)
+				nt++;
+			nt++;
+		}
+		if (nt >= lastAddress)
+			break; // string area not terminated
+		if (!SmbiosIndexAppend(idx, pHeader, first))
+			goto fail;
+		if ((pHeader->Type == 127) && (pHeader->Length == 4))
+			break; // last avaiable tables
+		p = (nt == str) ? nt + 2 : nt + 1;
+	}
+
+	for (i = 0; i < idx->Count; i++)
+		idx->Entries[i].StrOffsets = idx->StrPool + idx->Entries[i].StrFirst;
+
+	for (size = 16; size < idx->Count * 2; size <<= 1)
+		;
+	idx->Hash = malloc(size * sizeof(UINT32));
+	if (!idx->Hash)
+		goto fail;
+	memset(idx->Hash, 0xFF, size * sizeof(UINT32));
+	idx->HashMask = size - 1;
+	for (i = 0; i < idx->Count; i++)
+	{
+		WORD handle = idx->Entries[i].Header->Handle;
+		UINT32 h = HashHandle(handle, idx->HashMask);
+		while (idx->Hash[h] != SMBIOS_INDEX_NONE)
+		{
+			if (idx->Entries[idx->Hash[h]].Header->Handle == handle)
+				break; // keep the first structure with a duplicate handle
+			h = (h + 1) & idx->HashMask;
+		}
+		if (idx->Hash[h] == SMBIOS_INDEX_NONE)
+			idx->Hash[h] = i;
+	}
+	return TRUE;
+fail:
+	SmbiosIndexFree(idx);
+	return FALSE;
+}
+
+static PSMBIOS_ENTRY SmbiosIndexFindHandle(PSMBIOS_INDEX idx, WORD Handle)
+{
+	UINT32 h;
+	if (!idx || !idx->Hash)
+		return NULL;
+	for (h = HashHandle(Handle, idx->HashMask); idx->Hash[h] != SMBIOS_INDEX_NONE; h = (h + 1) & idx->HashMask)
+	{
+		if (idx->Entries[idx->Hash[h]].Header->Handle == Handle)
+			return &idx->Entries[idx->Hash[h]];
+	}
+	return NULL;
 }
 
+// Follow a handle reference to a structure of the given type.
+// 0xFFFF means "not provided" and 0xFFFE "no error detected" in most fields.
+static PSMBIOS_ENTRY ResolveHandle(WORD Handle, UINT8 Type)
+{
+	PSMBIOS_ENTRY entry;
+	if (Handle >= 0xFFFE)
+		return NULL;
+	entry = SmbiosIndexFindHandle(smbios_index, Handle);
+	if (!entry || entry->Header->Type != Type)
+		return NULL;
+	return entry;
+}
+
+
 static const CHAR*
 pWakeUpTypeToStr(UCHAR Type)
 {
@@ -60,27 +187,6 @@ pWakeUpTypeToStr(UCHAR Type)
 	return "Unknown";
 }
 
-static void ProcSysInfo(PNODE tab, void* p)
-{
-	PSystemInfo pSystem = (PSystemInfo)p;
-	const char* str = toPointString(p);
-	NWL_NodeAttrSet(tab, "Description", "System Information", 0);
-	if (pSystem->Header.Length < 0x08) // 2.0
-		return;
-	NWL_NodeAttrSet(tab, "Manufacturer", LocateString(str, pSystem->Manufacturer), 0);
-	NWL_NodeAttrSet(tab, "Product Name", LocateString(str, pSystem->ProductName), 0);
-	NWL_NodeAttrSet(tab, "Version", LocateString(str, pSystem->Version), 0);
-	NWL_NodeAttrSet(tab, "Serial Number", LocateString(str, pSystem->SN), 0);
-	if (pSystem->Header.Length < 0x19) // 2.1
-		return;
-	NWL_NodeAttrSet(tab, "UUID", NWL_GuidToStr(pSystem->UUID), NAFLG_FMT_GUID);
-	NWL_NodeAttrSet(tab, "Wake-up Type", pWakeUpTypeToStr(pSystem->WakeUpType), 0);
-	if (pSystem->Header.Length < 0x1b) // 2.4
-		return;
-	NWL_NodeAttrSet(tab, "SKU Number", LocateString(str, pSystem->SKUNumber), 0);
-	NWL_NodeAttrSet(tab, "Family", LocateString(str, pSystem->Family), 0);
-}
-
 static const CHAR*
 pBoardTypeToStr(UCHAR Type)
 {
@@ -102,34 +208,6 @@ pBoardTypeToStr(UCHAR Type)
 	return "Unknown";
 }
 
-static void ProcBoardInfo(PNODE tab, void* p)
-{
-	PBoardInfo pBoard = (PBoardInfo)p;
-	const char* str = toPointString(p);
-	NWL_NodeAttrSet(tab, "Description", "Base Board Information", 0);
-	if (pBoard->Header.Length < 0x08)
-		return;
-	NWL_NodeAttrSet(tab, "Manufacturer", LocateString(str, pBoard->Manufacturer), 0);
-	NWL_NodeAttrSet(tab, "Product Name", LocateString(str, pBoard->Product), 0);
-	NWL_NodeAttrSet(tab, "Version", LocateString(str, pBoard->Version), 0);
-	NWL_NodeAttrSet(tab, "Serial Number", LocateString(str, pBoard->SN), 0);
-	if (pBoard->Header.Length < 0x09)
-		return;
-	NWL_NodeAttrSet(tab, "Asset Tag", LocateString(str, pBoard->AssetTag), 0);
-	if (pBoard->Header.Length < 0x0a)
-		return;
-	NWL_NodeAttrSetf(tab, "Feature Flags", 0, "0x%02X", pBoard->FeatureFlags);
-	if (pBoard->Header.Length < 0x0b)
-		return;
-	NWL_NodeAttrSet(tab, "Location in Chassis", LocateString(str, pBoard->LocationInChassis), 0);
-	if (pBoard->Header.Length < 0x0d)
-		return;
-	NWL_NodeAttrSetf(tab, "Chassis Handle", NAFLG_FMT_NUMERIC, "%u", pBoard->ChassisHandle);
-	if (pBoard->Header.Length < 0x0e)
-		return;
-	NWL_NodeAttrSet(tab, "Board Type", pBoardTypeToStr(pBoard->Type), 0);
-}
-
 static const CHAR*
 pSystemEnclosureTypeToStr(UCHAR Type)
 {
@@ -201,31 +279,6 @@ pSecurityStatusToStr(UCHAR State)
 	return "Unknown";
 }
 
-static void ProcSystemEnclosure(PNODE tab, void* p)
-{
-	PSystemEnclosure pSysEnclosure = (PSystemEnclosure)p;
-	const char* str = toPointString(p);
-	NWL_NodeAttrSet(tab, "Description", "System Enclosure Information", 0);
-	if (pSysEnclosure->Header.Length < 0x09) // 2.0
-		return;
-	NWL_NodeAttrSetf(tab, "Type", 0, "%s%s",
-		(pSysEnclosure->Type & 0x80) ? "[LOCK]" : "",
-		pSystemEnclosureTypeToStr(pSysEnclosure->Type));
-	NWL_NodeAttrSet(tab, "Manufacturer", LocateString(str, pSysEnclosure->Manufacturer), 0);
-	NWL_NodeAttrSet(tab, "Version", LocateString(str, pSysEnclosure->Version), 0);
-	NWL_NodeAttrSet(tab, "Serial Number", LocateString(str, pSysEnclosure->SN), 0);
-	NWL_NodeAttrSet(tab, "Asset Tag", LocateString(str, pSysEnclosure->AssetTag), 0);
-	if (pSysEnclosure->Header.Length < 0x0d) // 2.1
-		return;
-	NWL_NodeAttrSet(tab, "Boot-up State", pBootUpStateToStr(pSysEnclosure->BootupState), 0);
-	NWL_NodeAttrSet(tab, "Power Supply State", pBootUpStateToStr(pSysEnclosure->PowerSupplyState), 0);
-	NWL_NodeAttrSet(tab, "Thermal State", pBootUpStateToStr(pSysEnclosure->ThermalState), 0);
-	NWL_NodeAttrSet(tab, "Security Status", pSecurityStatusToStr(pSysEnclosure->SecurityStatus), 0);
-	if (pSysEnclosure->Header.Length < 0x15) // 2.3
-		return;
-	NWL_NodeAttrSetf(tab, "OEM-defined", NAFLG_FMT_NUMERIC, "%u", pSysEnclosure->OEMDefine);
-}
-
 static const CHAR*
 pProcessorTypeToStr(UCHAR Type)
 {
@@ -419,92 +472,9 @@ pProcessorFamilyToStr(UCHAR Family)
 	return "Unknown";
 }
 
-static void ProcProcessorInfo(PNODE tab, void* p)
-{
-	PProcessorInfo	pProcessor = (PProcessorInfo)p;
-	const char* str = toPointString(p);
-	NWL_NodeAttrSet(tab, "Description", "Processor Information", 0);
-	if (pProcessor->Header.Length < 0x1a) // 2.0
-		return;
-	NWL_NodeAttrSet(tab, "Socket Designation", LocateString(str, pProcessor->SocketDesignation), 0);
-	NWL_NodeAttrSet(tab, "Type", pProcessorTypeToStr(pProcessor->Type), 0);
-	NWL_NodeAttrSet(tab, "Processor Family", pProcessorFamilyToStr(pProcessor->Family), 0);
-	NWL_NodeAttrSet(tab, "Processor Manufacturer", LocateString(str, pProcessor->Manufacturer), 0);
-	NWL_NodeAttrSet(tab, "Processor Version", LocateString(str, pProcessor->Version), 0);
-	if (!pProcessor->Voltage)
-	{
-		// unsupported
-	}
-	else if (pProcessor->Voltage & (1U << 7))
-	{
-		UCHAR volt = pProcessor->Voltage - 0x80;
-		NWL_NodeAttrSetf(tab, "Voltage", 0, "%u.%u V", volt / 10, volt % 10);
-	}
-	else
-	{
-		NWL_NodeAttrSetf(tab, "Voltage", 0, "%s%s%s",
-			pProcessor->Voltage & (1U << 0) ? " 5 V" : "",
-			pProcessor->Voltage & (1U << 1) ? " 3.3 V" : "",
-			pProcessor->Voltage & (1U << 2) ? " 2.9 V" : "");
-	}
-	if (pProcessor->ExtClock)
-		NWL_NodeAttrSetf(tab, "External Clock (MHz)", NAFLG_FMT_NUMERIC, "%u", pProcessor->ExtClock);
-	NWL_NodeAttrSetf(tab, "Max Speed (MHz)", NAFLG_FMT_NUMERIC, "%u", pProcessor->MaxSpeed);
-	NWL_NodeAttrSetf(tab, "Current Speed (MHz)", NAFLG_FMT_NUMERIC, "%u", pProcessor->CurrentSpeed);
-	if (pProcessor->Header.Length < 0x20) // 2.1
-		return;
-	if (pProcessor->Header.Length < 0x23) // 2.3
-		return;
-	NWL_NodeAttrSet(tab, "Serial Number", LocateString(str, pProcessor->Serial), 0);
-	NWL_NodeAttrSet(tab, "Asset Tag", LocateString(str, pProcessor->AssetTag), 0);
-	NWL_NodeAttrSet(tab, "Part Number", LocateString(str, pProcessor->PartNum), 0);
-	if (pProcessor->Header.Length < 0x28) // 2.5
-		return;
-	if (pProcessor->CoreCount == 0xff && pProcessor->Header.Length > 0x2a)
-		NWL_NodeAttrSetf(tab, "Core Count", NAFLG_FMT_NUMERIC, "%u", pProcessor->CoreCount2);
-	else
-		NWL_NodeAttrSetf(tab, "Core Count", NAFLG_FMT_NUMERIC, "%u", pProcessor->CoreCount);
-	if (pProcessor->CoreEnabled == 0xff && pProcessor->Header.Length > 0x2c)
-		NWL_NodeAttrSetf(tab, "Core Enabled", NAFLG_FMT_NUMERIC, "%u", pProcessor->CoreEnabled2);
-	else
-		NWL_NodeAttrSetf(tab, "Core Enabled", NAFLG_FMT_NUMERIC, "%u", pProcessor->CoreEnabled);
-	if (pProcessor->ThreadCount == 0xff && pProcessor->Header.Length > 0x2a)
-		NWL_NodeAttrSetf(tab, "Thread Count", NAFLG_FMT_NUMERIC, "%u", pProcessor->ThreadCount2);
-	else
-		NWL_NodeAttrSetf(tab, "Thread Count", NAFLG_FMT_NUMERIC, "%u", pProcessor->ThreadCount);
-	NWL_NodeAttrSetf(tab, "Processor Characteristics", 0, "0x%04X", pProcessor->ProcessorChar);
-}
-
-static void ProcMemCtrlInfo(PNODE tab, void* p)
-{
-	PMemCtrlInfo pMemCtrl = (PMemCtrlInfo)p;
-	NWL_NodeAttrSet(tab, "Description", "Memory Controller Information", 0);
-	if (pMemCtrl->Header.Length < 0x15) // 2.0
-		return;
-	NWL_NodeAttrSetf(tab, "Max Memory Module Size (MB)", NAFLG_FMT_NUMERIC, "%llu", 2ULL << pMemCtrl->MaxMemModuleSize);
-	NWL_NodeAttrSetf(tab, "Number of Slots", NAFLG_FMT_NUMERIC, "%u", pMemCtrl->NumOfSlots);
-}
-
-static void ProcMemModuleInfo(PNODE tab, void* p)
-{
-	PMemModuleInfo	pMemModule = (PMemModuleInfo)p;
-	const char* str = toPointString(p);
-	UCHAR sz = 0;
-	NWL_NodeAttrSet(tab, "Description", "Memory Module Information", 0);
-	if (pMemModule->Header.Length < 0x0c)
-		return;
-	NWL_NodeAttrSet(tab, "Socket Designation", LocateString(str, pMemModule->SocketDesignation), 0);
-	NWL_NodeAttrSetf(tab, "Current Speed (ns)", NAFLG_FMT_NUMERIC, "%u", pMemModule->CurrentSpeed);
-	sz = pMemModule->InstalledSize & 0x7F;
-	if (sz > 0x7D)
-		sz = 0;
-	NWL_NodeAttrSetf(tab, "Installed Size (MB)", NAFLG_FMT_NUMERIC, "%llu", 2ULL << sz);
-}
-
 static const CHAR*
-pCacheConfToOpMode(UINT16 Conf)
+pCacheOpModeToStr(UCHAR OpMode)
 {
-	UINT16 OpMode = (Conf & 0x300) >> 8;
 	switch (OpMode)
 	{
 	case 0x00: return "Write Through";
@@ -515,10 +485,9 @@ pCacheConfToOpMode(UINT16 Conf)
 }
 
 static const CHAR*
-pCacheConfToLocation(UINT16 Conf)
+pCacheLocationToStr(UCHAR Location)
 {
-	UINT16 OpMode = (Conf & 0x60) >> 5;
-	switch (OpMode)
+	switch (Location)
 	{
 	case 0x00: return "Internal";
 	case 0x01: return "External";
@@ -527,25 +496,6 @@ pCacheConfToLocation(UINT16 Conf)
 	return "Unknown";
 }
 
-static void
-pCacheSetSRAMType(PNODE tab, LPCSTR key, UINT16 value)
-{
-	size_t len;
-	char str[64];
-	snprintf(str, sizeof(str), "%s%s%s%s%s",
-		value & (1 << 2) ? "Non-Burst," : "",
-		value & (1 << 3) ? "Burst," : "",
-		value & (1 << 4) ? "Pipeline Burst," : "",
-		value & (1 << 5) ? "Synchronous," : "",
-		value & (1 << 6) ? "Asynchronous," : "");
-	len = strlen(str);
-	if (len > 1)
-		str[len - 1] = '\0';
-	else
-		strcpy_s(str, sizeof(str), "Unknown");
-	NWL_NodeAttrSet(tab, key, str, 0);
-}
-
 static const CHAR*
 pCacheECTypeToStr(UCHAR Type)
 {
@@ -595,59 +545,6 @@ pCacheAssocToStr(UCHAR Type)
 	return "Unknown";
 }
 
-static void ProcCacheInfo(PNODE tab, void* p)
-{
-	PCacheInfo	pCache = (PCacheInfo)p;
-	const char* str = toPointString(p);
-	UINT64 sz = 0;
-	NWL_NodeAttrSet(tab, "Description", "Cache Information", 0);
-	if (pCache->Header.Length < 0x0f) // 2.0
-		return;
-	NWL_NodeAttrSet(tab, "Socket Designation", LocateString(str, pCache->SocketDesignation), 0);
-	NWL_NodeAttrSetf(tab, "Cache Configuration", 0, "0x%04X", pCache->Configuration);
-	NWL_NodeAttrSet(tab, "Operational Mode", pCacheConfToOpMode(pCache->Configuration), 0);
-	NWL_NodeAttrSetBool(tab, "Enabled", pCache->Configuration & 0x80, 0);
-	NWL_NodeAttrSet(tab, "Location", pCacheConfToLocation(pCache->Configuration), 0);
-	NWL_NodeAttrSetf(tab, "Cache Level", 0, "L%u", 1U + (pCache->Configuration & 0x07));
-	if (pCache->MaxSize == 0xffff && pCache->Header.Length > 0x13)
-	{
-		if (pCache->MaxSize2 & (1ULL << 31))
-			sz = ((UINT64)pCache->MaxSize2 - (1ULL << 31)) * 64 * 1024;
-		else
-			sz = ((UINT64)pCache->MaxSize2) * 1024;
-	}
-	else if (pCache->MaxSize & (1ULL << 15))
-		sz = ((UINT64)pCache->MaxSize - (1ULL << 15)) * 64 * 1024;
-	else
-		sz = ((UINT64) pCache->MaxSize) * 1024;
-	NWL_NodeAttrSet(tab, "Max Cache Size", NWL_GetHumanSize(sz, mem_human_sizes, 1024), NAFLG_FMT_HUMAN_SIZE);
-	if (pCache->InstalledSize == 0xffff && pCache->Header.Length > 0x13)
-	{
-		if (pCache->InstalledSize2 & (1ULL << 31))
-			sz = ((UINT64)pCache->InstalledSize2 - (1ULL << 31)) * 64 * 1024;
-		else
-			sz = ((UINT64)pCache->InstalledSize2) * 1024;
-	}
-	else if (pCache->InstalledSize & (1ULL << 15))
-	{
-		sz = ((UINT64)pCache->InstalledSize - (1ULL << 15)) * 64 * 1024;
-	}
-	else
-	{
-		sz = ((UINT64)pCache->InstalledSize) * 1024;
-	}
-	NWL_NodeAttrSet(tab, "Installed Cache Size", NWL_GetHumanSize(sz, mem_human_sizes, 1024), NAFLG_FMT_HUMAN_SIZE);
-	pCacheSetSRAMType(tab, "Supported SRAM Type", pCache->SupportSRAMType);
-	pCacheSetSRAMType(tab, "Current SRAM Type", pCache->SupportSRAMType);
-	if (pCache->Header.Length < 0x13) // 2.1
-		return;
-	if (pCache->Speed)
-		NWL_NodeAttrSetf(tab, "Cache Speed (ns)", NAFLG_FMT_NUMERIC, "%u", pCache->Speed);
-	NWL_NodeAttrSet(tab, "Error Correction Type", pCacheECTypeToStr(pCache->ErrorCorrectionType), 0);
-	NWL_NodeAttrSet(tab, "System Cache Type", pCacheTypeToStr(pCache->SystemCacheType), 0);
-	NWL_NodeAttrSet(tab, "Associativity", pCacheAssocToStr(pCache->Associativity), 0);
-}
-
 static const CHAR*
 pIntConnectTypeToStr(UCHAR Type)
 {
@@ -745,30 +642,6 @@ pPortTypeToStr(UCHAR Type)
 	return "Other";
 }
 
-static void ProcPortConnectInfo(PNODE tab, void* p)
-{
-	PPortConnectInfo pPort = (PPortConnectInfo)p;
-	const char* str = toPointString(p);
-	NWL_NodeAttrSet(tab, "Description", "Port Connector Information", 0);
-	if (pPort->Header.Length < 0x09)
-		return;
-	NWL_NodeAttrSet(tab, "Internal Reference Designator", LocateString(str, pPort->IntDesignator), 0);
-	NWL_NodeAttrSet(tab, "Internal Connector Type", pIntConnectTypeToStr(pPort->IntConnectorType), 0);
-	NWL_NodeAttrSet(tab, "External Reference Designator", LocateString(str, pPort->ExtDesignator), 0);
-	NWL_NodeAttrSet(tab, "External Connector Type", pIntConnectTypeToStr(pPort->ExtConnectorType), 0);
-	NWL_NodeAttrSet(tab, "Port Type", pPortTypeToStr(pPort->PortType), 0);
-}
-
-static void ProcPSystemSlots(PNODE tab, void* p)
-{
-	PSystemSlots pSys = (PSystemSlots)p;
-	const char* str = toPointString(p);
-	NWL_NodeAttrSet(tab, "Description", "System Slots", 0);
-	if (pSys->Header.Length < 0x0c) // 2.0
-		return;
-	NWL_NodeAttrSet(tab, "Slot Designation", LocateString(str, pSys->SlotDesignation), 0);
-}
-
 static const CHAR*
 pOnBoardDeviceTypeToStr(UCHAR Type)
 {
@@ -788,112 +661,6 @@ pOnBoardDeviceTypeToStr(UCHAR Type)
 	return "Unknown";
 }
 
-static void ProcOnBoardDevInfo(PNODE tab, void* p)
-{
-	UINT count, i;
-	PNODE ndev;
-	POnBoardDevicesInfo pDev = (POnBoardDevicesInfo)p;
-	const char* str = toPointString(p);
-	NWL_NodeAttrSet(tab, "Description", "On Board Devices Information", 0);
-	if (pDev->Header.Length < 0x04)
-		return;
-	count = (pDev->Header.Length - sizeof(SMBIOSHEADER)) / (sizeof(pDev->DeviceInfo[0]));
-	NWL_NodeAttrSetf(tab, "Number of Devices", NAFLG_FMT_NUMERIC, "%u", count);
-	ndev = NWL_NodeAppendNew(tab, "On Board Devices", NFLG_TABLE);
-	for (i = 0; i < count; i++)
-	{
-		PNODE p = NWL_NodeAppendNew(ndev, "Device", NFLG_TABLE_ROW);
-		UCHAR type = pDev->DeviceInfo[i].DeviceType & 0x7f;
-		UCHAR status = pDev->DeviceInfo[i].DeviceType & 0x90;
-		NWL_NodeAttrSet(p, "Type", pOnBoardDeviceTypeToStr(type), 0);
-		NWL_NodeAttrSet(p, "Status", status ? "Enabled" : "Disabled", 0);
-		NWL_NodeAttrSet(p, "Description", LocateString(str, pDev->DeviceInfo[i].Description), 0);
-	}
-}
-
-static void ProcOEMString(PNODE tab, void* p)
-{
-	UCHAR i;
-	PNODE nstr;
-	POEMString pString = (POEMString)p;
-	const char* str = toPointString(p);
-	NWL_NodeAttrSet(tab, "Description", "OEM String", 0);
-	if (pString->Header.Length < 0x05)
-		return;
-	NWL_NodeAttrSetf(tab, "Number of Strings", NAFLG_FMT_NUMERIC, "%u", pString->Count);
-	nstr = NWL_NodeAppendNew(tab, "OEM Strings", NFLG_TABLE);
-	for (i = 1; i <= pString->Count; i++)
-	{
-		PNODE p = NWL_NodeAppendNew(nstr, "OEM String", NFLG_TABLE_ROW);
-		NWL_NodeAttrSet(p, "String", LocateString(str, i), 0);
-	}
-}
-
-static void ProcSysConfOptions(PNODE tab, void* p)
-{
-	UCHAR i;
-	PNODE nstr;
-	POEMString pString = (POEMString)p;
-	const char* str = toPointString(p);
-	NWL_NodeAttrSet(tab, "Description", "System Configuration Options", 0);
-	if (pString->Header.Length < 0x05)
-		return;
-	NWL_NodeAttrSetf(tab, "Number of Strings", NAFLG_FMT_NUMERIC, "%u", pString->Count);
-	nstr = NWL_NodeAppendNew(tab, "Configuration Strings", NFLG_TABLE);
-	for (i = 1; i <= pString->Count; i++)
-	{
-		PNODE p = NWL_NodeAppendNew(nstr, "String", NFLG_TABLE_ROW);
-		NWL_NodeAttrSet(p, "String", LocateString(str, i), 0);
-	}
-}
-
-static void ProcBIOSLangInfo(PNODE tab, void* p)
-{
-	PBIOSLangInfo pLang = (PBIOSLangInfo)p;
-	const char* str = toPointString(p);
-	NWL_NodeAttrSet(tab, "Description", "BIOS Language Information", 0);
-	if (pLang->Header.Length < 0x16)
-		return;
-	NWL_NodeAttrSetf(tab, "Installable Languages", NAFLG_FMT_NUMERIC, "%u", pLang->InstallableLang);
-	NWL_NodeAttrSet(tab, "Current Language", LocateString(str, pLang->CurrentLang), 0);
-}
-
-static void ProcGroupAssoc(PNODE tab, void* p)
-{
-	UINT i, count;
-	PNODE ndev;
-	PGroupAssoc pGA = (PGroupAssoc)p;
-	const char* str = toPointString(p);
-	NWL_NodeAttrSet(tab, "Description", "Group Associations", 0);
-	if (pGA->Header.Length < 0x05)
-		return;
-	NWL_NodeAttrSet(tab, "Group Name", LocateString(str, pGA->GroupName), 0);
-	count = (pGA->Header.Length - sizeof(pGA->GroupName) - sizeof(SMBIOSHEADER)) / (sizeof(pGA->GAItem[0]));
-	NWL_NodeAttrSetf(tab, "Number of Items", NAFLG_FMT_NUMERIC, "%u", count);
-	ndev = NWL_NodeAppendNew(tab, "Items", NFLG_TABLE);
-	for (i = 0; i < count; i++)
-	{
-		PNODE p = NWL_NodeAppendNew(ndev, "Item", NFLG_TABLE_ROW);
-		NWL_NodeAttrSetf(p, "Type", NAFLG_FMT_NUMERIC, "%u", pGA->GAItem[i].ItemType);
-		NWL_NodeAttrSetf(p, "Handle", NAFLG_FMT_NUMERIC, "%u", pGA->GAItem[i].ItemHandle);
-	}
-}
-
-static void ProcSystemEventLog(PNODE tab, void* p)
-{
-	PSystemEventLog pSys = (PSystemEventLog)p;
-	NWL_NodeAttrSet(tab, "Description", "System Event Log", 0);
-	if (pSys->Header.Length < 0x14) // 2.0
-		return;
-	NWL_NodeAttrSetf(tab, "Log Area Length", NAFLG_FMT_NUMERIC, "%u", pSys->LogAreaLength);
-	NWL_NodeAttrSetf(tab, "Log Header Start Offset", NAFLG_FMT_NUMERIC, "%u", pSys->LogHdrStartOffset);
-	NWL_NodeAttrSetf(tab, "Log Data Start Offset", NAFLG_FMT_NUMERIC, "%u", pSys->LogDataStartOffset);
-	NWL_NodeAttrSetf(tab, "Access Method", 0, "0x%02X", pSys->AccessMethod);
-	NWL_NodeAttrSetf(tab, "Log Status", 0, "0x%02X", pSys->LogStatus);
-	NWL_NodeAttrSetf(tab, "Log Change Token", 0, "0x%08lX", pSys->LogChangeToken);
-	NWL_NodeAttrSetf(tab, "Access Method Address", 0, "0x%08lX", pSys->AccessMethodAddr);
-}
-
 static const CHAR*
 pMALocationToStr(UCHAR Location)
 {
@@ -950,24 +717,6 @@ pMAEccToStr(UCHAR ErrCorrection)
 	return "Unknown";
 }
 
-static void ProcMemoryArray(PNODE tab, void* p)
-{
-	PMemoryArray pMA = (PMemoryArray)p;
-	UINT64 sz = 0;
-	NWL_NodeAttrSet(tab, "Description", "Memory Array", 0);
-	if (pMA->Header.Length < 0x0f) // 2.1
-		return;
-	NWL_NodeAttrSet(tab, "Location", pMALocationToStr(pMA->Location), 0);
-	NWL_NodeAttrSet(tab, "Function", pMAUseToStr(pMA->Use), 0);
-	NWL_NodeAttrSet(tab, "Error Correction", pMAEccToStr(pMA->ErrCorrection), 0);
-	if (pMA->MaxCapacity == 0x80000000 && pMA->Header.Length > 0x0f)
-		sz = pMA->ExtMaxCapacity;
-	else
-		sz = ((UINT64)pMA->MaxCapacity) * 1024;
-	NWL_NodeAttrSet(tab, "Max Capacity", NWL_GetHumanSize(sz, mem_human_sizes, 1024), NAFLG_FMT_HUMAN_SIZE);
-	NWL_NodeAttrSetf(tab, "Number of Slots", NAFLG_FMT_NUMERIC, "%u", pMA->NumOfMDs);
-}
-
 static const CHAR*
 pMDMemoryTypeToStr(UCHAR Type)
 {
@@ -1037,39 +786,6 @@ pMDFormFactorToStr(UCHAR Type)
 	return "Unknown";
 }
 
-static void ProcMemoryDevice(PNODE tab, void* p)
-{
-	PMemoryDevice pMD = (PMemoryDevice)p;
-	const char* str = toPointString(p);
-	UINT64 sz = 0;
-	NWL_NodeAttrSet(tab, "Description", "Memory Device", 0);
-	if (pMD->Header.Length < 0x15) // 2.1
-		return;
-	NWL_NodeAttrSet(tab, "Device Locator", LocateString(str, pMD->DeviceLocator), 0);
-	NWL_NodeAttrSet(tab, "Bank Locator", LocateString(str, pMD->BankLocator), 0);
-	NWL_NodeAttrSet(tab, "Form Factor", pMDFormFactorToStr(pMD->FormFactor), 0);
-	if (pMD->TotalWidth)
-		NWL_NodeAttrSetf(tab, "Total Width (bits)", NAFLG_FMT_NUMERIC, "%u", pMD->TotalWidth);
-	if (pMD->DataWidth)
-		NWL_NodeAttrSetf(tab, "Data Width (bits)", NAFLG_FMT_NUMERIC, "%u", pMD->DataWidth);
-	if (pMD->Size & (1ULL << 15))
-		sz = ((UINT64)pMD->Size - (1ULL << 15)) * 1024;
-	else
-		sz = ((UINT64)pMD->Size) * 1024 * 1024;
-	if (!sz)
-		return;
-	NWL_NodeAttrSet(tab, "Device Size", NWL_GetHumanSize(sz, mem_human_sizes, 1024), NAFLG_FMT_HUMAN_SIZE);
-	NWL_NodeAttrSet(tab, "Device Type", pMDMemoryTypeToStr(pMD->MemoryType), 0);
-	if (pMD->Header.Length < 0x1b) // 2.3
-		return;
-	if (pMD->Speed)
-		NWL_NodeAttrSetf(tab, "Speed (MT/s)", NAFLG_FMT_NUMERIC, "%u", pMD->Speed);
-	NWL_NodeAttrSet(tab, "Manufacturer", LocateString(str, pMD->Manufacturer), 0);
-	NWL_NodeAttrSet(tab, "Serial Number", LocateString(str, pMD->SN), 0);
-	NWL_NodeAttrSet(tab, "Asset Tag Number", LocateString(str, pMD->AssetTag), 0);
-	NWL_NodeAttrSet(tab, "Part Number", LocateString(str, pMD->PN), 0);
-}
-
 static const CHAR*
 pMemErrTypeToStr(UCHAR Type)
 {
@@ -1117,53 +833,6 @@ pMemErrOperationToStr(UCHAR Type)
 	return "Unknown";
 }
 
-static void ProcMemoryErrInfo(PNODE tab, void* p)
-{
-	PMemoryErrInfo pMemErrInfo = (PMemoryErrInfo)p;
-	NWL_NodeAttrSet(tab, "Description", "32-Bit Memory Error Information", 0);
-	if (pMemErrInfo->Header.Length < 0x17) // 2.1
-		return;
-	NWL_NodeAttrSet(tab, "Error Type", pMemErrTypeToStr(pMemErrInfo->ErrType), 0);
-	NWL_NodeAttrSet(tab, "Error Granularity", pMemErrGranularityToStr(pMemErrInfo->ErrGranularity), 0);
-	NWL_NodeAttrSet(tab, "Error Operation", pMemErrOperationToStr(pMemErrInfo->ErrOperation), 0);
-	NWL_NodeAttrSetf(tab, "Vendor Syndrome", 0, "0x%08lX", pMemErrInfo->VendorSyndrome);
-	NWL_NodeAttrSetf(tab, "Memory Array Error Address", 0, "0x%08lX", pMemErrInfo->MemArrayErrAddr);
-	NWL_NodeAttrSetf(tab, "Device Error Address", 0, "0x%08lX", pMemErrInfo->DevErrAddr);
-	NWL_NodeAttrSetf(tab, "Error Resolution", 0, "0x%08lX", pMemErrInfo->ErrResolution);
-}
-
-static void ProcMemoryArrayMappedAddress(PNODE tab, void* p)
-{
-	PMemoryArrayMappedAddress pMAMA = (PMemoryArrayMappedAddress)p;
-	NWL_NodeAttrSet(tab, "Description", "Memory Array Mapped Address", 0);
-	if (pMAMA->Header.Length < 0x0f) // 2.1
-		return;
-	NWL_NodeAttrSetf(tab, "Starting Address", 0, "0x%016llX",
-		(pMAMA->Header.Length >= 0x1f && pMAMA->StartAddr == 0xFFFFFFFF) ?
-		pMAMA->ExtStartAddr : pMAMA->StartAddr);
-	NWL_NodeAttrSetf(tab, "Ending Address", 0, "0x%016llX",
-		(pMAMA->Header.Length >= 0x1f && pMAMA->EndAddr == 0xFFFFFFFF) ?
-		pMAMA->ExtEndAddr : pMAMA->EndAddr);
-	NWL_NodeAttrSetf(tab, "Memory Array Handle", NAFLG_FMT_NUMERIC, "%u", pMAMA->Handle);
-	NWL_NodeAttrSetf(tab, "Partition Width", 0, "0x%X", pMAMA->PartitionWidth);
-}
-
-static void ProcMemoryDeviceMappedAddress(PNODE tab, void* p)
-{
-	PMemoryDeviceMappedAddress pMDMA = (PMemoryDeviceMappedAddress)p;
-	NWL_NodeAttrSet(tab, "Description", "Memory Device Mapped Address", 0);
-	if (pMDMA->Header.Length < 0x13) // 2.1
-		return;
-	NWL_NodeAttrSetf(tab, "Starting Address", 0, "0x%016llX",
-		(pMDMA->Header.Length >= 0x23 && pMDMA->StartAddr == 0xFFFFFFFF) ?
-		pMDMA->ExtStartAddr : pMDMA->StartAddr);
-	NWL_NodeAttrSetf(tab, "Ending Address", 0, "0x%016llX",
-		(pMDMA->Header.Length >= 0x23 && pMDMA->EndAddr == 0xFFFFFFFF) ?
-		pMDMA->ExtEndAddr : pMDMA->EndAddr);
-	NWL_NodeAttrSetf(tab, "Memory Device Handle", NAFLG_FMT_NUMERIC, "%u", pMDMA->MDHandle);
-	NWL_NodeAttrSetf(tab, "Memory Array Mapped Address Handle", NAFLG_FMT_NUMERIC, "%u", pMDMA->MAMAHandle);
-}
-
 static const CHAR*
 pPointingDevTypeToStr(UCHAR Type)
 {
@@ -1202,31 +871,6 @@ pPointingDevInterfaceToStr(UCHAR Type)
 	return "Unknown";
 }
 
-static void ProcBuiltinPointing(PNODE tab, void* p)
-{
-	PBuiltinPointing pBP = (PBuiltinPointing)p;
-	NWL_NodeAttrSet(tab, "Description", "Built-in Pointing Device", 0);
-	if (pBP->Header.Length < 0x07) // 2.1
-		return;
-	NWL_NodeAttrSet(tab, "Type", pPointingDevTypeToStr(pBP->Type), 0);
-	NWL_NodeAttrSet(tab, "Interface", pPointingDevInterfaceToStr(pBP->Interface), 0);
-	NWL_NodeAttrSetf(tab, "Number of Buttons", NAFLG_FMT_NUMERIC, "%u", pBP->NumOfButtons);
-}
-
-static void ProcPortableBattery(PNODE tab, void* p)
-{
-	PPortableBattery pPB = (PPortableBattery)p;
-	const char* str = toPointString(p);
-	NWL_NodeAttrSet(tab, "Description", "Portable Battery", 0);
-	if (pPB->Header.Length < 0x1a) // 2.1
-		return;
-	NWL_NodeAttrSet(tab, "Location", LocateString(str, pPB->Location), 0);
-	NWL_NodeAttrSet(tab, "Manufacturer", LocateString(str, pPB->Manufacturer), 0);
-	NWL_NodeAttrSet(tab, "Manufacturer Date", LocateString(str, pPB->Date), 0);
-	NWL_NodeAttrSet(tab, "Serial Number", LocateString(str, pPB->SN), 0);
-	NWL_NodeAttrSet(tab, "Device Name", LocateString(str, pPB->DeviceName), 0);
-}
-
 static const CHAR*
 pSysResetCapabilitiesToStr(UCHAR Type)
 {
@@ -1239,24 +883,6 @@ pSysResetCapabilitiesToStr(UCHAR Type)
 	return "Reserved";
 }
 
-static void ProcSysReset(PNODE tab, void* p)
-{
-	PSysReset pSysReset = (PSysReset)p;
-	NWL_NodeAttrSet(tab, "Description", "System Reset", 0);
-	if (pSysReset->Header.Length < 0x0d)
-		return;
-	NWL_NodeAttrSetBool(tab, "Watchdog Timer", pSysReset->Capabilities & (1 << 5), 0);
-	NWL_NodeAttrSet(tab, "Boot Option on Limit",
-		pSysResetCapabilitiesToStr((pSysReset->Capabilities & 0x18) >> 3), 0);
-	NWL_NodeAttrSet(tab, "Boot Option",
-		pSysResetCapabilitiesToStr((pSysReset->Capabilities & 0x06) >> 1), 0);
-	NWL_NodeAttrSetBool(tab, "System Reset Status", pSysReset->Capabilities & 0x01, 0);
-	NWL_NodeAttrSetf(tab, "Reset Count", NAFLG_FMT_NUMERIC, "%u", pSysReset->ResetCount);
-	NWL_NodeAttrSetf(tab, "Reset Limit", NAFLG_FMT_NUMERIC, "%u", pSysReset->ResetLimit);
-	NWL_NodeAttrSetf(tab, "Timer Interval", NAFLG_FMT_NUMERIC, "%u", pSysReset->TimerInterval);
-	NWL_NodeAttrSetf(tab, "Timeout", NAFLG_FMT_NUMERIC, "%u", pSysReset->Timeout);
-}
-
 static const CHAR*
 pHwSecurityStatusToStr(UCHAR Type)
 {
@@ -1269,229 +895,1771 @@ pHwSecurityStatusToStr(UCHAR Type)
 	return "Unknown";
 }
 
-static void ProcHwSecurity(PNODE tab, void* p)
-{
-	PHwSecurity pHwSecurity = (PHwSecurity)p;
-	NWL_NodeAttrSet(tab, "Description", "Hardware Security", 0);
-	if (pHwSecurity->Header.Length < 0x05)
-		return;
-	NWL_NodeAttrSet(tab, "Power-on Password",
-		pHwSecurityStatusToStr((pHwSecurity->Settings & 0xc0) >> 6), 0);
-	NWL_NodeAttrSet(tab, "Keyboard Password",
-		pHwSecurityStatusToStr((pHwSecurity->Settings & 0x30) >> 4), 0);
-	NWL_NodeAttrSet(tab, "Administrator Password",
-		pHwSecurityStatusToStr((pHwSecurity->Settings & 0x0c) >> 2), 0);
-	NWL_NodeAttrSet(tab, "Front Panel Reset",
-		pHwSecurityStatusToStr(pHwSecurity->Settings & 0x03), 0);
-}
-
-static void ProcSysPowerCtrl(PNODE tab, void* p)
-{
-	PSysPowerCtrl pSysPowerCtrl = (PSysPowerCtrl)p;
-	NWL_NodeAttrSet(tab, "Description", "System Power Controls", 0);
-	if (pSysPowerCtrl->Header.Length < 0x09)
-		return;
-	NWL_NodeAttrSetf(tab, "Next Scheduled Power-on", 0,
-		"%02X-%02X-%02X:%02X:%02X",
-		pSysPowerCtrl->NextPwrOnMonth, pSysPowerCtrl->NextPwrOnDay,
-		pSysPowerCtrl->NextPwrOnHour, pSysPowerCtrl->NextPwrOnMinute,
-		pSysPowerCtrl->NextPwrOnSecond);
-}
-
-static void ProcOutOfBandRemoteAccess(PNODE tab, void* p)
+static const CHAR*
+pBootStatusToStr(UCHAR Status)
 {
-	POutOfBandRemoteAccess pRemoteAccess = (POutOfBandRemoteAccess)p;
-	const char* str = toPointString(p);
-	NWL_NodeAttrSet(tab, "Description", "Out-of-Band Remote Access", 0);
-	if (pRemoteAccess->Header.Length < 0x06)
-		return;
-	NWL_NodeAttrSet(tab, "Manufacturer", LocateString(str, pRemoteAccess->Manufacturer), 0);
-	NWL_NodeAttrSetBool(tab, "Outbound Connection Enabled", pRemoteAccess->Connections & (1 << 1), 0);
-	NWL_NodeAttrSetBool(tab, "Inbound Connection Enabled", pRemoteAccess->Connections & (1 << 0), 0);
+	switch (Status)
+	{
+	case 0x00: return "No errors detected";
+	case 0x01: return "No bootable media";
+	case 0x02: return "Operating system failed to load";
+	case 0x03: return "Firmware-detected hardware failure";
+	case 0x04: return "Operating system-detected hardware failure";
+	case 0x05: return "User-requested boot";
+	case 0x06: return "System security violation";
+	case 0x07: return "Previously-requested image";
+	case 0x08: return "System watchdog timer expired";
+	}
+	if (Status >= 0x80 && Status <= 0xbf)
+		return "Vendor/OEM-specific";
+	if (Status >= 0xc0)
+		return "Product-specific";
+	return "Reserved";
 }
 
-static void ProcBISEntryPoint(PNODE tab, void* p)
+static const CHAR*
+pProbeLocationToStr(UCHAR Location)
 {
-	//PBISEntryPoint pBISEntryPoint = (PBISEntryPoint)p;
-	(void)p;
-	NWL_NodeAttrSet(tab, "Description", "Boot Integrity Services Entry Point", 0);
+	switch (Location)
+	{
+	case 0x01: return "Other";
+	case 0x03: return "Processor";
+	case 0x04: return "Disk";
+	case 0x05: return "Peripheral Bay";
+	case 0x06: return "System Management Module";
+	case 0x07: return "Motherboard";
+	case 0x08: return "Memory Module";
+	case 0x09: return "Processor Module";
+	case 0x0a: return "Power Unit";
+	case 0x0b: return "Add-in Card";
+	case 0x0c: return "Front Panel Board";
+	case 0x0d: return "Back Panel Board";
+	case 0x0e: return "Power System Board";
+	case 0x0f: return "Drive Back Plane";
+	}
+	return "Unknown";
 }
 
-static void ProcSysBootInfo(PNODE tab, void* p)
+static const CHAR*
+pProbeStatusToStr(UCHAR Status)
 {
-	PSysBootInfo pBootInfo = (PSysBootInfo)p;
-	NWL_NodeAttrSet(tab, "Description", "System Boot Information", 0);
-	if (pBootInfo->Header.Length < 0x0b)
-		return;
-	// TODO
+	switch (Status)
+	{
+	case 0x01: return "Other";
+	case 0x03: return "OK";
+	case 0x04: return "Non-critical";
+	case 0x05: return "Critical";
+	case 0x06: return "Non-recoverable";
+	}
+	return "Unknown";
 }
 
-static void ProcMemoryErrInfo64(PNODE tab, void* p)
+static const CHAR*
+pCoolingDevTypeToStr(UCHAR Type)
 {
-	PMemoryErrInfo64 pMemErrInfo = (PMemoryErrInfo64)p;
-	NWL_NodeAttrSet(tab, "Description", "64-Bit Memory Error Information", 0);
-	if (pMemErrInfo->Header.Length < 0x17) // 2.1
-		return;
-	NWL_NodeAttrSet(tab, "Error Type", pMemErrTypeToStr(pMemErrInfo->ErrType), 0);
-	NWL_NodeAttrSet(tab, "Error Granularity", pMemErrGranularityToStr(pMemErrInfo->ErrGranularity), 0);
-	NWL_NodeAttrSet(tab, "Error Operation", pMemErrOperationToStr(pMemErrInfo->ErrOperation), 0);
-	NWL_NodeAttrSetf(tab, "Vendor Syndrome", 0, "0x%08lX", pMemErrInfo->VendorSyndrome);
-	NWL_NodeAttrSetf(tab, "Memory Array Error Address", 0, "0x%016llX", pMemErrInfo->MemArrayErrAddr);
-	NWL_NodeAttrSetf(tab, "Device Error Address", 0, "0x%016llX", pMemErrInfo->DevErrAddr);
-	NWL_NodeAttrSetf(tab, "Error Resolution", 0, "0x%08lX", pMemErrInfo->ErrResolution);
+	switch (Type)
+	{
+	case 0x01: return "Other";
+	case 0x03: return "Fan";
+	case 0x04: return "Centrifugal Blower";
+	case 0x05: return "Chip Fan";
+	case 0x06: return "Cabinet Fan";
+	case 0x07: return "Power Supply Fan";
+	case 0x08: return "Heat Pipe";
+	case 0x09: return "Integrated Refrigeration";
+	case 0x10: return "Active Cooling";
+	case 0x11: return "Passive Cooling";
+	}
+	return "Unknown";
 }
 
-static void ProcTPMDevice(PNODE tab, void* p)
+static const CHAR*
+pMgmtDevTypeToStr(UCHAR Type)
 {
-	PTPMDevice pTPM = (PTPMDevice)p;
-	const char* str = toPointString(p);
-	NWL_NodeAttrSet(tab, "Description", "TPM Device", 0);
-	if (pTPM->Header.Length < 0x1f)
-		return;
-	NWL_NodeAttrSetf(tab, "Vendor", 0, "%c%c%c%c",
+	switch (Type)
+	{
+	case 0x01: return "Other";
+	case 0x03: return "National Semiconductor LM75";
+	case 0x04: return "National Semiconductor LM78";
+	case 0x05: return "National Semiconductor LM79";
+	case 0x06: return "National Semiconductor LM80";
+	case 0x07: return "National Semiconductor LM81";
+	case 0x08: return "Analog Devices ADM9240";
+	case 0x09: return "Dallas Semiconductor DS1780";
+	case 0x0a: return "Maxim 1617";
+	case 0x0b: return "Genesys GL518SM";
+	case 0x0c: return "Winbond W83781D";
+	case 0x0d: return "Holtek HT82H791";
+	}
+	return "Unknown";
+}
+
+static const CHAR*
+pMgmtDevAddrTypeToStr(UCHAR Type)
+{
+	switch (Type)
+	{
+	case 0x01: return "Other";
+	case 0x03: return "I/O Port";
+	case 0x04: return "Memory";
+	case 0x05: return "SMBus";
+	}
+	return "Unknown";
+}
+
+static const CHAR*
+pMemChannelTypeToStr(UCHAR Type)
+{
+	switch (Type)
+	{
+	case 0x01: return "Other";
+	case 0x03: return "RamBus";
+	case 0x04: return "SyncLink";
+	}
+	return "Unknown";
+}
+
+static const CHAR*
+pIPMIInterfaceTypeToStr(UCHAR Type)
+{
+	switch (Type)
+	{
+	case 0x01: return "KCS (Keyboard Control Style)";
+	case 0x02: return "SMIC (Server Management Interface Chip)";
+	case 0x03: return "BT (Block Transfer)";
+	case 0x04: return "SSIF (SMBus System Interface)";
+	}
+	return "Unknown";
+}
+
+static const CHAR*
+pMCHostInterfaceTypeToStr(UCHAR Type)
+{
+	switch (Type)
+	{
+	case 0x02: return "KCS";
+	case 0x03: return "8250 UART";
+	case 0x04: return "16450 UART";
+	case 0x05: return "16550/16550A UART";
+	case 0x06: return "16650/16650A UART";
+	case 0x07: return "16750/16750A UART";
+	case 0x08: return "16850/16850A UART";
+	case 0x40: return "Network Host Interface";
+	case 0xf0: return "OEM";
+	}
+	return "Unknown";
+}
+
+static const CHAR*
+pMCHostProtocolTypeToStr(UCHAR Type)
+{
+	switch (Type)
+	{
+	case 0x02: return "IPMI";
+	case 0x03: return "MCTP";
+	case 0x04: return "Redfish over IP";
+	case 0xf0: return "OEM";
+	}
+	return "Reserved";
+}
+
+static const CHAR*
+pProcessorArchToStr(UCHAR Type)
+{
+	switch (Type)
+	{
+	case 0x01: return "IA32 (x86)";
+	case 0x02: return "x64 (x86-64, Intel64, AMD64, EM64T)";
+	case 0x03: return "Intel Itanium architecture";
+	case 0x04: return "32-bit ARM (Aarch32)";
+	case 0x05: return "64-bit ARM (Aarch64)";
+	case 0x06: return "32-bit RISC-V (RV32)";
+	case 0x07: return "64-bit RISC-V (RV64)";
+	case 0x08: return "128-bit RISC-V (RV128)";
+	case 0x09: return "32-bit LoongArch (LoongArch32)";
+	case 0x0a: return "64-bit LoongArch (LoongArch64)";
+	}
+	return "Reserved";
+}
+
+static const CHAR*
+pFwVersionFormatToStr(UCHAR Format)
+{
+	switch (Format)
+	{
+	case 0x00: return "Free-form";
+	case 0x01: return "Major.Minor";
+	case 0x02: return "32-bit Hex";
+	case 0x03: return "64-bit Hex";
+	}
+	if (Format >= 0x80)
+		return "OEM";
+	return "Reserved";
+}
+
+static const CHAR*
+pFwIdFormatToStr(UCHAR Format)
+{
+	switch (Format)
+	{
+	case 0x00: return "Free-form";
+	case 0x01: return "UEFI GUID";
+	}
+	if (Format >= 0x80)
+		return "OEM";
+	return "Reserved";
+}
+
+static const CHAR*
+pFwStateToStr(UCHAR State)
+{
+	switch (State)
+	{
+	case 0x01: return "Other";
+	case 0x03: return "Disabled";
+	case 0x04: return "Enabled";
+	case 0x05: return "Absent";
+	case 0x06: return "Standby Offline";
+	case 0x07: return "Standby Spare";
+	case 0x08: return "Unavailable Offline";
+	}
+	return "Unknown";
+}
+
+enum
+{
+	SMBK_STR = 0,	// string number
+	SMBK_DEC,		// unsigned decimal
+	SMBK_HEX,		// hexadecimal, zero padded to the field width
+	SMBK_ENUM,		// (value & Mask) >> Shift mapped through ToStr
+	SMBK_BOOL,		// value & Mask
+	SMBK_PROC,		// decoded by Proc
+};
+
+#define SMBF_NONZERO	0x01	// omit the attribute when the value is zero
+
+typedef struct _SMBIOS_FIELD SMBIOS_FIELD;
+
+// Returns FALSE to stop decoding the remaining fields of the structure.
+typedef BOOL (*SMBIOS_FIELD_PROC)(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f);
+
+struct _SMBIOS_FIELD
+{
+	LPCSTR Name;
+	UINT8 Kind;
+	UINT8 Flags;
+	UINT8 Offset;
+	UINT8 Width;
+	UINT8 MinLength;	// structure length of the spec version that added the field
+	UINT8 Shift;
+	UINT32 Mask;
+	const CHAR* (*ToStr)(UCHAR);
+	SMBIOS_FIELD_PROC Proc;
+	UINT32 Aux;			// Proc specific
+};
+
+typedef struct _SMBIOS_TYPE
+{
+	UINT8 Type;
+	LPCSTR Description;
+	const SMBIOS_FIELD* Fields;
+	UINT Count;
+} SMBIOS_TYPE;
+
+#define SMB_FIELD(kind, name, t, m, len, flags, mask, shift, fn, proc, aux) \
+	{ name, kind, flags, (UINT8)offsetof(t, m), (UINT8)sizeof(((t*)0)->m), len, shift, mask, fn, proc, aux }
+
+#define F_STR(name, t, m, len)					SMB_FIELD(SMBK_STR, name, t, m, len, 0, 0, 0, NULL, NULL, 0)
+#define F_DEC(name, t, m, len)					SMB_FIELD(SMBK_DEC, name, t, m, len, 0, 0, 0, NULL, NULL, 0)
+#define F_DEC_NZ(name, t, m, len)				SMB_FIELD(SMBK_DEC, name, t, m, len, SMBF_NONZERO, 0, 0, NULL, NULL, 0)
+#define F_HEX(name, t, m, len)					SMB_FIELD(SMBK_HEX, name, t, m, len, 0, 0, 0, NULL, NULL, 0)
+#define F_ENUM(name, t, m, len, fn)				SMB_FIELD(SMBK_ENUM, name, t, m, len, 0, 0, 0, fn, NULL, 0)
+#define F_BITS(name, t, m, len, mask, shift, fn)	SMB_FIELD(SMBK_ENUM, name, t, m, len, 0, mask, shift, fn, NULL, 0)
+#define F_BOOL(name, t, m, len, mask)			SMB_FIELD(SMBK_BOOL, name, t, m, len, 0, mask, 0, NULL, NULL, 0)
+#define F_PROC(name, t, m, len, proc, aux)		SMB_FIELD(SMBK_PROC, name, t, m, len, 0, 0, 0, NULL, proc, aux)
+#define F_PROC_BITS(name, t, m, len, mask, shift, proc) SMB_FIELD(SMBK_PROC, name, t, m, len, 0, mask, shift, NULL, proc, 0)
+
+#define SMB_TYPE(type, desc, fields) { type, desc, fields, _countof(fields) }
+
+static BOOL FieldFits(PSMBIOS_ENTRY e, UINT Offset, UINT Width)
+{
+	return Offset + Width <= e->Header->Length;
+}
+
+static UINT64 FieldValue(PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	UINT64 v = 0;
+	memcpy(&v, (LPBYTE)e->Header + f->Offset, f->Width < sizeof(v) ? f->Width : sizeof(v));
+	if (f->Mask)
+		v = (v & f->Mask) >> f->Shift;
+	return v;
+}
+
+static UINT64 ReadValue(PSMBIOS_ENTRY e, UINT Offset, UINT Width)
+{
+	UINT64 v = 0;
+	if (FieldFits(e, Offset, Width))
+		memcpy(&v, (LPBYTE)e->Header + Offset, Width);
+	return v;
+}
+
+static BOOL pBIOSSegment(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	NWL_NodeAttrSetf(tab, f->Name, 0, "%04Xh", (UINT)FieldValue(e, f));
+	return TRUE;
+}
+
+static BOOL pBIOSROMSize(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	NWL_NodeAttrSetf(tab, f->Name, NAFLG_FMT_NUMERIC, "%u", ((UINT)FieldValue(e, f) + 1) * 64);
+	return TRUE;
+}
+
+// Major and minor bytes, 0xFF 0xFF when not supported.
+static BOOL pVersionPair(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	UCHAR major, minor;
+	if (!FieldFits(e, f->Offset + 1, 1))
+		return TRUE;
+	major = (UCHAR)FieldValue(e, f);
+	minor = (UCHAR)ReadValue(e, f->Offset + 1, 1);
+	if (major != 0xff || minor != 0xff)
+		NWL_NodeAttrSetf(tab, f->Name, 0, "%u.%u", major, minor);
+	return TRUE;
+}
+
+static BOOL pSysUUID(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	NWL_NodeAttrSet(tab, f->Name, NWL_GuidToStr((LPBYTE)e->Header + f->Offset), NAFLG_FMT_GUID);
+	return TRUE;
+}
+
+static BOOL pEnclosureType(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	UCHAR type = (UCHAR)FieldValue(e, f);
+	NWL_NodeAttrSetf(tab, f->Name, 0, "%s%s",
+		(type & 0x80) ? "[LOCK]" : "",
+		pSystemEnclosureTypeToStr(type));
+	return TRUE;
+}
+
+static BOOL pProcVoltage(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	UCHAR voltage = (UCHAR)FieldValue(e, f);
+	if (!voltage)
+	{
+		// unsupported
+	}
+	else if (voltage & (1U << 7))
+	{
+		UCHAR volt = voltage - 0x80;
+		NWL_NodeAttrSetf(tab, f->Name, 0, "%u.%u V", volt / 10, volt % 10);
+	}
+	else
+	{
+		NWL_NodeAttrSetf(tab, f->Name, 0, "%s%s%s",
+			voltage & (1U << 0) ? " 5 V" : "",
+			voltage & (1U << 1) ? " 3.3 V" : "",
+			voltage & (1U << 2) ? " 2.9 V" : "");
+	}
+	return TRUE;
+}
+
+static UINT64 pCacheSize(PCacheInfo pCache, BOOL Installed)
+{
+	UINT16 sz = Installed ? pCache->InstalledSize : pCache->MaxSize;
+	DWORD sz2 = Installed ? pCache->InstalledSize2 : pCache->MaxSize2;
+	if (sz == 0xffff && pCache->Header.Length > 0x13)
+	{
+		if (sz2 & (1ULL << 31))
+			return ((UINT64)sz2 - (1ULL << 31)) * 64 * 1024;
+		return ((UINT64)sz2) * 1024;
+	}
+	if (sz & (1ULL << 15))
+		return ((UINT64)sz - (1ULL << 15)) * 64 * 1024;
+	return ((UINT64)sz) * 1024;
+}
+
+// Installed size of the cache structure referenced by a processor.
+static BOOL pProcCache(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	PSMBIOS_ENTRY entry = ResolveHandle((WORD)FieldValue(e, f), 7);
+	if (!entry || entry->Header->Length < 0x0f)
+		return TRUE;
+	NWL_NodeAttrSet(tab, f->Name, NWL_GetHumanSize(pCacheSize((PCacheInfo)entry->Header, TRUE),
+		mem_human_sizes, 1024), NAFLG_FMT_HUMAN_SIZE);
+	return TRUE;
+}
+
+// Byte count, 0xFF means the 16-bit count at offset Aux is used.
+static BOOL pProcCount(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	UINT count = (UINT)FieldValue(e, f);
+	if (count == 0xff && FieldFits(e, f->Aux, 2))
+		count = (UINT)ReadValue(e, f->Aux, 2);
+	NWL_NodeAttrSetf(tab, f->Name, NAFLG_FMT_NUMERIC, "%u", count);
+	return TRUE;
+}
+
+static BOOL pMemModuleSize(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	UINT64 sz = FieldValue(e, f);
+	if (sz > 0x7D)
+		sz = 0;
+	NWL_NodeAttrSetf(tab, f->Name, NAFLG_FMT_NUMERIC, "%llu", 2ULL << sz);
+	return TRUE;
+}
+
+static BOOL pCacheLevel(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	NWL_NodeAttrSetf(tab, f->Name, 0, "L%u", 1U + (UINT)FieldValue(e, f));
+	return TRUE;
+}
+
+static BOOL pCacheSizeAttr(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	NWL_NodeAttrSet(tab, f->Name,
+		NWL_GetHumanSize(pCacheSize((PCacheInfo)e->Header, f->Aux), mem_human_sizes, 1024), NAFLG_FMT_HUMAN_SIZE);
+	return TRUE;
+}
+
+static BOOL pCacheSRAMType(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	size_t len;
+	char str[64];
+	UINT16 value = (UINT16)FieldValue(e, f);
+	snprintf(str, sizeof(str), "%s%s%s%s%s",
+		value & (1 << 2) ? "Non-Burst," : "",
+		value & (1 << 3) ? "Burst," : "",
+		value & (1 << 4) ? "Pipeline Burst," : "",
+		value & (1 << 5) ? "Synchronous," : "",
+		value & (1 << 6) ? "Asynchronous," : "");
+	len = strlen(str);
+	if (len > 1)
+		str[len - 1] = '\0';
+	else
+		strcpy_s(str, sizeof(str), "Unknown");
+	NWL_NodeAttrSet(tab, f->Name, str, 0);
+	return TRUE;
+}
+
+static BOOL pOnBoardDevices(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	UINT count, i;
+	PNODE ndev;
+	POnBoardDevicesInfo pDev = (POnBoardDevicesInfo)e->Header;
+	count = (pDev->Header.Length - sizeof(SMBIOSHEADER)) / (sizeof(pDev->DeviceInfo[0]));
+	NWL_NodeAttrSetf(tab, f->Name, NAFLG_FMT_NUMERIC, "%u", count);
+	ndev = NWL_NodeAppendNew(tab, "On Board Devices", NFLG_TABLE);
+	for (i = 0; i < count; i++)
+	{
+		PNODE p = NWL_NodeAppendNew(ndev, "Device", NFLG_TABLE_ROW);
+		UCHAR type = pDev->DeviceInfo[i].DeviceType & 0x7f;
+		UCHAR status = pDev->DeviceInfo[i].DeviceType & 0x90;
+		NWL_NodeAttrSet(p, "Type", pOnBoardDeviceTypeToStr(type), 0);
+		NWL_NodeAttrSet(p, "Status", status ? "Enabled" : "Disabled", 0);
+		NWL_NodeAttrSet(p, "Description", LocateString(e, pDev->DeviceInfo[i].Description), 0);
+	}
+	return TRUE;
+}
+
+// Type 11 and 12 carry only a string count.
+static BOOL pStringList(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	UCHAR i, count = (UCHAR)FieldValue(e, f);
+	BOOL oem = (e->Header->Type == 11);
+	PNODE nstr;
+	NWL_NodeAttrSetf(tab, f->Name, NAFLG_FMT_NUMERIC, "%u", count);
+	nstr = NWL_NodeAppendNew(tab, oem ? "OEM Strings" : "Configuration Strings", NFLG_TABLE);
+	for (i = 1; i <= count; i++)
+	{
+		PNODE p = NWL_NodeAppendNew(nstr, oem ? "OEM String" : "String", NFLG_TABLE_ROW);
+		NWL_NodeAttrSet(p, "String", LocateString(e, i), 0);
+	}
+	return TRUE;
+}
+
+static BOOL pGroupItems(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	UINT i, count;
+	PNODE ndev;
+	PGroupAssoc pGA = (PGroupAssoc)e->Header;
+	count = (pGA->Header.Length - sizeof(pGA->GroupName) - sizeof(SMBIOSHEADER)) / (sizeof(pGA->GAItem[0]));
+	NWL_NodeAttrSetf(tab, f->Name, NAFLG_FMT_NUMERIC, "%u", count);
+	ndev = NWL_NodeAppendNew(tab, "Items", NFLG_TABLE);
+	for (i = 0; i < count; i++)
+	{
+		PNODE p = NWL_NodeAppendNew(ndev, "Item", NFLG_TABLE_ROW);
+		NWL_NodeAttrSetf(p, "Type", NAFLG_FMT_NUMERIC, "%u", pGA->GAItem[i].ItemType);
+		NWL_NodeAttrSetf(p, "Handle", NAFLG_FMT_NUMERIC, "%u", pGA->GAItem[i].ItemHandle);
+	}
+	return TRUE;
+}
+
+static BOOL pMAMaxCapacity(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	PMemoryArray pMA = (PMemoryArray)e->Header;
+	UINT64 sz;
+	if (pMA->MaxCapacity == 0x80000000 && pMA->Header.Length > 0x0f)
+		sz = pMA->ExtMaxCapacity;
+	else
+		sz = ((UINT64)pMA->MaxCapacity) * 1024;
+	NWL_NodeAttrSet(tab, f->Name, NWL_GetHumanSize(sz, mem_human_sizes, 1024), NAFLG_FMT_HUMAN_SIZE);
+	return TRUE;
+}
+
+static BOOL pMDArrayLocation(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	PSMBIOS_ENTRY pArray = ResolveHandle((WORD)FieldValue(e, f), 16);
+	if (pArray && pArray->Header->Length >= 0x0f)
+		NWL_NodeAttrSet(tab, f->Name, pMALocationToStr(((PMemoryArray)pArray->Header)->Location), 0);
+	return TRUE;
+}
+
+static UINT64 MDGetSize(PSMBIOS_ENTRY e)
+{
+	PMemoryDevice pMD = (PMemoryDevice)e->Header;
+	if (pMD->Size == 0xFFFF)
+		return 0;
+	if (pMD->Size == 0x7FFF && FieldFits(e, offsetof(MemoryDevice, ExtendedSize), 4))
+		return ((UINT64)(pMD->ExtendedSize & 0x7FFFFFFF)) * 1024 * 1024;
+	if (pMD->Size & (1ULL << 15))
+		return ((UINT64)pMD->Size - (1ULL << 15)) * 1024;
+	return ((UINT64)pMD->Size) * 1024 * 1024;
+}
+
+// 0xFFFF means the 32-bit extended speed is used.
+static UINT MDGetSpeed(PSMBIOS_ENTRY e, BOOL Configured)
+{
+	UINT speed;
+	if (Configured)
+	{
+		speed = (UINT)ReadValue(e, offsetof(MemoryDevice, ConfiguredSpeed), 2);
+		if (speed == 0xFFFF)
+			speed = (UINT)ReadValue(e, offsetof(MemoryDevice, ExtendedConfiguredSpeed), 4) & 0x7FFFFFFF;
+	}
+	else
+	{
+		speed = (UINT)ReadValue(e, offsetof(MemoryDevice, Speed), 2);
+		if (speed == 0xFFFF)
+			speed = (UINT)ReadValue(e, offsetof(MemoryDevice, ExtendedSpeed), 4) & 0x7FFFFFFF;
+	}
+	return speed;
+}
+
+// Empty slots report no size, skip the rest of the device.
+static BOOL pMDSize(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	UINT64 sz = MDGetSize(e);
+	if (!sz)
+		return FALSE;
+	NWL_NodeAttrSet(tab, f->Name, NWL_GetHumanSize(sz, mem_human_sizes, 1024), NAFLG_FMT_HUMAN_SIZE);
+	return TRUE;
+}
+
+static BOOL pMDSpeed(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	UINT speed = MDGetSpeed(e, f->Aux);
+	if (speed)
+		NWL_NodeAttrSetf(tab, f->Name, NAFLG_FMT_NUMERIC, "%u", speed);
+	return TRUE;
+}
+
+// 32-bit address, 0xFFFFFFFF means the 64-bit address at offset Aux is used.
+static BOOL pMappedAddress(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	UINT64 addr = FieldValue(e, f);
+	if (addr == 0xFFFFFFFF && FieldFits(e, f->Aux, 8))
+		addr = ReadValue(e, f->Aux, 8);
+	NWL_NodeAttrSetf(tab, f->Name, 0, "0x%016llX", addr);
+	return TRUE;
+}
+
+static BOOL pMDMALocator(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	PSMBIOS_ENTRY pDevice = ResolveHandle((WORD)FieldValue(e, f), 17);
+	if (pDevice && pDevice->Header->Length >= 0x15)
+		NWL_NodeAttrSet(tab, f->Name,
+			LocateString(pDevice, ((PMemoryDevice)pDevice->Header)->DeviceLocator), 0);
+	return TRUE;
+}
+
+static BOOL pNextPowerOn(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	PSysPowerCtrl pSysPowerCtrl = (PSysPowerCtrl)e->Header;
+	NWL_NodeAttrSetf(tab, f->Name, 0,
+		"%02X-%02X-%02X:%02X:%02X",
+		pSysPowerCtrl->NextPwrOnMonth, pSysPowerCtrl->NextPwrOnDay,
+		pSysPowerCtrl->NextPwrOnHour, pSysPowerCtrl->NextPwrOnMinute,
+		pSysPowerCtrl->NextPwrOnSecond);
+	return TRUE;
+}
+
+static BOOL pTPMVendor(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	PTPMDevice pTPM = (PTPMDevice)e->Header;
+	NWL_NodeAttrSetf(tab, f->Name, 0, "%c%c%c%c",
 		pTPM->Vendor[0], pTPM->Vendor[1],
 		pTPM->Vendor[2], pTPM->Vendor[3]);
-	NWL_NodeAttrSetf(tab, "Spec Version", 0, "%u%u", pTPM->MajorSpecVer, pTPM->MinorSpecVer);
-	NWL_NodeAttrSet(tab, "Description", LocateString(str, pTPM->Description), 0);
+	return TRUE;
+}
+
+static BOOL pTPMSpecVersion(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	PTPMDevice pTPM = (PTPMDevice)e->Header;
+	NWL_NodeAttrSetf(tab, f->Name, 0, "%u%u", pTPM->MajorSpecVer, pTPM->MinorSpecVer);
+	return TRUE;
+}
+
+// Probe readings, 0x8000 means unknown. Aux is set for signed values.
+static BOOL pProbeValue(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	UINT16 value = (UINT16)FieldValue(e, f);
+	if (value == 0x8000)
+		return TRUE;
+	if (f->Aux)
+		NWL_NodeAttrSetf(tab, f->Name, NAFLG_FMT_NUMERIC, "%d", (INT16)value);
+	else
+		NWL_NodeAttrSetf(tab, f->Name, NAFLG_FMT_NUMERIC, "%u", value);
+	return TRUE;
+}
+
+static BOOL pMemChannelDevices(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	UINT i, count;
+	PNODE ndev;
+	PMemoryChannel pMC = (PMemoryChannel)e->Header;
+	count = (UINT)FieldValue(e, f);
+	NWL_NodeAttrSetf(tab, f->Name, NAFLG_FMT_NUMERIC, "%u", count);
+	ndev = NWL_NodeAppendNew(tab, "Devices", NFLG_TABLE);
+	for (i = 0; i < count; i++)
+	{
+		PNODE p;
+		if (!FieldFits(e, offsetof(MemoryChannel, Devices) + (i + 1) * sizeof(pMC->Devices[0]), 0))
+			break;
+		p = NWL_NodeAppendNew(ndev, "Device", NFLG_TABLE_ROW);
+		NWL_NodeAttrSetf(p, "Load", NAFLG_FMT_NUMERIC, "%u", pMC->Devices[i].Load);
+		NWL_NodeAttrSetf(p, "Handle", NAFLG_FMT_NUMERIC, "%u", pMC->Devices[i].Handle);
+	}
+	return TRUE;
+}
+
+static BOOL pBCDVersion(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	UCHAR rev = (UCHAR)FieldValue(e, f);
+	NWL_NodeAttrSetf(tab, f->Name, 0, "%u.%u", rev >> 4, rev & 0x0f);
+	return TRUE;
+}
+
+static BOOL pAdditionalInfo(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	UINT i, count, offset;
+	PNODE nent;
+	count = (UINT)FieldValue(e, f);
+	NWL_NodeAttrSetf(tab, f->Name, NAFLG_FMT_NUMERIC, "%u", count);
+	nent = NWL_NodeAppendNew(tab, "Entries", NFLG_TABLE);
+	for (i = 0, offset = offsetof(AdditionalInfo, Entries); i < count; i++)
+	{
+		UINT64 value = 0;
+		PNODE p;
+		PAdditionalInfoEntry entry = (PAdditionalInfoEntry)((LPBYTE)e->Header + offset);
+		if (!FieldFits(e, offset, sizeof(AdditionalInfoEntry))
+			|| entry->EntryLength < sizeof(AdditionalInfoEntry)
+			|| !FieldFits(e, offset, entry->EntryLength))
+			break;
+		p = NWL_NodeAppendNew(nent, "Entry", NFLG_TABLE_ROW);
+		NWL_NodeAttrSetf(p, "Referenced Handle", NAFLG_FMT_NUMERIC, "%u", entry->ReferencedHandle);
+		NWL_NodeAttrSetf(p, "Referenced Offset", 0, "0x%02X", entry->ReferencedOffset);
+		NWL_NodeAttrSet(p, "String", LocateString(e, entry->String), 0);
+		memcpy(&value, entry->Value, min(entry->EntryLength - sizeof(AdditionalInfoEntry), sizeof(value)));
+		NWL_NodeAttrSetf(p, "Value", 0, "0x%llX", value);
+		offset += entry->EntryLength;
+	}
+	return TRUE;
+}
+
+static BOOL pPciAddress(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	POnBoardDevicesExtInfo pDev = (POnBoardDevicesExtInfo)e->Header;
+	NWL_NodeAttrSetf(tab, f->Name, 0, "%04X:%02X:%02X.%X",
+		pDev->SegmentGroupNum, pDev->BusNum, pDev->DevFuncNum >> 3, pDev->DevFuncNum & 0x07);
+	return TRUE;
+}
+
+static BOOL pMCHostProtocols(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	UINT i, count, offset;
+	PNODE nproto;
+	PMCHostInterface pMC = (PMCHostInterface)e->Header;
+	offset = offsetof(MCHostInterface, InterfaceData) + pMC->InterfaceDataLength;
+	if (!FieldFits(e, offset, 1))
+		return TRUE;
+	count = (UINT)ReadValue(e, offset, 1);
+	NWL_NodeAttrSetf(tab, f->Name, NAFLG_FMT_NUMERIC, "%u", count);
+	nproto = NWL_NodeAppendNew(tab, "Protocol Records", NFLG_TABLE);
+	for (i = 0, offset++; i < count && FieldFits(e, offset, 2); i++)
+	{
+		PNODE p = NWL_NodeAppendNew(nproto, "Protocol", NFLG_TABLE_ROW);
+		UCHAR type = (UCHAR)ReadValue(e, offset, 1);
+		UCHAR len = (UCHAR)ReadValue(e, offset + 1, 1);
+		NWL_NodeAttrSet(p, "Type", pMCHostProtocolTypeToStr(type), 0);
+		NWL_NodeAttrSetf(p, "Data Length", NAFLG_FMT_NUMERIC, "%u", len);
+		offset += 2 + len;
+	}
+	return TRUE;
+}
+
+static BOOL pFwImageSize(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	UINT64 sz = FieldValue(e, f);
+	if (sz != 0xFFFFFFFFFFFFFFFFULL)
+		NWL_NodeAttrSet(tab, f->Name, NWL_GetHumanSize(sz, mem_human_sizes, 1024), NAFLG_FMT_HUMAN_SIZE);
+	return TRUE;
+}
+
+static BOOL pFwComponents(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	UINT i, count;
+	PNODE ncomp;
+	PFirmwareInventory pFw = (PFirmwareInventory)e->Header;
+	count = (UINT)FieldValue(e, f);
+	NWL_NodeAttrSetf(tab, f->Name, NAFLG_FMT_NUMERIC, "%u", count);
+	ncomp = NWL_NodeAppendNew(tab, "Associated Components", NFLG_TABLE);
+	for (i = 0; i < count; i++)
+	{
+		PNODE p;
+		if (!FieldFits(e, offsetof(FirmwareInventory, AssociatedComponentHandles) + (i + 1) * sizeof(UINT16), 0))
+			break;
+		p = NWL_NodeAppendNew(ncomp, "Component", NFLG_TABLE_ROW);
+		NWL_NodeAttrSetf(p, "Handle", NAFLG_FMT_NUMERIC, "%u", pFw->AssociatedComponentHandles[i]);
+	}
+	return TRUE;
+}
+
+static BOOL pStringPropertyID(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	UINT16 id = (UINT16)FieldValue(e, f);
+	if (id == 1)
+		NWL_NodeAttrSet(tab, f->Name, "UEFI device path", 0);
+	else if (id >= 0x8000 && id < 0xc000)
+		NWL_NodeAttrSetf(tab, f->Name, 0, "BIOS vendor (0x%04X)", id);
+	else if (id >= 0xc000)
+		NWL_NodeAttrSetf(tab, f->Name, 0, "OEM (0x%04X)", id);
+	else
+		NWL_NodeAttrSetf(tab, f->Name, 0, "Reserved (0x%04X)", id);
+	return TRUE;
+}
+
+static const SMBIOS_FIELD smbios_fields_0[] =
+{
+	// 2.0
+	F_STR("Vendor", BIOSInfo, Vendor, 0x12),
+	F_STR("Version", BIOSInfo, Version, 0x12),
+	F_PROC("Starting Segment", BIOSInfo, StartingAddrSeg, 0x12, pBIOSSegment, 0),
+	F_STR("Release Date", BIOSInfo, ReleaseDate, 0x12),
+	F_PROC("Image Size (K)", BIOSInfo, ROMSize, 0x12, pBIOSROMSize, 0),
+	F_HEX("BIOS Characteristics", BIOSInfo, Characteristics, 0x12),
+	// 2.4
+	F_PROC("System BIOS Version", BIOSInfo, MajorRelease, 0x18, pVersionPair, 0),
+	F_PROC("EC Firmware Version", BIOSInfo, ECFirmwareMajor, 0x18, pVersionPair, 0),
+};
+
+static const SMBIOS_FIELD smbios_fields_1[] =
+{
+	// 2.0
+	F_STR("Manufacturer", SystemInfo, Manufacturer, 0x08),
+	F_STR("Product Name", SystemInfo, ProductName, 0x08),
+	F_STR("Version", SystemInfo, Version, 0x08),
+	F_STR("Serial Number", SystemInfo, SN, 0x08),
+	// 2.1
+	F_PROC("UUID", SystemInfo, UUID, 0x19, pSysUUID, 0),
+	F_ENUM("Wake-up Type", SystemInfo, WakeUpType, 0x19, pWakeUpTypeToStr),
+	// 2.4
+	F_STR("SKU Number", SystemInfo, SKUNumber, 0x1b),
+	F_STR("Family", SystemInfo, Family, 0x1b),
+};
+
+static const SMBIOS_FIELD smbios_fields_2[] =
+{
+	F_STR("Manufacturer", BoardInfo, Manufacturer, 0x08),
+	F_STR("Product Name", BoardInfo, Product, 0x08),
+	F_STR("Version", BoardInfo, Version, 0x08),
+	F_STR("Serial Number", BoardInfo, SN, 0x08),
+	F_STR("Asset Tag", BoardInfo, AssetTag, 0x09),
+	F_HEX("Feature Flags", BoardInfo, FeatureFlags, 0x0a),
+	F_STR("Location in Chassis", BoardInfo, LocationInChassis, 0x0b),
+	F_DEC("Chassis Handle", BoardInfo, ChassisHandle, 0x0d),
+	F_ENUM("Board Type", BoardInfo, Type, 0x0e, pBoardTypeToStr),
+};
+
+static const SMBIOS_FIELD smbios_fields_3[] =
+{
+	// 2.0
+	F_PROC("Type", SystemEnclosure, Type, 0x09, pEnclosureType, 0),
+	F_STR("Manufacturer", SystemEnclosure, Manufacturer, 0x09),
+	F_STR("Version", SystemEnclosure, Version, 0x09),
+	F_STR("Serial Number", SystemEnclosure, SN, 0x09),
+	F_STR("Asset Tag", SystemEnclosure, AssetTag, 0x09),
+	// 2.1
+	F_ENUM("Boot-up State", SystemEnclosure, BootupState, 0x0d, pBootUpStateToStr),
+	F_ENUM("Power Supply State", SystemEnclosure, PowerSupplyState, 0x0d, pBootUpStateToStr),
+	F_ENUM("Thermal State", SystemEnclosure, ThermalState, 0x0d, pBootUpStateToStr),
+	F_ENUM("Security Status", SystemEnclosure, SecurityStatus, 0x0d, pSecurityStatusToStr),
+	// 2.3
+	F_DEC("OEM-defined", SystemEnclosure, OEMDefine, 0x15),
+};
+
+static const SMBIOS_FIELD smbios_fields_4[] =
+{
+	// 2.0
+	F_STR("Socket Designation", ProcessorInfo, SocketDesignation, 0x1a),
+	F_ENUM("Type", ProcessorInfo, Type, 0x1a, pProcessorTypeToStr),
+	F_ENUM("Processor Family", ProcessorInfo, Family, 0x1a, pProcessorFamilyToStr),
+	F_STR("Processor Manufacturer", ProcessorInfo, Manufacturer, 0x1a),
+	F_STR("Processor Version", ProcessorInfo, Version, 0x1a),
+	F_PROC("Voltage", ProcessorInfo, Voltage, 0x1a, pProcVoltage, 0),
+	F_DEC_NZ("External Clock (MHz)", ProcessorInfo, ExtClock, 0x1a),
+	F_DEC("Max Speed (MHz)", ProcessorInfo, MaxSpeed, 0x1a),
+	F_DEC("Current Speed (MHz)", ProcessorInfo, CurrentSpeed, 0x1a),
+	// 2.1
+	F_PROC("L1 Cache", ProcessorInfo, L1CacheHandle, 0x20, pProcCache, 0),
+	F_PROC("L2 Cache", ProcessorInfo, L2CacheHandle, 0x20, pProcCache, 0),
+	F_PROC("L3 Cache", ProcessorInfo, L3CacheHandle, 0x20, pProcCache, 0),
+	// 2.3
+	F_STR("Serial Number", ProcessorInfo, Serial, 0x23),
+	F_STR("Asset Tag", ProcessorInfo, AssetTag, 0x23),
+	F_STR("Part Number", ProcessorInfo, PartNum, 0x23),
+	// 2.5
+	F_PROC("Core Count", ProcessorInfo, CoreCount, 0x28, pProcCount, offsetof(ProcessorInfo, CoreCount2)),
+	F_PROC("Core Enabled", ProcessorInfo, CoreEnabled, 0x28, pProcCount, offsetof(ProcessorInfo, CoreEnabled2)),
+	F_PROC("Thread Count", ProcessorInfo, ThreadCount, 0x28, pProcCount, offsetof(ProcessorInfo, ThreadCount2)),
+	F_HEX("Processor Characteristics", ProcessorInfo, ProcessorChar, 0x28),
+};
+
+static const SMBIOS_FIELD smbios_fields_5[] =
+{
+	// 2.0
+	F_PROC("Max Memory Module Size (MB)", MemCtrlInfo, MaxMemModuleSize, 0x15, pMemModuleSize, 0),
+	F_DEC("Number of Slots", MemCtrlInfo, NumOfSlots, 0x15),
+};
+
+static const SMBIOS_FIELD smbios_fields_6[] =
+{
+	F_STR("Socket Designation", MemModuleInfo, SocketDesignation, 0x0c),
+	F_DEC("Current Speed (ns)", MemModuleInfo, CurrentSpeed, 0x0c),
+	F_PROC_BITS("Installed Size (MB)", MemModuleInfo, InstalledSize, 0x0c, 0x7f, 0, pMemModuleSize),
+};
+
+static const SMBIOS_FIELD smbios_fields_7[] =
+{
+	// 2.0
+	F_STR("Socket Designation", CacheInfo, SocketDesignation, 0x0f),
+	F_HEX("Cache Configuration", CacheInfo, Configuration, 0x0f),
+	F_BITS("Operational Mode", CacheInfo, Configuration, 0x0f, 0x300, 8, pCacheOpModeToStr),
+	F_BOOL("Enabled", CacheInfo, Configuration, 0x0f, 0x80),
+	F_BITS("Location", CacheInfo, Configuration, 0x0f, 0x60, 5, pCacheLocationToStr),
+	F_PROC_BITS("Cache Level", CacheInfo, Configuration, 0x0f, 0x07, 0, pCacheLevel),
+	F_PROC("Max Cache Size", CacheInfo, MaxSize, 0x0f, pCacheSizeAttr, FALSE),
+	F_PROC("Installed Cache Size", CacheInfo, InstalledSize, 0x0f, pCacheSizeAttr, TRUE),
+	F_PROC("Supported SRAM Type", CacheInfo, SupportSRAMType, 0x0f, pCacheSRAMType, 0),
+	F_PROC("Current SRAM Type", CacheInfo, CurrentSRAMType, 0x0f, pCacheSRAMType, 0),
+	// 2.1
+	F_DEC_NZ("Cache Speed (ns)", CacheInfo, Speed, 0x13),
+	F_ENUM("Error Correction Type", CacheInfo, ErrorCorrectionType, 0x13, pCacheECTypeToStr),
+	F_ENUM("System Cache Type", CacheInfo, SystemCacheType, 0x13, pCacheTypeToStr),
+	F_ENUM("Associativity", CacheInfo, Associativity, 0x13, pCacheAssocToStr),
+};
+
+static const SMBIOS_FIELD smbios_fields_8[] =
+{
+	F_STR("Internal Reference Designator", PortConnectInfo, IntDesignator, 0x09),
+	F_ENUM("Internal Connector Type", PortConnectInfo, IntConnectorType, 0x09, pIntConnectTypeToStr),
+	F_STR("External Reference Designator", PortConnectInfo, ExtDesignator, 0x09),
+	F_ENUM("External Connector Type", PortConnectInfo, ExtConnectorType, 0x09, pIntConnectTypeToStr),
+	F_ENUM("Port Type", PortConnectInfo, PortType, 0x09, pPortTypeToStr),
+};
+
+static const SMBIOS_FIELD smbios_fields_9[] =
+{
+	// 2.0
+	F_STR("Slot Designation", SystemSlots, SlotDesignation, 0x0c),
+};
+
+static const SMBIOS_FIELD smbios_fields_10[] =
+{
+	F_PROC("Number of Devices", SMBIOSHEADER, Handle, 0x04, pOnBoardDevices, 0),
+};
+
+static const SMBIOS_FIELD smbios_fields_11_12[] =
+{
+	F_PROC("Number of Strings", OEMString, Count, 0x05, pStringList, 0),
+};
+
+static const SMBIOS_FIELD smbios_fields_13[] =
+{
+	F_DEC("Installable Languages", BIOSLangInfo, InstallableLang, 0x16),
+	F_STR("Current Language", BIOSLangInfo, CurrentLang, 0x16),
+};
+
+static const SMBIOS_FIELD smbios_fields_14[] =
+{
+	F_STR("Group Name", GroupAssoc, GroupName, 0x05),
+	F_PROC("Number of Items", GroupAssoc, GroupName, 0x05, pGroupItems, 0),
+};
+
+static const SMBIOS_FIELD smbios_fields_15[] =
+{
+	// 2.0
+	F_DEC("Log Area Length", SystemEventLog, LogAreaLength, 0x14),
+	F_DEC("Log Header Start Offset", SystemEventLog, LogHdrStartOffset, 0x14),
+	F_DEC("Log Data Start Offset", SystemEventLog, LogDataStartOffset, 0x14),
+	F_HEX("Access Method", SystemEventLog, AccessMethod, 0x14),
+	F_HEX("Log Status", SystemEventLog, LogStatus, 0x14),
+	F_HEX("Log Change Token", SystemEventLog, LogChangeToken, 0x14),
+	F_HEX("Access Method Address", SystemEventLog, AccessMethodAddr, 0x14),
+};
+
+static const SMBIOS_FIELD smbios_fields_16[] =
+{
+	// 2.1
+	F_ENUM("Location", MemoryArray, Location, 0x0f, pMALocationToStr),
+	F_ENUM("Function", MemoryArray, Use, 0x0f, pMAUseToStr),
+	F_ENUM("Error Correction", MemoryArray, ErrCorrection, 0x0f, pMAEccToStr),
+	F_PROC("Max Capacity", MemoryArray, MaxCapacity, 0x0f, pMAMaxCapacity, 0),
+	F_DEC("Number of Slots", MemoryArray, NumOfMDs, 0x0f),
+};
+
+static const SMBIOS_FIELD smbios_fields_17[] =
+{
+	// 2.1
+	F_STR("Device Locator", MemoryDevice, DeviceLocator, 0x15),
+	F_STR("Bank Locator", MemoryDevice, BankLocator, 0x15),
+	F_PROC("Memory Array Location", MemoryDevice, PhysicalArrayHandle, 0x15, pMDArrayLocation, 0),
+	F_ENUM("Form Factor", MemoryDevice, FormFactor, 0x15, pMDFormFactorToStr),
+	F_DEC_NZ("Total Width (bits)", MemoryDevice, TotalWidth, 0x15),
+	F_DEC_NZ("Data Width (bits)", MemoryDevice, DataWidth, 0x15),
+	F_PROC("Device Size", MemoryDevice, Size, 0x15, pMDSize, 0),
+	F_ENUM("Device Type", MemoryDevice, MemoryType, 0x15, pMDMemoryTypeToStr),
+	// 2.3
+	F_PROC("Speed (MT/s)", MemoryDevice, Speed, 0x1b, pMDSpeed, FALSE),
+	F_STR("Manufacturer", MemoryDevice, Manufacturer, 0x1b),
+	F_STR("Serial Number", MemoryDevice, SN, 0x1b),
+	F_STR("Asset Tag Number", MemoryDevice, AssetTag, 0x1b),
+	F_STR("Part Number", MemoryDevice, PN, 0x1b),
+	// 2.7
+	F_PROC("Configured Speed (MT/s)", MemoryDevice, ConfiguredSpeed, 0x22, pMDSpeed, TRUE),
+	// 2.8
+	F_DEC_NZ("Configured Voltage (mV)", MemoryDevice, ConfiguredVoltage, 0x28),
+};
+
+static const SMBIOS_FIELD smbios_fields_18[] =
+{
+	// 2.1
+	F_ENUM("Error Type", MemoryErrInfo, ErrType, 0x17, pMemErrTypeToStr),
+	F_ENUM("Error Granularity", MemoryErrInfo, ErrGranularity, 0x17, pMemErrGranularityToStr),
+	F_ENUM("Error Operation", MemoryErrInfo, ErrOperation, 0x17, pMemErrOperationToStr),
+	F_HEX("Vendor Syndrome", MemoryErrInfo, VendorSyndrome, 0x17),
+	F_HEX("Memory Array Error Address", MemoryErrInfo, MemArrayErrAddr, 0x17),
+	F_HEX("Device Error Address", MemoryErrInfo, DevErrAddr, 0x17),
+	F_HEX("Error Resolution", MemoryErrInfo, ErrResolution, 0x17),
+};
+
+static const SMBIOS_FIELD smbios_fields_19[] =
+{
+	// 2.1
+	F_PROC("Starting Address", MemoryArrayMappedAddress, StartAddr, 0x0f,
+		pMappedAddress, offsetof(MemoryArrayMappedAddress, ExtStartAddr)),
+	F_PROC("Ending Address", MemoryArrayMappedAddress, EndAddr, 0x0f,
+		pMappedAddress, offsetof(MemoryArrayMappedAddress, ExtEndAddr)),
+	F_DEC("Memory Array Handle", MemoryArrayMappedAddress, Handle, 0x0f),
+	F_DEC("Partition Width", MemoryArrayMappedAddress, PartitionWidth, 0x0f),
+};
+
+static const SMBIOS_FIELD smbios_fields_20[] =
+{
+	// 2.1
+	F_PROC("Starting Address", MemoryDeviceMappedAddress, StartAddr, 0x13,
+		pMappedAddress, offsetof(MemoryDeviceMappedAddress, ExtStartAddr)),
+	F_PROC("Ending Address", MemoryDeviceMappedAddress, EndAddr, 0x13,
+		pMappedAddress, offsetof(MemoryDeviceMappedAddress, ExtEndAddr)),
+	F_DEC("Memory Device Handle", MemoryDeviceMappedAddress, MDHandle, 0x13),
+	F_PROC("Memory Device Locator", MemoryDeviceMappedAddress, MDHandle, 0x13, pMDMALocator, 0),
+	F_DEC("Memory Array Mapped Address Handle", MemoryDeviceMappedAddress, MAMAHandle, 0x13),
+};
+
+static const SMBIOS_FIELD smbios_fields_21[] =
+{
+	// 2.1
+	F_ENUM("Type", BuiltinPointing, Type, 0x07, pPointingDevTypeToStr),
+	F_ENUM("Interface", BuiltinPointing, Interface, 0x07, pPointingDevInterfaceToStr),
+	F_DEC("Number of Buttons", BuiltinPointing, NumOfButtons, 0x07),
+};
+
+static const SMBIOS_FIELD smbios_fields_22[] =
+{
+	// 2.1
+	F_STR("Location", PortableBattery, Location, 0x1a),
+	F_STR("Manufacturer", PortableBattery, Manufacturer, 0x1a),
+	F_STR("Manufacturer Date", PortableBattery, Date, 0x1a),
+	F_STR("Serial Number", PortableBattery, SN, 0x1a),
+	F_STR("Device Name", PortableBattery, DeviceName, 0x1a),
+};
+
+static const SMBIOS_FIELD smbios_fields_23[] =
+{
+	F_BOOL("Watchdog Timer", SysReset, Capabilities, 0x0d, 1 << 5),
+	F_BITS("Boot Option on Limit", SysReset, Capabilities, 0x0d, 0x18, 3, pSysResetCapabilitiesToStr),
+	F_BITS("Boot Option", SysReset, Capabilities, 0x0d, 0x06, 1, pSysResetCapabilitiesToStr),
+	F_BOOL("System Reset Status", SysReset, Capabilities, 0x0d, 0x01),
+	F_DEC("Reset Count", SysReset, ResetCount, 0x0d),
+	F_DEC("Reset Limit", SysReset, ResetLimit, 0x0d),
+	F_DEC("Timer Interval", SysReset, TimerInterval, 0x0d),
+	F_DEC("Timeout", SysReset, Timeout, 0x0d),
+};
+
+static const SMBIOS_FIELD smbios_fields_24[] =
+{
+	F_BITS("Power-on Password", HwSecurity, Settings, 0x05, 0xc0, 6, pHwSecurityStatusToStr),
+	F_BITS("Keyboard Password", HwSecurity, Settings, 0x05, 0x30, 4, pHwSecurityStatusToStr),
+	F_BITS("Administrator Password", HwSecurity, Settings, 0x05, 0x0c, 2, pHwSecurityStatusToStr),
+	F_BITS("Front Panel Reset", HwSecurity, Settings, 0x05, 0x03, 0, pHwSecurityStatusToStr),
+};
+
+static const SMBIOS_FIELD smbios_fields_25[] =
+{
+	F_PROC("Next Scheduled Power-on", SysPowerCtrl, NextPwrOnMonth, 0x09, pNextPowerOn, 0),
+};
+
+static const SMBIOS_FIELD smbios_fields_26[] =
+{
+	F_STR("Probe Description", ProbeInfo, Description, 0x14),
+	F_BITS("Location", ProbeInfo, LocationAndStatus, 0x14, 0x1f, 0, pProbeLocationToStr),
+	F_BITS("Status", ProbeInfo, LocationAndStatus, 0x14, 0xe0, 5, pProbeStatusToStr),
+	F_PROC("Maximum Value (mV)", ProbeInfo, MaxValue, 0x14, pProbeValue, 0),
+	F_PROC("Minimum Value (mV)", ProbeInfo, MinValue, 0x14, pProbeValue, 0),
+	F_PROC("Resolution (0.1 mV)", ProbeInfo, Resolution, 0x14, pProbeValue, 0),
+	F_PROC("Tolerance (mV)", ProbeInfo, Tolerance, 0x14, pProbeValue, 0),
+	F_PROC("Accuracy (0.01%)", ProbeInfo, Accuracy, 0x14, pProbeValue, 0),
+	F_HEX("OEM-defined", ProbeInfo, OEMDefined, 0x14),
+	F_PROC("Nominal Value (mV)", ProbeInfo, NominalValue, 0x16, pProbeValue, 0),
+};
+
+static const SMBIOS_FIELD smbios_fields_27[] =
+{
+	// 2.2
+	F_DEC("Temperature Probe Handle", CoolingDevice, TempProbeHandle, 0x0c),
+	F_BITS("Device Type", CoolingDevice, DeviceTypeAndStatus, 0x0c, 0x1f, 0, pCoolingDevTypeToStr),
+	F_BITS("Status", CoolingDevice, DeviceTypeAndStatus, 0x0c, 0xe0, 5, pProbeStatusToStr),
+	F_DEC("Cooling Unit Group", CoolingDevice, CoolingUnitGroup, 0x0c),
+	F_HEX("OEM-defined", CoolingDevice, OEMDefined, 0x0c),
+	F_PROC("Nominal Speed (RPM)", CoolingDevice, NominalSpeed, 0x0e, pProbeValue, 0),
+	// 2.7
+	F_STR("Device Description", CoolingDevice, Description, 0x0f),
+};
+
+static const SMBIOS_FIELD smbios_fields_28[] =
+{
+	F_STR("Probe Description", ProbeInfo, Description, 0x14),
+	F_BITS("Location", ProbeInfo, LocationAndStatus, 0x14, 0x1f, 0, pProbeLocationToStr),
+	F_BITS("Status", ProbeInfo, LocationAndStatus, 0x14, 0xe0, 5, pProbeStatusToStr),
+	F_PROC("Maximum Value (0.1 C)", ProbeInfo, MaxValue, 0x14, pProbeValue, TRUE),
+	F_PROC("Minimum Value (0.1 C)", ProbeInfo, MinValue, 0x14, pProbeValue, TRUE),
+	F_PROC("Resolution (0.001 C)", ProbeInfo, Resolution, 0x14, pProbeValue, 0),
+	F_PROC("Tolerance (0.1 C)", ProbeInfo, Tolerance, 0x14, pProbeValue, 0),
+	F_PROC("Accuracy (0.01%)", ProbeInfo, Accuracy, 0x14, pProbeValue, 0),
+	F_HEX("OEM-defined", ProbeInfo, OEMDefined, 0x14),
+	F_PROC("Nominal Value (0.1 C)", ProbeInfo, NominalValue, 0x16, pProbeValue, TRUE),
+};
+
+static const SMBIOS_FIELD smbios_fields_29[] =
+{
+	F_STR("Probe Description", ProbeInfo, Description, 0x14),
+	F_BITS("Location", ProbeInfo, LocationAndStatus, 0x14, 0x1f, 0, pProbeLocationToStr),
+	F_BITS("Status", ProbeInfo, LocationAndStatus, 0x14, 0xe0, 5, pProbeStatusToStr),
+	F_PROC("Maximum Value (mA)", ProbeInfo, MaxValue, 0x14, pProbeValue, 0),
+	F_PROC("Minimum Value (mA)", ProbeInfo, MinValue, 0x14, pProbeValue, 0),
+	F_PROC("Resolution (0.1 mA)", ProbeInfo, Resolution, 0x14, pProbeValue, 0),
+	F_PROC("Tolerance (mA)", ProbeInfo, Tolerance, 0x14, pProbeValue, 0),
+	F_PROC("Accuracy (0.01%)", ProbeInfo, Accuracy, 0x14, pProbeValue, 0),
+	F_HEX("OEM-defined", ProbeInfo, OEMDefined, 0x14),
+	F_PROC("Nominal Value (mA)", ProbeInfo, NominalValue, 0x16, pProbeValue, 0),
+};
+
+static const SMBIOS_FIELD smbios_fields_30[] =
+{
+	F_STR("Manufacturer", OutOfBandRemoteAccess, Manufacturer, 0x06),
+	F_BOOL("Outbound Connection Enabled", OutOfBandRemoteAccess, Connections, 0x06, 1 << 1),
+	F_BOOL("Inbound Connection Enabled", OutOfBandRemoteAccess, Connections, 0x06, 1 << 0),
+};
+
+static const SMBIOS_FIELD smbios_fields_32[] =
+{
+	F_ENUM("Boot Status", SysBootInfo, BootStatus, 0x0b, pBootStatusToStr),
+};
+
+static const SMBIOS_FIELD smbios_fields_33[] =
+{
+	// 2.1
+	F_ENUM("Error Type", MemoryErrInfo64, ErrType, 0x17, pMemErrTypeToStr),
+	F_ENUM("Error Granularity", MemoryErrInfo64, ErrGranularity, 0x17, pMemErrGranularityToStr),
+	F_ENUM("Error Operation", MemoryErrInfo64, ErrOperation, 0x17, pMemErrOperationToStr),
+	F_HEX("Vendor Syndrome", MemoryErrInfo64, VendorSyndrome, 0x17),
+	F_HEX("Memory Array Error Address", MemoryErrInfo64, MemArrayErrAddr, 0x17),
+	F_HEX("Device Error Address", MemoryErrInfo64, DevErrAddr, 0x17),
+	F_HEX("Error Resolution", MemoryErrInfo64, ErrResolution, 0x17),
+};
+
+static const SMBIOS_FIELD smbios_fields_34[] =
+{
+	F_STR("Device Description", ManagementDevice, Description, 0x0b),
+	F_ENUM("Type", ManagementDevice, Type, 0x0b, pMgmtDevTypeToStr),
+	F_HEX("Address", ManagementDevice, Address, 0x0b),
+	F_ENUM("Address Type", ManagementDevice, AddressType, 0x0b, pMgmtDevAddrTypeToStr),
+};
+
+static const SMBIOS_FIELD smbios_fields_35[] =
+{
+	F_STR("Component Description", ManagementDeviceComponent, Description, 0x0b),
+	F_DEC("Management Device Handle", ManagementDeviceComponent, ManagementDeviceHandle, 0x0b),
+	F_DEC("Component Handle", ManagementDeviceComponent, ComponentHandle, 0x0b),
+	F_DEC("Threshold Handle", ManagementDeviceComponent, ThresholdHandle, 0x0b),
+};
+
+static const SMBIOS_FIELD smbios_fields_36[] =
+{
+	F_PROC("Lower Non-critical Threshold", ManagementDeviceThreshold, LowerNonCritical, 0x10, pProbeValue, TRUE),
+	F_PROC("Upper Non-critical Threshold", ManagementDeviceThreshold, UpperNonCritical, 0x10, pProbeValue, TRUE),
+	F_PROC("Lower Critical Threshold", ManagementDeviceThreshold, LowerCritical, 0x10, pProbeValue, TRUE),
+	F_PROC("Upper Critical Threshold", ManagementDeviceThreshold, UpperCritical, 0x10, pProbeValue, TRUE),
+	F_PROC("Lower Non-recoverable Threshold", ManagementDeviceThreshold, LowerNonRecoverable, 0x10, pProbeValue, TRUE),
+	F_PROC("Upper Non-recoverable Threshold", ManagementDeviceThreshold, UpperNonRecoverable, 0x10, pProbeValue, TRUE),
+};
+
+static const SMBIOS_FIELD smbios_fields_37[] =
+{
+	F_ENUM("Channel Type", MemoryChannel, ChannelType, 0x07, pMemChannelTypeToStr),
+	F_DEC("Maximum Load", MemoryChannel, MaxLoad, 0x07),
+	F_PROC("Number of Devices", MemoryChannel, DeviceCount, 0x07, pMemChannelDevices, 0),
+};
+
+static const SMBIOS_FIELD smbios_fields_38[] =
+{
+	F_ENUM("Interface Type", IPMIDevice, InterfaceType, 0x10, pIPMIInterfaceTypeToStr),
+	F_PROC("Specification Version", IPMIDevice, SpecRevision, 0x10, pBCDVersion, 0),
+	F_HEX("I2C Target Address", IPMIDevice, I2CTargetAddr, 0x10),
+	F_HEX("NV Storage Device Address", IPMIDevice, NVStorageDevAddr, 0x10),
+	F_HEX("Base Address", IPMIDevice, BaseAddr, 0x10),
+	F_HEX("Base Address Modifier", IPMIDevice, BaseAddrModifier, 0x12),
+	F_DEC("Interrupt Number", IPMIDevice, InterruptNumber, 0x12),
+};
+
+static const SMBIOS_FIELD smbios_fields_39[] =
+{
+	// 2.3.1
+	F_DEC("Power Unit Group", SystemPowerSupply, PowerUnitGroup, 0x10),
+	F_STR("Location", SystemPowerSupply, Location, 0x10),
+	F_STR("Device Name", SystemPowerSupply, DeviceName, 0x10),
+	F_STR("Manufacturer", SystemPowerSupply, Manufacturer, 0x10),
+	F_STR("Serial Number", SystemPowerSupply, SN, 0x10),
+	F_STR("Asset Tag", SystemPowerSupply, AssetTag, 0x10),
+	F_STR("Model Part Number", SystemPowerSupply, ModelPartNum, 0x10),
+	F_STR("Revision Level", SystemPowerSupply, RevisionLevel, 0x10),
+	F_PROC("Max Power Capacity (W)", SystemPowerSupply, MaxPowerCapacity, 0x10, pProbeValue, 0),
+	F_HEX("Power Supply Characteristics", SystemPowerSupply, Characteristics, 0x10),
+	F_BOOL("Hot Replaceable", SystemPowerSupply, Characteristics, 0x10, 1 << 0),
+	F_BOOL("Present", SystemPowerSupply, Characteristics, 0x10, 1 << 1),
+	F_BOOL("Unplugged", SystemPowerSupply, Characteristics, 0x10, 1 << 2),
+	F_DEC("Input Voltage Probe Handle", SystemPowerSupply, InputVoltageProbeHandle, 0x16),
+	F_DEC("Cooling Device Handle", SystemPowerSupply, CoolingDeviceHandle, 0x16),
+	F_DEC("Input Current Probe Handle", SystemPowerSupply, InputCurrentProbeHandle, 0x16),
+};
+
+static const SMBIOS_FIELD smbios_fields_40[] =
+{
+	F_PROC("Number of Entries", AdditionalInfo, NumOfEntries, 0x0b, pAdditionalInfo, 0),
+};
+
+static const SMBIOS_FIELD smbios_fields_41[] =
+{
+	F_STR("Reference Designation", OnBoardDevicesExtInfo, ReferenceDesignation, 0x0b),
+	F_BITS("Device Type", OnBoardDevicesExtInfo, DeviceType, 0x0b, 0x7f, 0, pOnBoardDeviceTypeToStr),
+	F_BOOL("Enabled", OnBoardDevicesExtInfo, DeviceType, 0x0b, 0x80),
+	F_DEC("Device Type Instance", OnBoardDevicesExtInfo, DeviceTypeInstance, 0x0b),
+	F_PROC("Bus Address", OnBoardDevicesExtInfo, SegmentGroupNum, 0x0b, pPciAddress, 0),
+};
+
+static const SMBIOS_FIELD smbios_fields_42[] =
+{
+	F_ENUM("Interface Type", MCHostInterface, InterfaceType, 0x06, pMCHostInterfaceTypeToStr),
+	F_DEC("Interface Data Length", MCHostInterface, InterfaceDataLength, 0x06),
+	F_PROC("Number of Protocol Records", MCHostInterface, InterfaceDataLength, 0x06, pMCHostProtocols, 0),
+};
+
+static const SMBIOS_FIELD smbios_fields_43[] =
+{
+	F_PROC("Vendor", TPMDevice, Vendor, 0x1f, pTPMVendor, 0),
+	F_PROC("Spec Version", TPMDevice, MajorSpecVer, 0x1f, pTPMSpecVersion, 0),
+	F_STR("Description", TPMDevice, Description, 0x1f),
+};
+
+static const SMBIOS_FIELD smbios_fields_44[] =
+{
+	F_DEC("Referenced Handle", ProcessorAdditionalInfo, ReferencedHandle, 0x08),
+	F_DEC("Block Length", ProcessorAdditionalInfo, BlockLength, 0x08),
+	F_ENUM("Processor Type", ProcessorAdditionalInfo, ProcessorType, 0x08, pProcessorArchToStr),
+};
+
+static const SMBIOS_FIELD smbios_fields_45[] =
+{
+	F_STR("Firmware Component Name", FirmwareInventory, ComponentName, 0x18),
+	F_STR("Firmware Version", FirmwareInventory, Version, 0x18),
+	F_ENUM("Version Format", FirmwareInventory, VersionFormat, 0x18, pFwVersionFormatToStr),
+	F_STR("Firmware ID", FirmwareInventory, ID, 0x18),
+	F_ENUM("Firmware ID Format", FirmwareInventory, IDFormat, 0x18, pFwIdFormatToStr),
+	F_STR("Release Date", FirmwareInventory, ReleaseDate, 0x18),
+	F_STR("Manufacturer", FirmwareInventory, Manufacturer, 0x18),
+	F_STR("Lowest Supported Version", FirmwareInventory, LowestSupportedVersion, 0x18),
+	F_PROC("Image Size", FirmwareInventory, ImageSize, 0x18, pFwImageSize, 0),
+	F_BOOL("Updatable", FirmwareInventory, Characteristics, 0x18, 1 << 0),
+	F_BOOL("Write-Protected", FirmwareInventory, Characteristics, 0x18, 1 << 1),
+	F_ENUM("State", FirmwareInventory, State, 0x18, pFwStateToStr),
+	F_PROC("Number of Associated Components", FirmwareInventory, NumOfAssociatedComponents, 0x18, pFwComponents, 0),
+};
+
+static const SMBIOS_FIELD smbios_fields_46[] =
+{
+	F_PROC("String Property ID", StringProperty, PropertyID, 0x09, pStringPropertyID, 0),
+	F_STR("String Property Value", StringProperty, PropertyValue, 0x09),
+	F_DEC("Parent Handle", StringProperty, ParentHandle, 0x09),
+};
+
+static const SMBIOS_TYPE smbios_types[] =
+{
+	SMB_TYPE(0, "BIOS Information", smbios_fields_0),
+	SMB_TYPE(1, "System Information", smbios_fields_1),
+	SMB_TYPE(2, "Base Board Information", smbios_fields_2),
+	SMB_TYPE(3, "System Enclosure Information", smbios_fields_3),
+	SMB_TYPE(4, "Processor Information", smbios_fields_4),
+	SMB_TYPE(5, "Memory Controller Information", smbios_fields_5),
+	SMB_TYPE(6, "Memory Module Information", smbios_fields_6),
+	SMB_TYPE(7, "Cache Information", smbios_fields_7),
+	SMB_TYPE(8, "Port Connector Information", smbios_fields_8),
+	SMB_TYPE(9, "System Slots", smbios_fields_9),
+	SMB_TYPE(10, "On Board Devices Information", smbios_fields_10),
+	SMB_TYPE(11, "OEM String", smbios_fields_11_12),
+	SMB_TYPE(12, "System Configuration Options", smbios_fields_11_12),
+	SMB_TYPE(13, "BIOS Language Information", smbios_fields_13),
+	SMB_TYPE(14, "Group Associations", smbios_fields_14),
+	SMB_TYPE(15, "System Event Log", smbios_fields_15),
+	SMB_TYPE(16, "Memory Array", smbios_fields_16),
+	SMB_TYPE(17, "Memory Device", smbios_fields_17),
+	SMB_TYPE(18, "32-Bit Memory Error Information", smbios_fields_18),
+	SMB_TYPE(19, "Memory Array Mapped Address", smbios_fields_19),
+	SMB_TYPE(20, "Memory Device Mapped Address", smbios_fields_20),
+	SMB_TYPE(21, "Built-in Pointing Device", smbios_fields_21),
+	SMB_TYPE(22, "Portable Battery", smbios_fields_22),
+	SMB_TYPE(23, "System Reset", smbios_fields_23),
+	SMB_TYPE(24, "Hardware Security", smbios_fields_24),
+	SMB_TYPE(25, "System Power Controls", smbios_fields_25),
+	SMB_TYPE(26, "Voltage Probe", smbios_fields_26),
+	SMB_TYPE(27, "Cooling Device", smbios_fields_27),
+	SMB_TYPE(28, "Temperature Probe", smbios_fields_28),
+	SMB_TYPE(29, "Electrical Current Probe", smbios_fields_29),
+	SMB_TYPE(30, "Out-of-Band Remote Access", smbios_fields_30),
+	{ 31, "Boot Integrity Services Entry Point", NULL, 0 },
+	SMB_TYPE(32, "System Boot Information", smbios_fields_32),
+	SMB_TYPE(33, "64-Bit Memory Error Information", smbios_fields_33),
+	SMB_TYPE(34, "Management Device", smbios_fields_34),
+	SMB_TYPE(35, "Management Device Component", smbios_fields_35),
+	SMB_TYPE(36, "Management Device Threshold Data", smbios_fields_36),
+	SMB_TYPE(37, "Memory Channel", smbios_fields_37),
+	SMB_TYPE(38, "IPMI Device Information", smbios_fields_38),
+	SMB_TYPE(39, "System Power Supply", smbios_fields_39),
+	SMB_TYPE(40, "Additional Information", smbios_fields_40),
+	SMB_TYPE(41, "Onboard Devices Extended Information", smbios_fields_41),
+	SMB_TYPE(42, "Management Controller Host Interface", smbios_fields_42),
+	SMB_TYPE(43, "TPM Device", smbios_fields_43),
+	SMB_TYPE(44, "Processor Additional Information", smbios_fields_44),
+	SMB_TYPE(45, "Firmware Inventory Information", smbios_fields_45),
+	SMB_TYPE(46, "String Property", smbios_fields_46),
+	{ 127, "End-of-Table", NULL, 0 },
+};
+
+static const SMBIOS_TYPE* FindSmbiosType(UINT8 Type)
+{
+	UINT i;
+	for (i = 0; i < _countof(smbios_types); i++)
+	{
+		if (smbios_types[i].Type == Type)
+			return &smbios_types[i];
+	}
+	return NULL;
+}
+
+static void DecodeField(PNODE tab, PSMBIOS_ENTRY e, const SMBIOS_FIELD* f)
+{
+	UINT64 value = FieldValue(e, f);
+	switch (f->Kind)
+	{
+	case SMBK_STR:
+		NWL_NodeAttrSet(tab, f->Name, LocateString(e, (UINT)value), 0);
+		break;
+	case SMBK_DEC:
+		if (value || !(f->Flags & SMBF_NONZERO))
+			NWL_NodeAttrSetf(tab, f->Name, NAFLG_FMT_NUMERIC, "%llu", value);
+		break;
+	case SMBK_HEX:
+		NWL_NodeAttrSetf(tab, f->Name, 0, "0x%0*llX", f->Width * 2, value);
+		break;
+	case SMBK_ENUM:
+		NWL_NodeAttrSet(tab, f->Name, f->ToStr((UCHAR)value), 0);
+		break;
+	case SMBK_BOOL:
+		NWL_NodeAttrSetBool(tab, f->Name, value, 0);
+		break;
+	}
+}
+
+#define FILTER_TEST(bitmap, i) ((bitmap)[(i) >> 5] & (1U << ((i) & 31)))
+#define FILTER_SET(bitmap, i) ((bitmap)[(i) >> 5] |= (1U << ((i) & 31)))
+
+// Whole name, case-insensitive. The unit suffix may be left out, "Speed" matches "Speed (MT/s)".
+static BOOL FieldNameMatch(LPCSTR Name, LPCSTR Word, size_t Len)
+{
+	if (_strnicmp(Name, Word, Len) != 0)
+		return FALSE;
+	return Name[Len] == '\0' || strncmp(Name + Len, " (", 2) == 0;
+}
+
+// Select the fields of Type whose name is Word.
+static BOOL SmbiosFilterAddField(PSMBIOS_FILTER filter, UINT8 Type, LPCSTR Word, size_t Len)
+{
+	UINT i;
+	UINT64 mask = 0;
+	const SMBIOS_TYPE* type = FindSmbiosType(Type);
+	if (!type || Len == 0)
+		return FALSE;
+	for (i = 0; i < type->Count && i < 64; i++)
+	{
+		if (FieldNameMatch(type->Fields[i].Name, Word, Len))
+			mask |= 1ULL << i;
+	}
+	if (!mask)
+		return FALSE;
+	if (!FILTER_TEST(filter->Projected, Type))
+	{
+		FILTER_SET(filter->Projected, Type);
+		filter->Fields[Type] = 0;
+	}
+	filter->Fields[Type] |= mask;
+	return TRUE;
+}
+
+// Apply a field name to every type in [first, last], warn if none of them has it.
+static VOID SmbiosFilterAddFields(PSMBIOS_FILTER filter, ULONG first, ULONG last, LPCSTR Word, size_t Len)
+{
+	ULONG i;
+	BOOL found = FALSE;
+	for (i = first; i <= last; i++)
+	{
+		if (FILTER_TEST(filter->Types, i) && SmbiosFilterAddField(filter, (UINT8)i, Word, Len))
+			found = TRUE;
+	}
+	if (!found)
+		fprintf(stderr, "Unknown SMBIOS field: %.*s\n", (int)Len, Word);
+}
+
+// TYPE[-TYPE][:FIELD][,FIELD...][,TYPE...], NULL or 127 selects everything.
+static VOID SmbiosFilterParse(PSMBIOS_FILTER filter, LPCSTR str)
+{
+	BOOL valid = FALSE;
+	ULONG first = 0, last = 0;
+	ZeroMemory(filter, sizeof(SMBIOS_FILTER));
+	memset(filter->Fields, 0xFF, sizeof(filter->Fields));
+	if (!str)
+	{
+		memset(filter->Types, 0xFF, sizeof(filter->Types));
+		return;
+	}
+	while (*str)
+	{
+		size_t len = strcspn(str, ",");
+		if (*str >= '0' && *str <= '9')
+		{
+			char* end;
+			ULONG i;
+			first = last = strtoul(str, &end, 0);
+			if (*end == '-' && end[1] >= '0' && end[1] <= '9')
+				last = strtoul(end + 1, &end, 0);
+			// 127 was the "all types" value of the old numeric option
+			if (first == 127 && last == 127)
+			{
+				first = 0;
+				last = 0xFF;
+			}
+			valid = first <= last && last <= 0xFF
+				&& (end == str + len || (*end == ':' && end + 1 < str + len));
+			if (valid)
+			{
+				for (i = first; i <= last; i++)
+					FILTER_SET(filter->Types, i);
+				if (*end == ':')
+					SmbiosFilterAddFields(filter, first, last, end + 1, str + len - end - 1);
+			}
+			else
+				fprintf(stderr, "Invalid SMBIOS type: %.*s\n", (int)len, str);
+		}
+		else if (valid && len > 0)
+			SmbiosFilterAddFields(filter, first, last, str, len);
+		else if (len > 0)
+			fprintf(stderr, "SMBIOS field without a type: %.*s\n", (int)len, str);
+		str += len;
+		if (*str == ',')
+			str++;
+	}
 }
 
-static void ProcEndTable(PNODE tab, void* p)
+static void DecodeSMBIOSStruct(PNODE tab, PSMBIOS_ENTRY e, UINT64 Fields)
 {
-	NWL_NodeAttrSet(tab, "Description", "End-of-Table", 0);
+	UINT i;
+	const SMBIOS_TYPE* type = FindSmbiosType(e->Header->Type);
+	if (!type)
+		return;
+	NWL_NodeAttrSet(tab, "Description", type->Description, 0);
+	for (i = 0; i < type->Count; i++)
+	{
+		const SMBIOS_FIELD* f = &type->Fields[i];
+		if (e->Header->Length < f->MinLength || !FieldFits(e, f->Offset, f->Width))
+			break;
+		if (i < 64 && !(Fields & (1ULL << i)))
+			continue;
+		if (f->Kind == SMBK_PROC)
+		{
+			if (!f->Proc(tab, e, f))
+				break;
+		}
+		else
+			DecodeField(tab, e, f);
+	}
 }
 
-static void DumpSMBIOSStruct(PNODE node, void* Addr, UINT Len, UINT8 Type)
+static void DumpSMBIOSStruct(PNODE node, PSMBIOS_INDEX idx, PSMBIOS_FILTER filter)
 {
-	LPBYTE p = (LPBYTE)(Addr);
-	const LPBYTE lastAddress = p + Len;
+	UINT32 i;
 	PSMBIOSHEADER pHeader;
 	PNODE tab;
 
-	for (;;) {
-		pHeader = (PSMBIOSHEADER)p;
-		if (Type != 127 && pHeader->Type != Type)
-			goto next_table;
+	for (i = 0; i < idx->Count; i++)
+	{
+		pHeader = idx->Entries[i].Header;
+		if (!FILTER_TEST(filter->Types, pHeader->Type))
+			continue;
 		tab = NWL_NodeAppendNew(node, "Table", NFLG_TABLE_ROW);
 		NWL_NodeAttrSetf(tab, "Table Type", NAFLG_FMT_NUMERIC, "%u", pHeader->Type);
 		NWL_NodeAttrSetf(tab, "Table Length", NAFLG_FMT_NUMERIC, "%u", pHeader->Length);
 		NWL_NodeAttrSetf(tab, "Table Handle", NAFLG_FMT_NUMERIC, "%u", pHeader->Handle);
-		switch (pHeader->Type)
+		DecodeSMBIOSStruct(tab, &idx->Entries[i], filter->Fields[pHeader->Type]);
+	}
+}
+
+#define MEM_TOPO_MAX_CHANNELS 32
+
+#define IS_DIGIT(c) ((c) >= '0' && (c) <= '9')
+#define IS_ALPHA(c) (((c) >= 'a' && (c) <= 'z') || ((c) >= 'A' && (c) <= 'Z'))
+#define IS_ALNUM(c) (IS_DIGIT(c) || IS_ALPHA(c))
+
+typedef struct _MEM_CHANNEL
+{
+	CHAR Name[8];
+	UINT Slots;
+	UINT Populated;
+	UINT64 Size;
+	UINT Speed;		// lowest configured speed of the populated devices
+	UINT Width;		// data width in bits
+} MEM_CHANNEL;
+
+static LPCSTR StrFindI(LPCSTR Str, LPCSTR Word)
+{
+	size_t len = strlen(Word);
+	for (; *Str; Str++)
+	{
+		if (_strnicmp(Str, Word, len) == 0)
+			return Str + len;
+	}
+	return NULL;
+}
+
+static BOOL CopyChannelName(CHAR* Name, LPCSTR p)
+{
+	size_t i;
+	while (*p == ' ' || *p == '_' || *p == '-' || *p == ':' || *p == '#')
+		p++;
+	for (i = 0; i < 7 && IS_ALNUM(p[i]); i++)
+		Name[i] = (p[i] >= 'a' && p[i] <= 'z') ? p[i] - 'a' + 'A' : p[i];
+	Name[i] = '\0';
+	return i > 0;
+}
+
+// Channels are only named in the locator strings, e.g. "ChannelA-DIMM0",
+// "P0 CHANNEL A", "DIMM_A1" or "CPU1_A2". Fall back to the bank locator.
+static VOID MDGetChannel(PSMBIOS_ENTRY e, CHAR* Name)
+{
+	PMemoryDevice pMD = (PMemoryDevice)e->Header;
+	LPCSTR bank = LocateString(e, pMD->BankLocator);
+	LPCSTR dev = LocateString(e, pMD->DeviceLocator);
+	LPCSTR p;
+
+	if ((p = StrFindI(dev, "CHANNEL")) != NULL && CopyChannelName(Name, p))
+		return;
+	if ((p = StrFindI(bank, "CHANNEL")) != NULL && CopyChannelName(Name, p))
+		return;
+	if ((p = StrFindI(dev, "DIMM")) != NULL)
+	{
+		while (*p == ' ' || *p == '_' || *p == '-')
+			p++;
+		if (IS_ALPHA(p[0]) && IS_DIGIT(p[1]))
 		{
-		case 0:
-			ProcBIOSInfo(tab, pHeader);
-			break;
-		case 1:
-			ProcSysInfo(tab, pHeader);
-			break;
-		case 2:
-			ProcBoardInfo(tab, pHeader);
-			break;
-		case 3:
-			ProcSystemEnclosure(tab, pHeader);
-			break;
-		case 4:
-			ProcProcessorInfo(tab, pHeader);
-			break;
-		case 5:
-			ProcMemCtrlInfo(tab, pHeader);
-			break;
-		case 6:
-			ProcMemModuleInfo(tab, pHeader);
-			break;
-		case 7:
-			ProcCacheInfo(tab, pHeader);
-			break;
-		case 8:
-			ProcPortConnectInfo(tab, pHeader);
-			break;
-		case 9:
-			ProcPSystemSlots(tab, pHeader);
-			break;
-		case 10:
-			ProcOnBoardDevInfo(tab, pHeader);
-			break;
-		case 11:
-			ProcOEMString(tab, pHeader);
-			break;
-		case 12:
-			ProcSysConfOptions(tab, pHeader);
-			break;
-		case 13:
-			ProcBIOSLangInfo(tab, pHeader);
-			break;
-		case 14:
-			ProcGroupAssoc(tab, pHeader);
-			break;
-		case 15:
-			ProcSystemEventLog(tab, pHeader);
-			break;
-		case 16:
-			ProcMemoryArray(tab, pHeader);
-			break;
-		case 17:
-			ProcMemoryDevice(tab, pHeader);
-			break;
-		case 18:
-			ProcMemoryErrInfo(tab, pHeader);
-			break;
-		case 19:
-			ProcMemoryArrayMappedAddress(tab, pHeader);
-			break;
-		case 20:
-			ProcMemoryDeviceMappedAddress(tab, pHeader);
-			break;
-		case 21:
-			ProcBuiltinPointing(tab, pHeader);
-			break;
-		case 22:
-			ProcPortableBattery(tab, pHeader);
-			break;
-		case 23:
-			ProcSysReset(tab, pHeader);
-			break;
-		case 24:
-			ProcHwSecurity(tab, pHeader);
-			break;
-		case 25:
-			ProcSysPowerCtrl(tab, pHeader);
-			break;
-		case 30:
-			ProcOutOfBandRemoteAccess(tab, pHeader);
-			break;
-		case 31:
-			ProcBISEntryPoint(tab, pHeader);
-			break;
-		case 32:
-			ProcSysBootInfo(tab, pHeader);
-			break;
-		case 33:
-			ProcMemoryErrInfo64(tab, pHeader);
-			break;
-		case 43:
-			ProcTPMDevice(tab, pHeader);
-			break;
-		case 127:
-			ProcEndTable(tab, pHeader);
-			break;
-		default:
-			break;
+			Name[0] = (p[0] >= 'a' && p[0] <= 'z') ? p[0] - 'a' + 'A' : p[0];
+			Name[1] = '\0';
+			return;
 		}
-	next_table:
-		if ((pHeader->Type == 127) && (pHeader->Length == 4))
-			break; // last avaiable tables
-		LPBYTE nt = p + pHeader->Length; // point to struct end
-		while (0 != (*nt | *(nt + 1))) nt++; // skip string area
-		nt += 2;
-		if (nt >= lastAddress)
+	}
+	// last token of the form <letter><digits>
+	for (p = dev + strlen(dev); p > dev; p--)
+	{
+		if (IS_ALNUM(p[-1]))
+			continue;
+		break;
+	}
+	if (IS_ALPHA(p[0]) && IS_DIGIT(p[1]))
+	{
+		Name[0] = (p[0] >= 'a' && p[0] <= 'z') ? p[0] - 'a' + 'A' : p[0];
+		Name[1] = '\0';
+		return;
+	}
+	strncpy_s(Name, 8, bank, _TRUNCATE);
+}
+
+static MEM_CHANNEL* MemTopoChannel(MEM_CHANNEL* Channels, UINT* Count, LPCSTR Name)
+{
+	UINT i;
+	for (i = 0; i < *Count; i++)
+	{
+		if (strcmp(Channels[i].Name, Name) == 0)
+			return &Channels[i];
+	}
+	if (*Count >= MEM_TOPO_MAX_CHANNELS)
+		return NULL;
+	ZeroMemory(&Channels[*Count], sizeof(MEM_CHANNEL));
+	strcpy_s(Channels[*Count].Name, sizeof(Channels[*Count].Name), Name);
+	return &Channels[(*Count)++];
+}
+
+// Bytes mapped by the type 19 ranges of an array.
+static UINT64 MemTopoMappedSize(PSMBIOS_INDEX idx, WORD Handle)
+{
+	UINT32 i;
+	UINT64 sz = 0;
+	for (i = idx->TypeFirst[19]; i < idx->Count; i = idx->Entries[i].NextOfType)
+	{
+		PMemoryArrayMappedAddress pMAMA = (PMemoryArrayMappedAddress)idx->Entries[i].Header;
+		if (pMAMA->Header.Length < 0x0f || pMAMA->Handle != Handle)
+			continue;
+		if (pMAMA->StartAddr == 0xFFFFFFFF && pMAMA->Header.Length >= 0x1f)
+		{
+			if (pMAMA->ExtEndAddr >= pMAMA->ExtStartAddr)
+				sz += pMAMA->ExtEndAddr - pMAMA->ExtStartAddr + 1;
+		}
+		else if (pMAMA->EndAddr >= pMAMA->StartAddr)
+			sz += ((UINT64)pMAMA->EndAddr - pMAMA->StartAddr + 1) * 1024;
+	}
+	return sz;
+}
+
+static VOID MemTopoDeviceRange(PNODE p, PSMBIOS_INDEX idx, WORD Handle)
+{
+	UINT32 i;
+	for (i = idx->TypeFirst[20]; i < idx->Count; i = idx->Entries[i].NextOfType)
+	{
+		PMemoryDeviceMappedAddress pMDMA = (PMemoryDeviceMappedAddress)idx->Entries[i].Header;
+		BOOL ext;
+		if (pMDMA->Header.Length < 0x13 || pMDMA->MDHandle != Handle)
+			continue;
+		ext = (pMDMA->StartAddr == 0xFFFFFFFF && pMDMA->Header.Length >= 0x23);
+		NWL_NodeAttrSetf(p, "Starting Address", 0, "0x%016llX",
+			ext ? pMDMA->ExtStartAddr : (UINT64)pMDMA->StartAddr * 1024);
+		NWL_NodeAttrSetf(p, "Ending Address", 0, "0x%016llX",
+			ext ? pMDMA->ExtEndAddr : (UINT64)pMDMA->EndAddr * 1024 + 1023);
+		break;
+	}
+}
+
+// Decimal megabytes per second, transfers/s times bus width in bytes.
+static UINT64 MemTopoBandwidth(UINT Speed, UINT Width)
+{
+	return (UINT64)Speed * (Width / 8);
+}
+
+// Correlate the devices of one array, Array is NULL for orphan devices.
+static UINT64 MemTopoArray(PNODE narr, PSMBIOS_INDEX idx, PSMBIOS_ENTRY Array)
+{
+	UINT32 i;
+	UINT ch, count = 0, slots = 0, populated = 0, populatedChannels = 0;
+	UINT maxSpeed = 0, cfgSpeed = 0;
+	UINT64 installed = 0, bandwidth = 0, chSize = 0;
+	BOOL unbalanced = FALSE;
+	CHAR warn[128];
+	NWL_STRBUF sb;
+	MEM_CHANNEL channels[MEM_TOPO_MAX_CHANNELS];
+	PNODE tab, ndev, nch;
+	PMemoryArray pMA = Array ? (PMemoryArray)Array->Header : NULL;
+
+	if (pMA)
+	{
+		NWL_NodeAttrSetf(narr, "Array Handle", NAFLG_FMT_NUMERIC, "%u", pMA->Header.Handle);
+		NWL_NodeAttrSet(narr, "Location", pMALocationToStr(pMA->Location), 0);
+		NWL_NodeAttrSetf(narr, "Number of Slots", NAFLG_FMT_NUMERIC, "%u", pMA->NumOfMDs);
+		NWL_NodeAttrSet(narr, "Mapped Size",
+			NWL_GetHumanSize(MemTopoMappedSize(idx, pMA->Header.Handle), mem_human_sizes, 1024), NAFLG_FMT_HUMAN_SIZE);
+	}
+	ndev = NWL_NodeAppendNew(narr, "Devices", NFLG_TABLE);
+	for (i = idx->TypeFirst[17]; i < idx->Count; i = idx->Entries[i].NextOfType)
+	{
+		PSMBIOS_ENTRY e = &idx->Entries[i];
+		PMemoryDevice pMD = (PMemoryDevice)e->Header;
+		MEM_CHANNEL* c;
+		CHAR name[8];
+		UINT64 sz;
+		UINT speed, rated, width;
+		if (pMD->Header.Length < 0x15)
+			continue;
+		if (pMA ? pMD->PhysicalArrayHandle != pMA->Header.Handle
+			: ResolveHandle(pMD->PhysicalArrayHandle, 16) != NULL)
+			continue;
+		slots++;
+		MDGetChannel(e, name);
+		c = MemTopoChannel(channels, &count, name);
+		if (c)
+			c->Slots++;
+		sz = MDGetSize(e);
+		if (!sz)
+			continue;
+		rated = MDGetSpeed(e, FALSE);
+		speed = MDGetSpeed(e, TRUE);
+		if (!speed)
+			speed = rated;
+		width = (pMD->DataWidth && pMD->DataWidth != 0xFFFF) ? pMD->DataWidth : 64;
+		populated++;
+		installed += sz;
+		if (rated > maxSpeed)
+			maxSpeed = rated;
+		if (speed && (!cfgSpeed || speed < cfgSpeed))
+			cfgSpeed = speed;
+		if (c)
+		{
+			c->Populated++;
+			c->Size += sz;
+			if (speed && (!c->Speed || speed < c->Speed))
+				c->Speed = speed;
+			if (width > c->Width)
+				c->Width = width;
+		}
+		tab = NWL_NodeAppendNew(ndev, "Device", NFLG_TABLE_ROW);
+		NWL_NodeAttrSet(tab, "Device Locator", LocateString(e, pMD->DeviceLocator), 0);
+		NWL_NodeAttrSet(tab, "Bank Locator", LocateString(e, pMD->BankLocator), 0);
+		NWL_NodeAttrSet(tab, "Channel", name, 0);
+		NWL_NodeAttrSet(tab, "Size", NWL_GetHumanSize(sz, mem_human_sizes, 1024), NAFLG_FMT_HUMAN_SIZE);
+		if (rated)
+			NWL_NodeAttrSetf(tab, "Speed (MT/s)", NAFLG_FMT_NUMERIC, "%u", rated);
+		if (speed)
+			NWL_NodeAttrSetf(tab, "Configured Speed (MT/s)", NAFLG_FMT_NUMERIC, "%u", speed);
+		MemTopoDeviceRange(tab, idx, pMD->Header.Handle);
+	}
+
+	nch = NWL_NodeAppendNew(narr, "Channels", NFLG_TABLE);
+	for (ch = 0; ch < count; ch++)
+	{
+		MEM_CHANNEL* c = &channels[ch];
+		UINT64 bw = MemTopoBandwidth(c->Speed, c->Width);
+		tab = NWL_NodeAppendNew(nch, "Channel", NFLG_TABLE_ROW);
+		NWL_NodeAttrSet(tab, "Channel", c->Name, 0);
+		NWL_NodeAttrSetf(tab, "Slots", NAFLG_FMT_NUMERIC, "%u", c->Slots);
+		NWL_NodeAttrSetf(tab, "Populated Slots", NAFLG_FMT_NUMERIC, "%u", c->Populated);
+		if (!c->Populated)
+			continue;
+		NWL_NodeAttrSet(tab, "Size", NWL_GetHumanSize(c->Size, mem_human_sizes, 1024), NAFLG_FMT_HUMAN_SIZE);
+		NWL_NodeAttrSetf(tab, "Data Width (bits)", NAFLG_FMT_NUMERIC, "%u", c->Width);
+		if (bw)
+			NWL_NodeAttrSetf(tab, "Peak Bandwidth (MB/s)", NAFLG_FMT_NUMERIC, "%llu", bw);
+		if (populatedChannels++ == 0)
+			chSize = c->Size;
+		else if (c->Size != chSize)
+			unbalanced = TRUE;
+		bandwidth += bw;
+	}
+
+	NWL_NodeAttrSetf(narr, "Populated Slots", 0, "%u/%u", populated, slots);
+	NWL_NodeAttrSet(narr, "Installed Size", NWL_GetHumanSize(installed, mem_human_sizes, 1024), NAFLG_FMT_HUMAN_SIZE);
+	NWL_NodeAttrSetf(narr, "Populated Channels", 0, "%u/%u", populatedChannels, count);
+	if (maxSpeed)
+		NWL_NodeAttrSetf(narr, "Max Speed (MT/s)", NAFLG_FMT_NUMERIC, "%u", maxSpeed);
+	if (cfgSpeed)
+		NWL_NodeAttrSetf(narr, "Configured Speed (MT/s)", NAFLG_FMT_NUMERIC, "%u", cfgSpeed);
+	NWL_NodeAttrSetf(narr, "Peak Bandwidth (MB/s)", NAFLG_FMT_NUMERIC, "%llu", bandwidth);
+	if (!populated)
+		return 0;
+	NWL_StrBufInit(&sb, warn, sizeof(warn));
+	if (populatedChannels == 1)
+		NWL_StrBufAppendf(&sb, "%sSingle channel", sb.Len ? ", " : "");
+	else if (populatedChannels < count)
+		NWL_StrBufAppendf(&sb, "%sEmpty channels", sb.Len ? ", " : "");
+	if (unbalanced)
+		NWL_StrBufAppendf(&sb, "%sUnbalanced channel capacity", sb.Len ? ", " : "");
+	if (cfgSpeed && maxSpeed && cfgSpeed < maxSpeed)
+		NWL_StrBufAppendf(&sb, "%sBelow rated speed", sb.Len ? ", " : "");
+	NWL_NodeAttrSetBool(narr, "Balanced", !unbalanced && populatedChannels == count, 0);
+	if (sb.Len)
+		NWL_NodeAttrSet(narr, "Warning", sb.Buf, 0);
+	return bandwidth;
+}
+
+static void DumpMemoryTopology(PNODE node, PSMBIOS_INDEX idx)
+{
+	UINT32 i;
+	UINT arrays = 0;
+	UINT64 bandwidth = 0;
+	PNODE topo = NWL_NodeAppendNew(node, "Memory Topology", NFLG_TABLE_ROW);
+	PNODE narrs = NWL_NodeAppendNew(topo, "Memory Arrays", NFLG_TABLE);
+
+	for (i = idx->TypeFirst[16]; i < idx->Count; i = idx->Entries[i].NextOfType)
+	{
+		PMemoryArray pMA = (PMemoryArray)idx->Entries[i].Header;
+		// system memory only
+		if (pMA->Header.Length < 0x0f || pMA->Use != 0x03)
+			continue;
+		bandwidth += MemTopoArray(NWL_NodeAppendNew(narrs, "Memory Array", NFLG_TABLE_ROW), idx, &idx->Entries[i]);
+		arrays++;
+	}
+	for (i = idx->TypeFirst[17]; i < idx->Count; i = idx->Entries[i].NextOfType)
+	{
+		PMemoryDevice pMD = (PMemoryDevice)idx->Entries[i].Header;
+		if (pMD->Header.Length >= 0x15 && ResolveHandle(pMD->PhysicalArrayHandle, 16) == NULL)
+		{
+			bandwidth += MemTopoArray(NWL_NodeAppendNew(narrs, "Memory Array", NFLG_TABLE_ROW), idx, NULL);
+			arrays++;
 			break;
-		p = nt;
+		}
 	}
+	NWL_NodeAttrSetf(topo, "Number of Arrays", NAFLG_FMT_NUMERIC, "%u", arrays);
+	NWL_NodeAttrSetf(topo, "Peak Bandwidth (MB/s)", NAFLG_FMT_NUMERIC, "%llu", bandwidth);
 }
 
 PNODE NW_Smbios(VOID)
 {
 	DWORD smBiosDataSize = 0;
 	struct RAW_SMBIOS_DATA* smBiosData = NULL;
+	SMBIOS_INDEX idx;
+	SMBIOS_FILTER filter;
 	PNODE node = NWL_NodeAlloc("SMBIOS", NFLG_TABLE);
 	PNODE info = NWL_NodeAppendNew(node, "DMI", NFLG_TABLE_ROW);
 	if (NWLC->DmiInfo)
@@ -1509,6 +2677,16 @@ PNODE NW_Smbios(VOID)
 	NWL_NodeAttrSetf(info, "SMBIOS Version", 0, "%u.%u", smBiosData->MajorVersion, smBiosData->MinorVersion);
 	if (smBiosData->DmiRevision)
 		NWL_NodeAttrSetf(info, "DMI Version", NAFLG_FMT_NUMERIC, "%u", smBiosData->DmiRevision);
-	DumpSMBIOSStruct(node, smBiosData->Data, smBiosData->Length, NWLC->SmbiosType);
+	if (SmbiosIndexBuild(&idx, smBiosData->Data, smBiosData->Length))
+	{
+		smbios_index = &idx;
+		SmbiosFilterParse(&filter, NWLC->SmbiosType);
+		DumpSMBIOSStruct(node, &idx, &filter);
+		if (FILTER_TEST(filter.Types, 17) && !FILTER_TEST(filter.Projected, 17))
+			DumpMemoryTopology(node, &idx);
+		smbios_index = NULL;
+		SmbiosIndexFree(&idx);
+	}
+	free(smBiosData);
 	return node;
 }
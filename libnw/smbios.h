@@ -301,6 +301,24 @@ typedef struct _TYPE_17_
 	UCHAR AssetTag;
 	UCHAR PN;
 	UCHAR Attributes;
+	UINT32 ExtendedSize;
+	UINT16 ConfiguredSpeed;
+	UINT16 MinimumVoltage;
+	UINT16 MaximumVoltage;
+	UINT16 ConfiguredVoltage;
+	UCHAR MemoryTechnology;
+	UINT16 OperatingModeCapability;
+	UCHAR FirmwareVersion;
+	UINT16 ModuleManufacturerID;
+	UINT16 ModuleProductID;
+	UINT16 SubsystemControllerManufacturerID;
+	UINT16 SubsystemControllerProductID;
+	UINT64 NonVolatileSize;
+	UINT64 VolatileSize;
+	UINT64 CacheSize;
+	UINT64 LogicalSize;
+	UINT32 ExtendedSpeed;
+	UINT32 ExtendedConfiguredSpeed;
 } MemoryDevice, * PMemoryDevice;
 
 typedef struct _TYPE_18_
@@ -394,6 +412,31 @@ typedef struct _TYPE_25_
 	UCHAR NextPwrOnSecond;
 } SysPowerCtrl, * PSysPowerCtrl;
 
+typedef struct _TYPE_26_28_29_
+{
+	SMBIOSHEADER Header;
+	UCHAR Description;
+	UCHAR LocationAndStatus;
+	UINT16 MaxValue;
+	UINT16 MinValue;
+	UINT16 Resolution;
+	UINT16 Tolerance;
+	UINT16 Accuracy;
+	DWORD OEMDefined;
+	UINT16 NominalValue;
+} ProbeInfo, * PProbeInfo;
+
+typedef struct _TYPE_27_
+{
+	SMBIOSHEADER Header;
+	UINT16 TempProbeHandle;
+	UCHAR DeviceTypeAndStatus;
+	UCHAR CoolingUnitGroup;
+	DWORD OEMDefined;
+	UINT16 NominalSpeed;
+	UCHAR Description;
+} CoolingDevice, * PCoolingDevice;
+
 typedef struct _TYPE_30_
 {
 	SMBIOSHEADER Header;
@@ -410,7 +453,8 @@ typedef struct _TYPE_32_
 {
 	SMBIOSHEADER Header;
 	UCHAR Reserved[6];
-	UCHAR BootStatus[];
+	UCHAR BootStatus;
+	UCHAR AdditionalData[];
 } SysBootInfo, * PSysBootInfo;
 
 typedef struct _TYPE_33_
@@ -425,6 +469,113 @@ typedef struct _TYPE_33_
 	DWORD ErrResolution;
 } MemoryErrInfo64, * PMemoryErrInfo64;
 
+typedef struct _TYPE_34_
+{
+	SMBIOSHEADER Header;
+	UCHAR Description;
+	UCHAR Type;
+	DWORD Address;
+	UCHAR AddressType;
+} ManagementDevice, * PManagementDevice;
+
+typedef struct _TYPE_35_
+{
+	SMBIOSHEADER Header;
+	UCHAR Description;
+	UINT16 ManagementDeviceHandle;
+	UINT16 ComponentHandle;
+	UINT16 ThresholdHandle;
+} ManagementDeviceComponent, * PManagementDeviceComponent;
+
+typedef struct _TYPE_36_
+{
+	SMBIOSHEADER Header;
+	UINT16 LowerNonCritical;
+	UINT16 UpperNonCritical;
+	UINT16 LowerCritical;
+	UINT16 UpperCritical;
+	UINT16 LowerNonRecoverable;
+	UINT16 UpperNonRecoverable;
+} ManagementDeviceThreshold, * PManagementDeviceThreshold;
+
+typedef struct _TYPE_37_
+{
+	SMBIOSHEADER Header;
+	UCHAR ChannelType;
+	UCHAR MaxLoad;
+	UCHAR DeviceCount;
+	struct _TYPE_37_DEVICE
+	{
+		UCHAR Load;
+		UINT16 Handle;
+	} Devices[];
+} MemoryChannel, * PMemoryChannel;
+
+typedef struct _TYPE_38_
+{
+	SMBIOSHEADER Header;
+	UCHAR InterfaceType;
+	UCHAR SpecRevision;
+	UCHAR I2CTargetAddr;
+	UCHAR NVStorageDevAddr;
+	UINT64 BaseAddr;
+	UCHAR BaseAddrModifier;
+	UCHAR InterruptNumber;
+} IPMIDevice, * PIPMIDevice;
+
+typedef struct _TYPE_39_
+{
+	SMBIOSHEADER Header;
+	UCHAR PowerUnitGroup;
+	UCHAR Location;
+	UCHAR DeviceName;
+	UCHAR Manufacturer;
+	UCHAR SN;
+	UCHAR AssetTag;
+	UCHAR ModelPartNum;
+	UCHAR RevisionLevel;
+	UINT16 MaxPowerCapacity;
+	UINT16 Characteristics;
+	UINT16 InputVoltageProbeHandle;
+	UINT16 CoolingDeviceHandle;
+	UINT16 InputCurrentProbeHandle;
+} SystemPowerSupply, * PSystemPowerSupply;
+
+typedef struct _TYPE_40_ENTRY_
+{
+	UCHAR EntryLength;
+	UINT16 ReferencedHandle;
+	UCHAR ReferencedOffset;
+	UCHAR String;
+	UCHAR Value[];
+} AdditionalInfoEntry, * PAdditionalInfoEntry;
+
+typedef struct _TYPE_40_
+{
+	SMBIOSHEADER Header;
+	UCHAR NumOfEntries;
+	UCHAR Entries[]; // variable-length AdditionalInfoEntry
+} AdditionalInfo, * PAdditionalInfo;
+
+typedef struct _TYPE_41_
+{
+	SMBIOSHEADER Header;
+	UCHAR ReferenceDesignation;
+	UCHAR DeviceType;
+	UCHAR DeviceTypeInstance;
+	UINT16 SegmentGroupNum;
+	UCHAR BusNum;
+	UCHAR DevFuncNum;
+} OnBoardDevicesExtInfo, * POnBoardDevicesExtInfo;
+
+typedef struct _TYPE_42_
+{
+	SMBIOSHEADER Header;
+	UCHAR InterfaceType;
+	UCHAR InterfaceDataLength;
+	UCHAR InterfaceData[];
+} MCHostInterface, * PMCHostInterface;
+
 typedef struct _TYPE_43_
 {
 	SMBIOSHEADER Header;
@@ -438,4 +589,72 @@ typedef struct _TYPE_43_
 	DWORD OEM;
 } TPMDevice, * PTPMDevice;
 
+typedef struct _TYPE_44_
+{
+	SMBIOSHEADER Header;
+	UINT16 ReferencedHandle;
+	UCHAR BlockLength;
+	UCHAR ProcessorType;
+	UCHAR ProcessorData[];
+} ProcessorAdditionalInfo, * PProcessorAdditionalInfo;
+
+typedef struct _TYPE_45_
+{
+	SMBIOSHEADER Header;
+	UCHAR ComponentName;
+	UCHAR Version;
+	UCHAR VersionFormat;
+	UCHAR ID;
+	UCHAR IDFormat;
+	UCHAR ReleaseDate;
+	UCHAR Manufacturer;
+	UCHAR LowestSupportedVersion;
+	UINT64 ImageSize;
+	UINT16 Characteristics;
+	UCHAR State;
+	UCHAR NumOfAssociatedComponents;
+	UINT16 AssociatedComponentHandles[];
+} FirmwareInventory, * PFirmwareInventory;
+
+typedef struct _TYPE_46_
+{
+	SMBIOSHEADER Header;
+	UINT16 PropertyID;
+	UCHAR PropertyValue;
+	UINT16 ParentHandle;
+} StringProperty, * PStringProperty;
+
 #pragma pack()
+
+#define SMBIOS_INDEX_NONE 0xFFFFFFFFU
+
+typedef struct _SMBIOS_ENTRY
+{
+	PSMBIOSHEADER Header;
+	const char* Strings;	// start of the string-set following the formatted area
+	UINT32* StrOffsets;		// offset of each string from Strings
+	UINT32 StrFirst;		// first slot in SMBIOS_INDEX.StrPool
+	UINT32 StrCount;
+	UINT32 NextOfType;		// next entry with the same type, or SMBIOS_INDEX_NONE
+} SMBIOS_ENTRY, *PSMBIOS_ENTRY;
+
+typedef struct _SMBIOS_INDEX
+{
+	UINT32 Count;
+	UINT32 Capacity;
+	PSMBIOS_ENTRY Entries;	// structures in table order
+	UINT32 TypeFirst[256];
+	UINT32 TypeLast[256];
+	UINT32 HashMask;
+	UINT32* Hash;			// handle -> entry index, open addressing
+	UINT32 StrPoolCount;
+	UINT32 StrPoolCapacity;
+	UINT32* StrPool;		// string offsets of all structures
+} SMBIOS_INDEX, *PSMBIOS_INDEX;
+
+typedef struct _SMBIOS_FILTER
+{
+	UINT32 Types[8];		// bitmap of selected structure types
+	UINT32 Projected[8];	// bitmap of types restricted to Fields
+	UINT64 Fields[256];		// bitmap of selected schema fields per type
+} SMBIOS_FILTER, *PSMBIOS_FILTER;
@@ -4,6 +4,7 @@
 #include <winring0.h>
 #include "libnw.h"
 #include "utils.h"
+#include "acpi.h"
 #include "spd.h"
 
 #define PCI_CONF_TYPE_NONE 0
@@ -61,6 +62,16 @@ static unsigned char pci_conf_type = PCI_CONF_TYPE_NONE;
 #define PCI_CONF3_ADDRESS(bus, dev, fn, reg) \
 	(0x80000000 | (((reg >> 8) & 0xF) << 24) | (bus << 16) | ((dev & 0x1F) << 11) | (fn << 8) | (reg & 0xFF))
 
+#define PCI_ECAM_PAGE_SIZE 4096
+#define PCI_ECAM_OFFSET(bus, dev, fn) \
+	(((UINT64)(bus) << 20) | ((UINT64)(dev) << 15) | ((UINT64)(fn) << 12))
+
+/* ECAM window of segment 0 from MCFG, one 4 KB config page is cached at a time. */
+static UINT64 ecam_base = 0;
+static unsigned ecam_start_bus = 0, ecam_end_bus = 0;
+static unsigned char ecam_page[PCI_ECAM_PAGE_SIZE];
+static int ecam_bdf = -1;
+
 static void usleep(unsigned int usec)
 {
 	HANDLE timer;
@@ -76,11 +87,80 @@ static void usleep(unsigned int usec)
 	CloseHandle(timer);
 }
 
+static int
+pci_check_ecam(void)
+{
+	UINT32 i, count;
+	struct acpi_mcfg* mcfg = NWL_GetAcpi('GFCM');
+	ecam_base = 0;
+	ecam_bdf = -1;
+	if (!mcfg || mcfg->header.length < sizeof(struct acpi_mcfg))
+		return -1;
+	count = (mcfg->header.length - sizeof(struct acpi_mcfg)) / sizeof(struct acpi_mcfg_alloc);
+	for (i = 0; i < count; i++) {
+		if (mcfg->entry[i].segment != 0 || mcfg->entry[i].start_bus != 0 || mcfg->entry[i].base_addr == 0)
+			continue;
+		/* The window must be addressable by phymem_read, i.e. below 4 GB on x86 builds */
+		if (mcfg->entry[i].base_addr + PCI_ECAM_OFFSET(mcfg->entry[i].end_bus + 1, 0, 0) - 1 > (UINT64)MAXULONG_PTR)
+			continue;
+		ecam_base = mcfg->entry[i].base_addr;
+		ecam_start_bus = mcfg->entry[i].start_bus;
+		ecam_end_bus = mcfg->entry[i].end_bus;
+		return 0;
+	}
+	return -1;
+}
+
+/* Fetch the whole config page with a single driver call, later reads are plain loads. */
+static unsigned char*
+pci_ecam_map(unsigned bus, unsigned dev, unsigned fn)
+{
+	int bdf = (bus << 8) | (dev << 3) | fn;
+	if (ecam_bdf == bdf)
+		return ecam_page;
+	ecam_bdf = -1;
+	if (phymem_read(NWLC->NwDrv, (DWORD_PTR)(ecam_base + PCI_ECAM_OFFSET(bus, dev, fn)),
+		ecam_page, PCI_ECAM_PAGE_SIZE / 4, 4) == 0)
+		return NULL;
+	ecam_bdf = bdf;
+	return ecam_page;
+}
+
+static int
+pci_ecam_read(unsigned bus, unsigned dev, unsigned fn, unsigned reg, unsigned len, unsigned long* value)
+{
+	unsigned char* page;
+	if (reg + len > PCI_ECAM_PAGE_SIZE || (reg & (len - 1)))
+		return -1;
+	page = pci_ecam_map(bus, dev, fn);
+	if (!page)
+		return -2;
+	switch (len) {
+	case 1:
+		*value = page[reg];
+		return 0;
+	case 2:
+		*value = *(uint16_t*)(page + reg);
+		return 0;
+	case 4:
+		*value = *(uint32_t*)(page + reg);
+		return 0;
+	}
+	return -1;
+}
+
 static int
 pci_conf_read(unsigned bus, unsigned dev, unsigned fn, unsigned reg, unsigned len, unsigned long* value)
 {
 	int result;
 
+	if (value && ecam_base && bus >= ecam_start_bus && bus <= ecam_end_bus && dev <= 31 && fn <= 7) {
+		result = pci_ecam_read(bus, dev, fn, reg, len, value);
+		if (result != -2)
+			return result;
+		/* The driver refuses physical memory reads, use 0xCF8/0xCFC from now on */
+		ecam_base = 0;
+	}
 	if (!value || (bus > 255) || (dev > 31) || (fn > 7) ||
 		(reg > 255 && pci_conf_type != PCI_CONF_TYPE_1))
 		return -1;
@@ -140,6 +220,9 @@ pci_conf_write(unsigned bus, unsigned dev, unsigned fn, unsigned reg, unsigned l
 	if (!value || (bus > 255) || (dev > 31) || (fn > 7) ||
 		(reg > 255 && pci_conf_type != PCI_CONF_TYPE_1))
 		return -1;
+	/* Drop the cached ECAM page, it no longer reflects the device */
+	if (ecam_bdf == (int)((bus << 8) | (dev << 3) | fn))
+		ecam_bdf = -1;
 	result = -2;
 	switch (pci_conf_type)
 	{
@@ -208,14 +291,14 @@ pci_check_direct(void)
 {
 	unsigned char tmpCFB;
 	unsigned int tmpCF8;
-	struct cpu_raw_data_t raw = { 0 };
-	struct cpu_id_t data = { 0 };
+	uint32_t regs[NUM_REGS];
 
-	if (cpuid_get_raw_data(&raw) < 0)
+	/* Vendor and family only need leaves 0 and 1 */
+	if (cpuid_get_raw_leaf(0, 0, regs) < 0 || (regs[EBX] & 0xFF) != 'A')
 		goto skip_amd;
-	if (cpu_identify(&raw, &data) < 0)
+	if (cpuid_get_raw_leaf(1, 0, regs) < 0)
 		goto skip_amd;
-	if (data.vendor_str[0] == 'A' && data.family == 0xF) {
+	if (((regs[EAX] >> 8) & 0xF) == 0xF) {
 		pci_conf_type = PCI_CONF_TYPE_1;
 		return 0;
 	}
@@ -422,21 +505,24 @@ static int find_smb_controller(void)
 {
 	int i = 0;
 	int result = 0;
-	unsigned long valuev, valued;
+	unsigned long id, header;
 
 	for (smbdev = 0; smbdev < 32; smbdev++) {
 		for (smbfun = 0; smbfun < 8; smbfun++) {
-			result = pci_conf_read(0, smbdev, smbfun, 0, 2, &valuev);
-			if (result != 0 || valuev == 0xFFFF)
-				continue;
-			result = pci_conf_read(0, smbdev, smbfun, 2, 2, &valued);
-			if (result != 0)
+			result = pci_conf_read(0, smbdev, smbfun, 0, 4, &id);
+			if (result != 0 || (id & 0xFFFF) == 0xFFFF) {
+				/* No function 0 means no device */
+				if (smbfun == 0)
+					break;
 				continue;
-			//printf("PCI %04X %04X\n", valuev, valued);
+			}
 			for (i = 0; smbcontrollers[i].vendor > 0; i++) {
-				if (valuev == smbcontrollers[i].vendor && valued == smbcontrollers[i].device)
+				if ((id & 0xFFFF) == smbcontrollers[i].vendor && (id >> 16) == smbcontrollers[i].device)
 					return i;
 			}
+			/* Skip functions 1-7 of single-function devices */
+			if (smbfun == 0 && pci_conf_read(0, smbdev, 0, 0x0E, 1, &header) == 0 && !(header & 0x80))
+				break;
 		}
 	}
 	return -1;
@@ -453,6 +539,7 @@ NWL_SpdInit(void)
 		fprintf(stderr, "pci check failed\n");
 		return;
 	}
+	pci_check_ecam();
 	smbus_index = find_smb_controller();
 	if (smbus_index == -1) {
 		fprintf(stderr, "unsupported smbus controller\n");
@@ -238,26 +238,24 @@ DDRSpeed(UINT8* rawSpd)
 static void
 PrintDDR5(PNODE nd, UINT8* rawSpd)
 {
-	UINT i = 0;
 	NWL_NodeAttrSetf(nd, "Revision", 0, "%u.%u", rawSpd[1] >> 4, rawSpd[1] & 0x0FU);
 #if 0
+	NWL_STRBUF sb;
 	NWL_NodeAttrSet(nd, "Manufacturer", DDR345Manufacturer(rawSpd[512], rawSpd[513]), 0);
 	NWL_NodeAttrSet(nd, "Date", DDR2345Date(rawSpd[515], rawSpd[516]), 0);
-	NWLC->NwBuf[0] = '\0';
-	for (i = 0; i < 4; i++)
-		snprintf(NWLC->NwBuf, NWINFO_BUFSZ, "%s%02X", NWLC->NwBuf, rawSpd[517 + i]);
-	NWL_NodeAttrSet(nd, "Serial Number", NWLC->NwBuf, 0);
-	NWLC->NwBuf[0] = '\0';
-	for (i = 0; i < 20; i++)
-		snprintf(NWLC->NwBuf, NWINFO_BUFSZ, "%s%c", NWLC->NwBuf, rawSpd[521 + i]);
-	NWL_NodeAttrSet(nd, "Part", NWLC->NwBuf, 0);
+	NWL_StrBufInit(&sb, NWLC->NwBuf, NWINFO_BUFSZ);
+	NWL_StrBufAppendHex(&sb, &rawSpd[517], 4, NULL);
+	NWL_NodeAttrSet(nd, "Serial Number", sb.Buf, 0);
+	NWL_StrBufInit(&sb, NWLC->NwBuf, NWINFO_BUFSZ);
+	NWL_StrBufAppendBytes(&sb, &rawSpd[521], 20);
+	NWL_NodeAttrSet(nd, "Part", sb.Buf, 0);
 #endif
 }
 
 static void
 PrintDDR4(PNODE nd, UINT8* rawSpd)
 {
-	UINT i = 0;
+	NWL_STRBUF sb;
 	NWL_NodeAttrSetf(nd, "Revision", 0, "%u.%u", rawSpd[1] >> 4, rawSpd[1] & 0x0FU);
 	NWL_NodeAttrSetf(nd, "Module Type", 0, "%s%s", DDR34ModuleType(rawSpd[3]), (rawSpd[13] & 0x08U) ? " (ECC)" : "");
 	NWL_NodeAttrSet(nd, "Capacity", DDR4Capacity(rawSpd), 0);
@@ -265,20 +263,18 @@ PrintDDR4(PNODE nd, UINT8* rawSpd)
 	NWL_NodeAttrSet(nd, "Voltage", (rawSpd[11] & 0x01U) ? "1.2 V" : "(Unknown)", 0);
 	NWL_NodeAttrSet(nd, "Manufacturer", DDR345Manufacturer(rawSpd[320], rawSpd[321]), 0);
 	NWL_NodeAttrSet(nd, "Date", DDR2345Date(rawSpd[323], rawSpd[324]), 0);
-	NWLC->NwBuf[0] = '\0';
-	for (i = 0; i < 4; i++)
-		snprintf(NWLC->NwBuf, NWINFO_BUFSZ, "%s%02X", NWLC->NwBuf, rawSpd[325 + i]);
-	NWL_NodeAttrSet(nd, "Serial Number", NWLC->NwBuf, 0);
-	NWLC->NwBuf[0] = '\0';
-	for (i = 0; i < 20; i++)
-		snprintf(NWLC->NwBuf, NWINFO_BUFSZ, "%s%c", NWLC->NwBuf, rawSpd[329 + i]);
-	NWL_NodeAttrSet(nd, "Part", NWLC->NwBuf, 0);
+	NWL_StrBufInit(&sb, NWLC->NwBuf, NWINFO_BUFSZ);
+	NWL_StrBufAppendHex(&sb, &rawSpd[325], 4, NULL);
+	NWL_NodeAttrSet(nd, "Serial Number", sb.Buf, 0);
+	NWL_StrBufInit(&sb, NWLC->NwBuf, NWINFO_BUFSZ);
+	NWL_StrBufAppendBytes(&sb, &rawSpd[329], 20);
+	NWL_NodeAttrSet(nd, "Part", sb.Buf, 0);
 }
 
 static void
 PrintDDR3(PNODE nd, UINT8* rawSpd)
 {
-	UINT i = 0;
+	NWL_STRBUF sb;
 	NWL_NodeAttrSetf(nd, "Revision", 0, "%u.%u", rawSpd[1] >> 4, rawSpd[1] & 0x0FU);
 	NWL_NodeAttrSetf(nd, "Module Type", 0, "%s%s", DDR34ModuleType(rawSpd[3]), (rawSpd[8] >> 3 == 1) ? " (ECC)" : "");
 	NWL_NodeAttrSet(nd, "Capacity", DDR3Capacity(rawSpd), 0);
@@ -287,53 +283,47 @@ PrintDDR3(PNODE nd, UINT8* rawSpd)
 		(rawSpd[6] & 0x02U) ? " 1.35V" : "", (rawSpd[6] & 0x01U) ? "" : " 1.5V");
 	NWL_NodeAttrSet(nd, "Manufacturer", DDR345Manufacturer(rawSpd[117], rawSpd[118]), 0);
 	NWL_NodeAttrSet(nd, "Date", DDR2345Date(rawSpd[120], rawSpd[121]), 0);
-	NWLC->NwBuf[0] = '\0';
-	for (i = 0; i < 4; i++)
-		snprintf(NWLC->NwBuf, NWINFO_BUFSZ, "%s%02X", NWLC->NwBuf, rawSpd[122 + i]);
-	NWL_NodeAttrSet(nd, "Serial Number", NWLC->NwBuf, 0);
-	NWLC->NwBuf[0] = '\0';
-	for (i = 0; i < 20; i++)
-		snprintf(NWLC->NwBuf, NWINFO_BUFSZ, "%s%c", NWLC->NwBuf, rawSpd[128 + i]);
-	NWL_NodeAttrSet(nd, "Part", NWLC->NwBuf, 0);
+	NWL_StrBufInit(&sb, NWLC->NwBuf, NWINFO_BUFSZ);
+	NWL_StrBufAppendHex(&sb, &rawSpd[122], 4, NULL);
+	NWL_NodeAttrSet(nd, "Serial Number", sb.Buf, 0);
+	NWL_StrBufInit(&sb, NWLC->NwBuf, NWINFO_BUFSZ);
+	NWL_StrBufAppendBytes(&sb, &rawSpd[128], 20);
+	NWL_NodeAttrSet(nd, "Part", sb.Buf, 0);
 }
 
 static void
 PrintDDR2(PNODE nd, UINT8* rawSpd)
 {
-	UINT i = 0;
+	NWL_STRBUF sb;
 	NWL_NodeAttrSetf(nd, "Revision", 0, "%u.%u", rawSpd[1] >> 4, rawSpd[1] & 0x0FU);
 	NWL_NodeAttrSetf(nd, "Module Type", 0, "%s%s", DDR2ModuleType(rawSpd[3]), (rawSpd[11] >> 1 == 1) ? " (ECC)" : "");
 	NWL_NodeAttrSet(nd, "Capacity", DDR2Capacity(rawSpd), 0);
 	NWL_NodeAttrSetf(nd, "Speed (MHz)", NAFLG_FMT_NUMERIC, "%u", DDRSpeed(rawSpd));
 	NWL_NodeAttrSet(nd, "Manufacturer", DDRManufacturer(rawSpd + 64), 0);
 	NWL_NodeAttrSet(nd, "Date", DDR2345Date(rawSpd[93], rawSpd[94]), 0);
-	NWLC->NwBuf[0] = '\0';
-	for (i = 0; i < 4; i++)
-		snprintf(NWLC->NwBuf, NWINFO_BUFSZ, "%s%02X", NWLC->NwBuf, rawSpd[95 + i]);
-	NWL_NodeAttrSet(nd, "Serial Number", NWLC->NwBuf, 0);
-	NWLC->NwBuf[0] = '\0';
-	for (i = 0; i < 18; i++)
-		snprintf(NWLC->NwBuf, NWINFO_BUFSZ, "%s%c", NWLC->NwBuf, rawSpd[73 + i]);
-	NWL_NodeAttrSet(nd, "Part", NWLC->NwBuf, 0);
+	NWL_StrBufInit(&sb, NWLC->NwBuf, NWINFO_BUFSZ);
+	NWL_StrBufAppendHex(&sb, &rawSpd[95], 4, NULL);
+	NWL_NodeAttrSet(nd, "Serial Number", sb.Buf, 0);
+	NWL_StrBufInit(&sb, NWLC->NwBuf, NWINFO_BUFSZ);
+	NWL_StrBufAppendBytes(&sb, &rawSpd[73], 18);
+	NWL_NodeAttrSet(nd, "Part", sb.Buf, 0);
 }
 
 static void
 PrintDDR(PNODE nd, UINT8* rawSpd)
 {
-	UINT i = 0;
+	NWL_STRBUF sb;
 	NWL_NodeAttrSetf(nd, "Revision", 0, "%u.%u", rawSpd[1] >> 4, rawSpd[1] & 0x0FU);
 	NWL_NodeAttrSet(nd, "Capacity", DDRCapacity(rawSpd), 0);
 	NWL_NodeAttrSetf(nd, "Speed (MHz)", NAFLG_FMT_NUMERIC, "%u", DDRSpeed(rawSpd));
 	NWL_NodeAttrSet(nd, "Manufacturer", DDRManufacturer(rawSpd + 64), 0);
 	NWL_NodeAttrSet(nd, "Date", DDRDate(rawSpd[93], rawSpd[94]), 0);
-	NWLC->NwBuf[0] = '\0';
-	for (i = 0; i < 4; i++)
-		snprintf(NWLC->NwBuf, NWINFO_BUFSZ, "%s%02X", NWLC->NwBuf, rawSpd[95 + i]);
-	NWL_NodeAttrSet(nd, "Serial Number", NWLC->NwBuf, 0);
-	NWLC->NwBuf[0] = '\0';
-	for (i = 0; i < 18; i++)
-		snprintf(NWLC->NwBuf, NWINFO_BUFSZ, "%s%c", NWLC->NwBuf, rawSpd[73 + i]);
-	NWL_NodeAttrSet(nd, "Part", NWLC->NwBuf, 0);
+	NWL_StrBufInit(&sb, NWLC->NwBuf, NWINFO_BUFSZ);
+	NWL_StrBufAppendHex(&sb, &rawSpd[95], 4, NULL);
+	NWL_NodeAttrSet(nd, "Serial Number", sb.Buf, 0);
+	NWL_StrBufInit(&sb, NWLC->NwBuf, NWINFO_BUFSZ);
+	NWL_StrBufAppendBytes(&sb, &rawSpd[73], 18);
+	NWL_NodeAttrSet(nd, "Part", sb.Buf, 0);
 }
 
 PNODE NW_Spd(VOID)
@@ -197,10 +197,7 @@ static void PrintTpmInfo(PNODE node)
 			NWL_NodeAttrSet(node, "TPM", "v1.2", 0);
 	}
 	if (AcpiHdr)
-	{
-		free(AcpiHdr);
 		return;
-	}
 	if (hL)
 		*(FARPROC*)&GetTpmInfo = GetProcAddress(hL, "Tbsi_GetDeviceInfo");
 	if (GetTpmInfo) {
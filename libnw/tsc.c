@@ -0,0 +1,237 @@
+// SPDX-License-Identifier: Unlicense
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "libnw.h"
+#include <libcpuid.h>
+#include "utils.h"
+
+#define TSC_SYNC_ROUNDS 1000
+#define MSR_IA32_TSC_ADJUST 0x3B
+
+#define TSC_SYNC_INIT 0
+#define TSC_SYNC_READY 1
+#define TSC_SYNC_PING 2
+#define TSC_SYNC_PONG 3
+#define TSC_SYNC_STOP 4
+#define TSC_SYNC_FAIL 5
+
+struct tsc_sync
+{
+	volatile LONG phase;
+	volatile uint64_t remote;
+	GROUP_AFFINITY affinity;
+	BOOL rdtscp;
+};
+
+// RDTSCP waits for the preceding loads, so the read is not hoisted above the handshake
+static uint64_t
+ReadTsc(BOOL rdtscp)
+{
+	uint64_t tsc;
+	if (rdtscp)
+		cpu_rdtscp(&tsc, NULL);
+	else
+		cpu_rdtsc(&tsc);
+	return tsc;
+}
+
+static DWORD WINAPI
+TscSyncThread(LPVOID lpParameter)
+{
+	struct tsc_sync* sync = lpParameter;
+	LONG phase;
+
+	if (!SetThreadGroupAffinity(GetCurrentThread(), &sync->affinity, NULL))
+	{
+		InterlockedExchange(&sync->phase, TSC_SYNC_FAIL);
+		return 1;
+	}
+	InterlockedExchange(&sync->phase, TSC_SYNC_READY);
+	while ((phase = sync->phase) != TSC_SYNC_STOP)
+	{
+		if (phase != TSC_SYNC_PING)
+		{
+			YieldProcessor();
+			continue;
+		}
+		sync->remote = ReadTsc(sync->rdtscp);
+		InterlockedExchange(&sync->phase, TSC_SYNC_PONG);
+	}
+	return 0;
+}
+
+// Ping-pong with a thread pinned to the other CPU. With synchronized TSCs the remote
+// read always lands between the two local reads; the fastest round trip gives the
+// tightest estimate of the offset.
+static BOOL
+MeasureTscOffset(DWORD cpu, BOOL rdtscp, INT64* offset, UINT64* rtt, DWORD* violations)
+{
+	struct tsc_sync sync = { 0 };
+	HANDLE thread;
+	uint64_t t0, t1, remote;
+	int i;
+
+	if (!cpuid_get_cpu_group_affinity((logical_cpu_t)cpu, &sync.affinity))
+		return FALSE;
+	sync.rdtscp = rdtscp;
+	thread = CreateThread(NULL, 64 * 1024, TscSyncThread, &sync, STACK_SIZE_PARAM_IS_A_RESERVATION, NULL);
+	if (!thread)
+		return FALSE;
+	while (sync.phase == TSC_SYNC_INIT)
+		Sleep(0);
+	if (sync.phase == TSC_SYNC_FAIL)
+	{
+		WaitForSingleObject(thread, INFINITE);
+		CloseHandle(thread);
+		return FALSE;
+	}
+
+	*offset = 0;
+	*rtt = UINT64_MAX;
+	*violations = 0;
+	for (i = 0; i < TSC_SYNC_ROUNDS; i++)
+	{
+		t0 = ReadTsc(rdtscp);
+		InterlockedExchange(&sync.phase, TSC_SYNC_PING);
+		while (sync.phase != TSC_SYNC_PONG)
+			YieldProcessor();
+		t1 = ReadTsc(rdtscp);
+		remote = sync.remote;
+		if (remote < t0 || remote > t1)
+			(*violations)++;
+		if (t1 - t0 < *rtt)
+		{
+			*rtt = t1 - t0;
+			*offset = (INT64)(remote - t0) - (INT64)(*rtt / 2);
+		}
+	}
+	InterlockedExchange(&sync.phase, TSC_SYNC_STOP);
+	WaitForSingleObject(thread, INFINITE);
+	CloseHandle(thread);
+	return TRUE;
+}
+
+// Offsets are relative to CPU 0, where the calling thread is pinned
+static void
+PrintTscSync(PNODE node, BOOL rdtscp, BOOL tsc_adjust, uint64_t freq)
+{
+	DWORD i, count = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+	DWORD violations, total = 0;
+	INT64 offset, min_offset = 0, max_offset = 0;
+	UINT64 rtt;
+	PNODE table;
+
+	if (count < 2)
+		return;
+	table = NWL_NodeAppendNew(node, "CPUs", NFLG_TABLE);
+	for (i = 0; i < count; i++)
+	{
+		PNODE row;
+		if (i == 0)
+		{
+			offset = 0;
+			rtt = 0;
+			violations = 0;
+		}
+		else if (!MeasureTscOffset(i, rdtscp, &offset, &rtt, &violations))
+			continue;
+		row = NWL_NodeAppendNew(table, "CPU", NFLG_TABLE_ROW);
+		NWL_NodeAttrSetf(row, "CPU", NAFLG_FMT_NUMERIC, "%lu", i);
+		NWL_NodeAttrSetf(row, "Offset (cycles)", NAFLG_FMT_NUMERIC, "%lld", offset);
+		NWL_NodeAttrSetf(row, "Round Trip (cycles)", NAFLG_FMT_NUMERIC, "%llu", rtt);
+		NWL_NodeAttrSetf(row, "Violations", NAFLG_FMT_NUMERIC, "%lu", violations);
+		if (tsc_adjust && NWLC->NwDrv)
+		{
+			static const uint32_t msr = MSR_IA32_TSC_ADJUST;
+			uint64_t value;
+			if (cpu_rdmsr_batch(NWLC->NwDrv, (int)i, &msr, &value, NULL, 1) == 1)
+				NWL_NodeAttrSetf(row, "TSC_ADJUST", NAFLG_FMT_NUMERIC, "%lld", (INT64)value);
+		}
+		if (offset < min_offset)
+			min_offset = offset;
+		if (offset > max_offset)
+			max_offset = offset;
+		total += violations;
+	}
+	NWL_NodeAttrSetf(node, "Max Skew (cycles)", NAFLG_FMT_NUMERIC, "%lld", max_offset - min_offset);
+	if (freq)
+		NWL_NodeAttrSetf(node, "Max Skew (ns)", NAFLG_FMT_NUMERIC, "%.1lf",
+			(double)(max_offset - min_offset) * 1e9 / (double)freq);
+	NWL_NodeAttrSetf(node, "Sync Violations", NAFLG_FMT_NUMERIC, "%lu", total);
+	NWL_NodeAttrSetBool(node, "Synchronized", total == 0, 0);
+}
+
+static uint64_t
+PrintTimeSources(PNODE node)
+{
+	int i;
+	uint64_t freq = 0;
+	PNODE table = NWL_NodeAppendNew(node, "Time Sources", NFLG_TABLE);
+	for (i = 0; i < NUM_TIME_SOURCES; i++)
+	{
+		struct cpu_time_source_stats_t stats;
+		PNODE row;
+		if (cpu_time_source_measure((cpu_time_source_t)i, &stats) < 0)
+			continue;
+		if (i == TIME_SOURCE_RDTSC)
+			freq = stats.frequency;
+		row = NWL_NodeAppendNew(table, "Time Source", NFLG_TABLE_ROW);
+		NWL_NodeAttrSet(row, "Name", cpu_time_source_str((cpu_time_source_t)i), 0);
+		NWL_NodeAttrSetf(row, "Frequency (MHz)", NAFLG_FMT_NUMERIC, "%.3lf", stats.frequency / 1000000.0);
+		NWL_NodeAttrSetf(row, "Overhead (ns)", NAFLG_FMT_NUMERIC, "%.1lf", stats.overhead_ns);
+		NWL_NodeAttrSetf(row, "Resolution (ns)", NAFLG_FMT_NUMERIC, "%.1lf", stats.resolution_ns);
+	}
+	return freq;
+}
+
+PNODE NW_Tsc(VOID)
+{
+	uint32_t regs[NUM_REGS];
+	BOOL rdtscp, tsc_adjust, msr;
+	GROUP_AFFINITY affinity, saved;
+	BOOL pinned = FALSE;
+	uint64_t freq;
+	PNODE node = NWL_NodeAlloc("TSC", 0);
+	if (NWLC->TscInfo)
+		NWL_NodeAppendChild(NWLC->NwRoot, node);
+
+	if (cpuid_get_raw_leaf(1, 0, regs) < 0 || (regs[EDX] & (1U << 4)) == 0)
+	{
+		NWL_NodeAttrSetBool(node, "TSC", FALSE, 0);
+		goto fail;
+	}
+	msr = (regs[EDX] & (1U << 5)) != 0;
+	cpuid_get_raw_leaf(0x80000007, 0, regs);
+	NWL_NodeAttrSetBool(node, "Invariant TSC", regs[EDX] & (1U << 8), 0);
+	cpuid_get_raw_leaf(0x80000001, 0, regs);
+	rdtscp = (regs[EDX] & (1U << 27)) != 0;
+	NWL_NodeAttrSetBool(node, "RDTSCP", rdtscp, 0);
+	cpuid_get_raw_leaf(7, 0, regs);
+	tsc_adjust = (regs[EBX] & (1U << 1)) != 0;
+	NWL_NodeAttrSetBool(node, "TSC_ADJUST", tsc_adjust, 0);
+	if (cpuid_get_raw_leaf(0x15, 0, regs) >= 0 && regs[EAX] && regs[EBX])
+	{
+		NWL_NodeAttrSetf(node, "TSC/Crystal Ratio", 0, "%u/%u", regs[EBX], regs[EAX]);
+		if (regs[ECX])
+		{
+			NWL_NodeAttrSetf(node, "Crystal Clock (MHz)", NAFLG_FMT_NUMERIC, "%.3lf", regs[ECX] / 1000000.0);
+			NWL_NodeAttrSetf(node, "TSC Clock (MHz)", NAFLG_FMT_NUMERIC, "%.3lf",
+				(double)regs[ECX] * regs[EBX] / regs[EAX] / 1000000.0);
+		}
+	}
+
+	if (cpuid_get_cpu_group_affinity(0, &affinity))
+		pinned = SetThreadGroupAffinity(GetCurrentThread(), &affinity, &saved);
+	freq = PrintTimeSources(node);
+	if (freq)
+		NWL_NodeAttrSetf(node, "Measured TSC Clock (MHz)", NAFLG_FMT_NUMERIC, "%.3lf", freq / 1000000.0);
+	if (pinned)
+	{
+		PrintTscSync(node, rdtscp, tsc_adjust && msr, freq);
+		SetThreadGroupAffinity(GetCurrentThread(), &saved, NULL);
+	}
+fail:
+	return node;
+}
@@ -12,6 +12,11 @@
 #include <libcpuid.h>
 #include <winring0.h>
 
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#include <emmintrin.h>
+#define NWL_SSE2
+#endif
+
 BOOL NWL_IsAdmin(void)
 {
 	BOOL b;
@@ -116,7 +121,7 @@ NT5GetSmbios(struct RAW_SMBIOS_DATA* buf, DWORD buflen)
 		return 0;
 	if (!NWL_ReadMemory(bios, 0xf0000, 0x10000))
 		goto fail;
-	for (ptr = bios; ptr < bios + 0x10000; ptr += 16)
+	for (ptr = bios; (ptr = NWL_FindParagraphSig(ptr, bios + 0x10000, "_SM", 3)) != NULL; ptr += 16)
 	{
 		if (memcmp(ptr, "_SM_", 4) == 0 && NWL_AcpiChecksum(ptr, sizeof(struct smbios_eps)) == 0)
 		{
@@ -204,10 +209,9 @@ NWL_GetRsdp(VOID)
 	// EBDA 0x080000 - 0x09FFFF, 0x10000
 	if (!NWL_ReadMemory(bios, 0x80000, 0x10000))
 		goto out;
-	for (ptr = bios; ptr < bios + 0x10000; ptr += 16)
+	for (ptr = bios; (ptr = NWL_FindParagraphSig(ptr, bios + 0x10000, RSDP_SIGNATURE, RSDP_SIGNATURE_SIZE)) != NULL; ptr += 16)
 	{
-		if (memcmp(ptr, RSDP_SIGNATURE, RSDP_SIGNATURE_SIZE) == 0
-			&& NWL_AcpiChecksum(ptr, sizeof(struct acpi_rsdp_v1)) == 0)
+		if (NWL_AcpiChecksum(ptr, sizeof(struct acpi_rsdp_v1)) == 0)
 		{
 			ret = NWL_GetRsdpHelper((struct acpi_rsdp_v2*)ptr, 0x80000 + (ptr - bios));
 			goto out;
@@ -216,10 +220,9 @@ NWL_GetRsdp(VOID)
 	// BIOS 0x0E0000 - 0x100000, 0x20000
 	if (!NWL_ReadMemory(bios, 0xE0000, 0x20000))
 		goto out;
-	for (ptr = bios; ptr < bios + 0x20000; ptr += 16)
+	for (ptr = bios; (ptr = NWL_FindParagraphSig(ptr, bios + 0x20000, RSDP_SIGNATURE, RSDP_SIGNATURE_SIZE)) != NULL; ptr += 16)
 	{
-		if (memcmp(ptr, RSDP_SIGNATURE, RSDP_SIGNATURE_SIZE) == 0
-			&& NWL_AcpiChecksum(ptr, sizeof(struct acpi_rsdp_v1)) == 0)
+		if (NWL_AcpiChecksum(ptr, sizeof(struct acpi_rsdp_v1)) == 0)
 		{
 			ret = NWL_GetRsdpHelper((struct acpi_rsdp_v2*)ptr, 0xE0000 + (ptr - bios));
 			goto out;
@@ -290,18 +293,10 @@ NWL_GetXsdt(VOID)
 	return ret;
 }
 
-PVOID NWL_GetAcpi(DWORD TableId)
+static struct acpi_table_header*
+NWL_ReadAcpiByAddr(DWORD_PTR Addr)
 {
-	if (TableId == 'TDSR')
-		return NWL_GetRsdt();
-	if (TableId == 'TDSX')
-		return NWL_GetXsdt();
-	return NWL_GetSysAcpi(TableId);
-}
-
-PVOID NWL_GetAcpiByAddr(DWORD_PTR Addr)
-{
-	PVOID ret;
+	struct acpi_table_header* ret;
 	struct acpi_table_header tmp;
 	if (!Addr)
 		return NULL;
@@ -320,6 +315,213 @@ PVOID NWL_GetAcpiByAddr(DWORD_PTR Addr)
 	return ret;
 }
 
+// Takes ownership of Table.
+static struct acpi_dir_entry*
+NWL_AcpiDirAdd(struct acpi_dir* dir, UINT64 Addr, struct acpi_table_header* Table)
+{
+	UINT32 i;
+	struct acpi_dir_entry* entry;
+	if (dir->count >= dir->capacity)
+	{
+		UINT32 capacity = dir->capacity ? dir->capacity * 2 : 32;
+		struct acpi_dir_entry* entries = realloc(dir->entries, capacity * sizeof(struct acpi_dir_entry));
+		if (!entries)
+		{
+			free(Table);
+			return NULL;
+		}
+		dir->entries = entries;
+		dir->capacity = capacity;
+	}
+	entry = &dir->entries[dir->count];
+	entry->addr = Addr;
+	entry->instance = 0;
+	for (i = 0; i < dir->count; i++)
+	{
+		if (memcmp(dir->entries[i].table->signature, Table->signature, 4) == 0)
+			entry->instance++;
+	}
+	entry->checksum_ok = (NWL_AcpiChecksum(Table, Table->length) == 0);
+	entry->table = Table;
+	dir->count++;
+	return entry;
+}
+
+static struct acpi_dir_entry*
+NWL_AcpiDirFindAddr(struct acpi_dir* dir, UINT64 Addr)
+{
+	UINT32 i;
+	for (i = 0; i < dir->count; i++)
+	{
+		if (dir->entries[i].addr == Addr)
+			return &dir->entries[i];
+	}
+	return NULL;
+}
+
+static VOID
+NWL_AcpiDirAddAddr(struct acpi_dir* dir, UINT64 Addr)
+{
+	struct acpi_table_header* table;
+	if (!Addr || NWL_AcpiDirFindAddr(dir, Addr))
+		return;
+	table = NWL_ReadAcpiByAddr((DWORD_PTR)Addr);
+	if (table)
+		NWL_AcpiDirAdd(dir, Addr, table);
+}
+
+// Without physical memory access, list the tables known to the firmware table provider.
+static VOID
+NWL_AcpiDirLoadSys(struct acpi_dir* dir)
+{
+	UINT i, j, count;
+	DWORD* ids;
+	UINT(WINAPI * NT6EnumSystemFirmwareTables)
+		(DWORD FirmwareTableProviderSignature, PVOID pFirmwareTableEnumBuffer, DWORD BufferSize) = NULL;
+	HMODULE hMod = GetModuleHandleA("kernel32");
+
+	if (hMod)
+		*(FARPROC*)&NT6EnumSystemFirmwareTables = GetProcAddress(hMod, "EnumSystemFirmwareTables");
+	if (!NT6EnumSystemFirmwareTables)
+		return;
+	count = NT6EnumSystemFirmwareTables('ACPI', NULL, 0);
+	if (count < sizeof(DWORD))
+		return;
+	ids = malloc(count);
+	if (!ids)
+		return;
+	count = NT6EnumSystemFirmwareTables('ACPI', ids, count) / sizeof(DWORD);
+	for (i = 0; i < count; i++)
+	{
+		struct acpi_table_header* table;
+		if (ids[i] == 'TDSR' || ids[i] == 'TDSX')
+			continue;
+		// the provider only returns the first instance of each signature
+		for (j = 0; j < i; j++)
+		{
+			if (ids[j] == ids[i])
+				break;
+		}
+		if (j < i)
+			continue;
+		table = NWL_GetSysAcpi(ids[i]);
+		if (table)
+			NWL_AcpiDirAdd(dir, 0, table);
+	}
+	free(ids);
+}
+
+// Every table is read once, on first use, and kept until NW_Fini.
+struct acpi_dir*
+NWL_GetAcpiDir(VOID)
+{
+	UINT32 i, count;
+	struct acpi_dir* dir = NWLC->NwAcpiDir;
+	if (dir)
+		return dir;
+	dir = calloc(1, sizeof(struct acpi_dir));
+	if (!dir)
+		return NULL;
+	NWLC->NwAcpiDir = dir;
+	if (NWLC->NwRsdp && NWLC->NwXsdt)
+	{
+		count = (NWLC->NwXsdt->header.length - sizeof(struct acpi_table_header)) / sizeof(NWLC->NwXsdt->entry[0]);
+		for (i = 0; i < count; i++)
+			NWL_AcpiDirAddAddr(dir, NWLC->NwXsdt->entry[i]);
+	}
+	else if (NWLC->NwRsdp && NWLC->NwRsdt)
+	{
+		count = (NWLC->NwRsdt->header.length - sizeof(struct acpi_table_header)) / sizeof(NWLC->NwRsdt->entry[0]);
+		for (i = 0; i < count; i++)
+			NWL_AcpiDirAddAddr(dir, NWLC->NwRsdt->entry[i]);
+	}
+	if (dir->count == 0)
+		NWL_AcpiDirLoadSys(dir);
+	else
+	{
+		// the DSDT is only referenced by the FADT
+		struct acpi_fadt* fadt = NWL_GetAcpi('PCAF');
+		if (fadt && fadt->header.length >= offsetof(struct acpi_fadt, dsdt_xaddr) + sizeof(UINT64)
+			&& fadt->dsdt_xaddr)
+			NWL_AcpiDirAddAddr(dir, fadt->dsdt_xaddr);
+		else if (fadt && fadt->header.length >= offsetof(struct acpi_fadt, dsdt_addr) + sizeof(UINT32))
+			NWL_AcpiDirAddAddr(dir, fadt->dsdt_addr);
+	}
+	return dir;
+}
+
+VOID
+NWL_FreeAcpiDir(VOID)
+{
+	UINT32 i;
+	struct acpi_dir* dir = NWLC->NwAcpiDir;
+	if (!dir)
+		return;
+	for (i = 0; i < dir->count; i++)
+		free(dir->entries[i].table);
+	free(dir->entries);
+	free(dir);
+	NWLC->NwAcpiDir = NULL;
+}
+
+// The returned table is owned by the ACPI table directory.
+PVOID NWL_GetAcpiInstance(DWORD TableId, UINT32 Instance)
+{
+	UINT32 i;
+	struct acpi_dir* dir;
+	if (TableId == 'TDSR')
+		return Instance ? NULL : NWLC->NwRsdt;
+	if (TableId == 'TDSX')
+		return Instance ? NULL : NWLC->NwXsdt;
+	dir = NWL_GetAcpiDir();
+	if (!dir)
+		return NULL;
+	for (i = 0; i < dir->count; i++)
+	{
+		if (memcmp(dir->entries[i].table->signature, &TableId, 4) == 0
+			&& dir->entries[i].instance == Instance)
+			return dir->entries[i].table;
+	}
+	return NULL;
+}
+
+// Directory entry of a table returned by NWL_GetAcpi*, NULL for RSDT/XSDT
+struct acpi_dir_entry* NWL_GetAcpiDirEntry(CONST VOID* Table)
+{
+	UINT32 i;
+	struct acpi_dir* dir = NWLC->NwAcpiDir;
+	if (!dir || !Table)
+		return NULL;
+	for (i = 0; i < dir->count; i++)
+	{
+		if (dir->entries[i].table == Table)
+			return &dir->entries[i];
+	}
+	return NULL;
+}
+
+PVOID NWL_GetAcpi(DWORD TableId)
+{
+	return NWL_GetAcpiInstance(TableId, 0);
+}
+
+// The returned table is owned by the ACPI table directory.
+PVOID NWL_GetAcpiByAddr(DWORD_PTR Addr)
+{
+	struct acpi_dir_entry* entry;
+	struct acpi_dir* dir = NWL_GetAcpiDir();
+	if (!dir || !Addr)
+		return NULL;
+	entry = NWL_AcpiDirFindAddr(dir, Addr);
+	if (!entry)
+	{
+		struct acpi_table_header* table = NWL_ReadAcpiByAddr(Addr);
+		if (table)
+			entry = NWL_AcpiDirAdd(dir, Addr, table);
+	}
+	return entry ? entry->table : NULL;
+}
+
 DWORD
 NWL_GetFirmwareEnvironmentVariable(LPCSTR lpName, LPCSTR lpGuid,
 	PVOID pBuffer, DWORD nSize)
@@ -341,14 +543,130 @@ NWL_GetFirmwareEnvironmentVariable(LPCSTR lpName, LPCSTR lpGuid,
 UINT8
 NWL_AcpiChecksum(VOID* base, UINT size)
 {
-	UINT8* ptr;
+	UINT8* ptr = (UINT8*)base;
+	UINT8* end = ptr + size;
 	UINT8 ret = 0;
-	for (ptr = (UINT8*)base; ptr < ((UINT8*)base) + size;
-		ptr++)
+#ifdef NWL_SSE2
+	// PSADBW against zero adds 8 bytes into each 64-bit lane
+	__m128i zero = _mm_setzero_si128();
+	__m128i sum0 = zero, sum1 = zero;
+	for (; end - ptr >= 32; ptr += 32)
+	{
+		sum0 = _mm_add_epi64(sum0, _mm_sad_epu8(_mm_loadu_si128((const __m128i*)ptr), zero));
+		sum1 = _mm_add_epi64(sum1, _mm_sad_epu8(_mm_loadu_si128((const __m128i*)(ptr + 16)), zero));
+	}
+	if (end - ptr >= 16)
+	{
+		sum0 = _mm_add_epi64(sum0, _mm_sad_epu8(_mm_loadu_si128((const __m128i*)ptr), zero));
+		ptr += 16;
+	}
+	sum0 = _mm_add_epi64(sum0, sum1);
+	sum0 = _mm_add_epi64(sum0, _mm_srli_si128(sum0, 8));
+	ret = (UINT8)_mm_cvtsi128_si32(sum0);
+#endif
+	for (; ptr < end; ptr++)
 		ret += *ptr;
 	return ret;
 }
 
+UINT8*
+NWL_FindParagraphSig(UINT8* Start, UINT8* End, LPCSTR Sig, SIZE_T Len)
+{
+	UINT8* ptr = Start;
+#ifdef NWL_SSE2
+	if (Len > 0 && Len <= 16)
+	{
+		// Compare a whole paragraph at once and test the leading Len bytes
+		UINT8 pattern[16] = { 0 };
+		__m128i sig;
+		int mask = (1 << Len) - 1;
+		memcpy(pattern, Sig, Len);
+		sig = _mm_loadu_si128((const __m128i*)pattern);
+		for (; End - ptr >= 16; ptr += 16)
+		{
+			if ((_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)ptr), sig)) & mask) == mask)
+				return ptr;
+		}
+	}
+#endif
+	for (; ptr < End && (SIZE_T)(End - ptr) >= Len; ptr += 16)
+	{
+		if (memcmp(ptr, Sig, Len) == 0)
+			return ptr;
+	}
+	return NULL;
+}
+
+VOID
+NWL_StrBufInit(PNWL_STRBUF Sb, CHAR* Buf, SIZE_T Size)
+{
+	Sb->Buf = Buf;
+	Sb->Size = Size;
+	Sb->Len = 0;
+	if (Size)
+		Buf[0] = '\0';
+}
+
+VOID
+NWL_StrBufAppendChar(PNWL_STRBUF Sb, CHAR Ch)
+{
+	if (Sb->Len + 1 >= Sb->Size)
+		return;
+	Sb->Buf[Sb->Len++] = Ch;
+	Sb->Buf[Sb->Len] = '\0';
+}
+
+// NUL bytes are skipped, fixed-width firmware strings are often zero padded.
+VOID
+NWL_StrBufAppendBytes(PNWL_STRBUF Sb, CONST VOID* Data, SIZE_T Len)
+{
+	SIZE_T i;
+	CONST CHAR* p = Data;
+	for (i = 0; i < Len && Sb->Len + 1 < Sb->Size; i++)
+	{
+		if (p[i] != '\0')
+			Sb->Buf[Sb->Len++] = p[i];
+	}
+	if (Sb->Size)
+		Sb->Buf[Sb->Len] = '\0';
+}
+
+VOID
+NWL_StrBufAppendHex(PNWL_STRBUF Sb, CONST VOID* Data, SIZE_T Len, LPCSTR Sep)
+{
+	static CONST CHAR hex[] = "0123456789ABCDEF";
+	SIZE_T i, j;
+	CONST UINT8* p = Data;
+	for (i = 0; i < Len; i++)
+	{
+		if (i && Sep)
+		{
+			for (j = 0; Sep[j]; j++)
+				NWL_StrBufAppendChar(Sb, Sep[j]);
+		}
+		NWL_StrBufAppendChar(Sb, hex[p[i] >> 4]);
+		NWL_StrBufAppendChar(Sb, hex[p[i] & 0x0F]);
+	}
+}
+
+VOID
+NWL_StrBufAppendf(PNWL_STRBUF Sb, LPCSTR _Printf_format_string_ Format, ...)
+{
+	int ret;
+	va_list ap;
+	if (Sb->Len + 1 >= Sb->Size)
+		return;
+	va_start(ap, Format);
+	ret = vsnprintf(Sb->Buf + Sb->Len, Sb->Size - Sb->Len, Format, ap);
+	va_end(ap);
+	if (ret < 0)
+		Sb->Buf[Sb->Len] = '\0';
+	else if ((SIZE_T)ret >= Sb->Size - Sb->Len)
+		Sb->Len = Sb->Size - 1;
+	else
+		Sb->Len += ret;
+}
+
 VOID NWL_TrimString(CHAR* String)
 {
 	CHAR* Pos1 = String;
@@ -7,6 +7,16 @@
 struct acpi_rsdp_v2;
 struct acpi_rsdt;
 struct acpi_xsdt;
+struct acpi_dir;
+struct acpi_dir_entry;
+
+// Bounded string builder, the buffer is always NUL-terminated and output is truncated to fit
+typedef struct _NWL_STRBUF
+{
+	CHAR* Buf;							// Caller-owned buffer
+	SIZE_T Size;						// Size of Buf in bytes
+	SIZE_T Len;							// Current string length
+} NWL_STRBUF, * PNWL_STRBUF;
 
 BOOL NWL_IsAdmin(void);
 DWORD NWL_ObtainPrivileges(LPCSTR privilege);
@@ -22,14 +32,24 @@ UINT NWL_GetSystemFirmwareTable(DWORD FirmwareTableProviderSignature, DWORD Firm
 struct acpi_rsdp_v2* NWL_GetRsdp(VOID);
 struct acpi_rsdt* NWL_GetRsdt(VOID);
 struct acpi_xsdt* NWL_GetXsdt(VOID);
+struct acpi_dir* NWL_GetAcpiDir(VOID);
+VOID NWL_FreeAcpiDir(VOID);
 PVOID NWL_GetAcpi(DWORD TableId);
+PVOID NWL_GetAcpiInstance(DWORD TableId, UINT32 Instance);
 PVOID NWL_GetAcpiByAddr(DWORD_PTR Addr);
+struct acpi_dir_entry* NWL_GetAcpiDirEntry(CONST VOID* Table);
 
 DWORD NWL_GetFirmwareEnvironmentVariable(LPCSTR lpName, LPCSTR lpGuid,
 	PVOID pBuffer, DWORD nSize);
 
 UINT8 NWL_AcpiChecksum(VOID* base, UINT size);
+UINT8* NWL_FindParagraphSig(UINT8* Start, UINT8* End, LPCSTR Sig, SIZE_T Len);
 VOID NWL_TrimString(CHAR* String);
+VOID NWL_StrBufInit(PNWL_STRBUF Sb, CHAR* Buf, SIZE_T Size);
+VOID NWL_StrBufAppendChar(PNWL_STRBUF Sb, CHAR Ch);
+VOID NWL_StrBufAppendBytes(PNWL_STRBUF Sb, CONST VOID* Data, SIZE_T Len);
+VOID NWL_StrBufAppendHex(PNWL_STRBUF Sb, CONST VOID* Data, SIZE_T Len, LPCSTR Sep);
+VOID NWL_StrBufAppendf(PNWL_STRBUF Sb, LPCSTR _Printf_format_string_ Format, ...);
 INT NWL_GetRegDwordValue(HKEY Key, LPCSTR SubKey, LPCSTR ValueName, DWORD* pValue);
 CHAR* NWL_GetRegSzValue(HKEY Key, LPCSTR SubKey, LPCSTR ValueName);
 HANDLE NWL_GetDiskHandleById(BOOL Cdrom, BOOL Write, DWORD Id);
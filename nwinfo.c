@@ -12,10 +12,21 @@ static void nwinfo_help(void)
 		"  --output=FILE    Write to FILE instead of printing to screen.\n"
 		"  --human          Display numbers in human readable format.\n"
 		"  --sys            Print system info.\n"
-		"  --cpu            Print CPUID info.\n"
+		"  --cpu[=measure|debug]\n"
+		"                   Print CPUID info.\n"
+		"                   measure: time the CPU clock with a 200 ms busy loop.\n"
+		"                   debug: also print how many CPUID instructions ran.\n"
+		"  --cpu-dump=FILE  Print CPUID info and write the raw CPUID data to FILE.\n"
+		"                   FILE ending in .bin gets the compact binary form.\n"
+		"  --cpu-load=FILE  Print CPUID info from raw CPUID data in FILE.\n"
 		"  --net[=active]   Print [active] network info\n"
 		"  --acpi[=XXXX]    Print ACPI [table=XXXX] info.\n"
 		"  --smbios[=XX]    Print SMBIOS [type=XX] info.\n"
+		"                   XX is a list of types or ranges, e.g. 4,7,16-19.\n"
+		"                   127 selects all types.\n"
+		"                   TYPE[-TYPE]:FIELD[,FIELD...] prints only the fields\n"
+		"                   named FIELD, e.g. 17:Manufacturer,Speed. The unit suffix\n"
+		"                   of a name, e.g. \" (MT/s)\", may be left out.\n"
 		"  --disk           Print disk info.\n"
 		"  --display        Print EDID info.\n"
 		"  --pci[=XX]       Print PCI [class=XX] info.\n"
@@ -23,12 +34,16 @@ static void nwinfo_help(void)
 		"  --beep FREQ TIME [FREQ TIME ...]\n"
 		"                   Play a tune.\n"
 		"  --spd            Print SPD info\n"
-		"  --battery        Print battery info.\n");
+		"  --battery        Print battery info.\n"
+		"  --tsc            Print TSC reliability and time source info.\n"
+		"  --monitor=MS     Sample per-core clock, multiplier, temperature and voltage\n"
+		"                   every MS ms, print min/avg/max every second until Ctrl+C.\n");
 }
 
 int main(int argc, char* argv[])
 {
 	LPCSTR lpFileName = NULL;
+	DWORD dwMonitor = 0;
 	ZeroMemory(&nwContext, sizeof(NWLIB_CONTEXT));
 	nwContext.NwFormat = FORMAT_YAML;
 	nwContext.HumanSize = FALSE;
@@ -54,8 +69,22 @@ int main(int argc, char* argv[])
 			nwContext.HumanSize = TRUE;
 		else if (_stricmp(argv[i], "--sys") == 0)
 			nwContext.SysInfo = TRUE;
-		else if (_stricmp(argv[i], "--cpu") == 0)
+		else if (_strnicmp(argv[i], "--cpu-dump=", 11) == 0 && argv[i][11])
+		{
+			nwContext.CpuDump = &argv[i][11];
+			nwContext.CpuInfo = TRUE;
+		}
+		else if (_strnicmp(argv[i], "--cpu-load=", 11) == 0 && argv[i][11])
+		{
+			nwContext.CpuLoad = &argv[i][11];
 			nwContext.CpuInfo = TRUE;
+		}
+		else if (_strnicmp(argv[i], "--cpu", 5) == 0)
+		{
+			nwContext.CpuMeasure = _stricmp(&argv[i][5], "=measure") == 0 ? TRUE : FALSE;
+			nwContext.CpuDebug = _stricmp(&argv[i][5], "=debug") == 0 ? TRUE : FALSE;
+			nwContext.CpuInfo = TRUE;
+		}
 		else if (_strnicmp(argv[i], "--net", 5) == 0)
 		{
 			nwContext.ActiveNet = _stricmp(&argv[i][5], "=active") == 0 ? TRUE : FALSE;
@@ -70,7 +99,7 @@ int main(int argc, char* argv[])
 		else if (_strnicmp(argv[i], "--smbios", 8) == 0)
 		{
 			if (argv[i][8] == '=' && argv[i][9])
-				nwContext.SmbiosType = (UINT8)strtoul(&argv[i][9], NULL, 0);
+				nwContext.SmbiosType = &argv[i][9];
 			nwContext.DmiInfo = TRUE;
 		}
 		else if (_stricmp(argv[i], "--disk") == 0)
@@ -96,6 +125,10 @@ int main(int argc, char* argv[])
 			nwContext.SpdInfo = TRUE;
 		else if (_stricmp(argv[i], "--battery") == 0)
 			nwContext.BatteryInfo = TRUE;
+		else if (_stricmp(argv[i], "--tsc") == 0)
+			nwContext.TscInfo = TRUE;
+		else if (_strnicmp(argv[i], "--monitor=", 10) == 0 && argv[i][10])
+			dwMonitor = strtoul(&argv[i][10], NULL, 10);
 		else
 		{
 			nwinfo_help();
@@ -105,6 +138,8 @@ int main(int argc, char* argv[])
 
 main_out:
 	NW_Print(lpFileName);
+	if (dwMonitor)
+		NW_Monitor(dwMonitor);
 	NW_Fini();
 	return 0;
 }
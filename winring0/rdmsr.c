@@ -84,9 +84,9 @@
 #define MSR_PSTATE_5           0xC0010069
 #define MSR_PSTATE_6           0xC001006A
 #define MSR_PSTATE_7           0xC001006B
+/* P-state definitions do not change after reset, cpu_msrinfo reads them once in a batch */
 static const uint32_t amd_msr[] = {
 	MSR_PSTATE_L,
-	MSR_PSTATE_S,
 	MSR_PSTATE_0,
 	MSR_PSTATE_1,
 	MSR_PSTATE_2,
@@ -95,7 +95,6 @@ static const uint32_t amd_msr[] = {
 	MSR_PSTATE_5,
 	MSR_PSTATE_6,
 	MSR_PSTATE_7,
-	CPU_INVALID_VALUE
 };
 
 /* Intel MSRs addresses */
@@ -108,39 +107,59 @@ static const uint32_t amd_msr[] = {
 #define MSR_TEMPERATURE_TARGET 0x1A2
 #define MSR_PERF_STATUS        0x198
 #define MSR_PLATFORM_INFO      0xCE
+/* Ratio limits and the TjMax target do not change after reset, cpu_msrinfo reads them once in a batch */
 static const uint32_t intel_msr[] = {
-	IA32_MPERF,
-	IA32_APERF,
-	IA32_PERF_STATUS,
-	IA32_THERM_STATUS,
 	MSR_EBL_CR_POWERON,
 	MSR_TURBO_RATIO_LIMIT,
 	MSR_TEMPERATURE_TARGET,
-	MSR_PERF_STATUS,
 	MSR_PLATFORM_INFO,
-	CPU_INVALID_VALUE
 };
 
+#define MSR_CACHE_SIZE 16
+
 struct msr_info_t {
 	int cpu_clock;
 	struct msr_driver_t *handle;
 	struct cpu_id_t *id;
 	struct internal_id_info_t *internal;
+	const uint32_t *msrs;                 /* intel_msr or amd_msr */
+	int num_msrs;
+	uint64_t msr_value[MSR_CACHE_SIZE];
+	uint8_t msr_valid[MSR_CACHE_SIZE];
 };
 
-static int perfmsr_measure(struct msr_driver_t* handle, int msr)
+static int get_msr_bits(uint64_t value, uint8_t highbit, uint8_t lowbit, uint64_t* result)
 {
-	int err;
-	uint64_t a, b;
-	uint64_t x, y;
-	err = cpu_rdmsr(handle, msr, &x);
-	if (err) return CPU_INVALID_VALUE;
-	sys_precise_clock(&a);
-	busy_loop_delay(10);
-	cpu_rdmsr(handle, msr, &y);
-	sys_precise_clock(&b);
-	if (a >= b || x > y) return CPU_INVALID_VALUE;
-	return (int) ((y - x) / (b - a));
+	const uint8_t bits = highbit - lowbit + 1;
+
+	if(highbit > 63 || lowbit > highbit)
+		return set_error(ERR_INVRANGE);
+
+	*result = value;
+	if(bits < 64) {
+		/* Show only part of register */
+		*result >>= lowbit;
+		*result &= (1ULL << bits) - 1;
+	}
+
+	return 0;
+}
+
+/* Same as cpu_rdmsr_range, but static MSRs come from the snapshot taken at init */
+static int info_rdmsr_range(struct msr_info_t *info, uint32_t msr_index, uint8_t highbit,
+					uint8_t lowbit, uint64_t* result)
+{
+	int i;
+
+	for(i = 0; i < info->num_msrs; i++) {
+		if(info->msrs[i] != msr_index)
+			continue;
+		if(!info->msr_valid[i])
+			return -1;
+		return get_msr_bits(info->msr_value[i], highbit, lowbit, result);
+	}
+
+	return cpu_rdmsr_range(info->handle, msr_index, highbit, lowbit, result);
 }
 
 static int get_amd_multipliers(struct msr_info_t *info, uint32_t pstate, double *multiplier)
@@ -178,8 +197,8 @@ static int get_amd_multipliers(struct msr_info_t *info, uint32_t pstate, double
 			MSRC001_00[6B:64][3:0] is CpuDid
 			CPU COF is (100MHz * (CpuFid + 10h) / (divisor specified by CpuDid))
 			Note: This family contains only APUs */
-			err  = cpu_rdmsr_range(info->handle, pstate, 8, 4, &CpuFid);
-			err += cpu_rdmsr_range(info->handle, pstate, 3, 0, &CpuDid);
+			err  = info_rdmsr_range(info, pstate, 8, 4, &CpuFid);
+			err += info_rdmsr_range(info, pstate, 3, 0, &CpuDid);
 			i = 0;
 			while (i < num_dids && divisor_t[i].did != CpuDid)
 				i++;
@@ -196,8 +215,8 @@ static int get_amd_multipliers(struct msr_info_t *info, uint32_t pstate, double
 			Divisor is (CpuDidMSD + (CpuDidLSD * 0.25) + 1)
 			CPU COF is (main PLL frequency specified by D18F3xD4[MainPllOpFreqId]) / (core clock divisor specified by CpuDidMSD and CpuDidLSD)
 			Note: This family contains only APUs */
-			err  = cpu_rdmsr_range(info->handle, pstate, 8, 4, &CpuDid);
-			err += cpu_rdmsr_range(info->handle, pstate, 3, 0, &CpuDidLSD);
+			err  = info_rdmsr_range(info, pstate, 8, 4, &CpuDid);
+			err += info_rdmsr_range(info, pstate, 3, 0, &CpuDidLSD);
 			*multiplier = (double) (((info->cpu_clock + 5LL) / 100 + magic_constant) / (CpuDid + CpuDidLSD * 0.25 + 1));
 			break;
 		case 0x10:
@@ -224,8 +243,8 @@ static int get_amd_multipliers(struct msr_info_t *info, uint32_t pstate, double
 			MSRC001_00[6B:64][5:0] is CpuFid
 			CoreCOF is (100 * (MSRC001_00[6B:64][CpuFid] + 10h) / (2^MSRC001_00[6B:64][CpuDid]))
 			Note: This family contains only APUs */
-			err  = cpu_rdmsr_range(info->handle, pstate, 8, 6, &CpuDid);
-			err += cpu_rdmsr_range(info->handle, pstate, 5, 0, &CpuFid);
+			err  = info_rdmsr_range(info, pstate, 8, 6, &CpuDid);
+			err += info_rdmsr_range(info, pstate, 5, 0, &CpuFid);
 			*multiplier = ((double) (CpuFid + magic_constant) / (1ull << CpuDid)) / divisor;
 			break;
 		case 0x17:
@@ -233,8 +252,8 @@ static int get_amd_multipliers(struct msr_info_t *info, uint32_t pstate, double
 			MSRC001_00[6B:64][13:8] is CpuDfsId
 			MSRC001_00[6B:64][7:0]  is CpuFid
 			CoreCOF is (Core::X86::Msr::PStateDef[CpuFid[7:0]] / Core::X86::Msr::PStateDef[CpuDfsId]) * 200 */
-			err  = cpu_rdmsr_range(info->handle, pstate, 13, 8, &CpuDid);
-			err += cpu_rdmsr_range(info->handle, pstate,  7, 0, &CpuFid);
+			err  = info_rdmsr_range(info, pstate, 13, 8, &CpuDid);
+			err += info_rdmsr_range(info, pstate,  7, 0, &CpuFid);
 			*multiplier = ((double) CpuFid / CpuDid) * 2;
 			break;
 		default:
@@ -247,7 +266,8 @@ static int get_amd_multipliers(struct msr_info_t *info, uint32_t pstate, double
 
 static uint32_t get_amd_last_pstate_addr(struct msr_info_t *info)
 {
-	static uint32_t last_addr = 0x0;
+	static volatile uint32_t last_addr = 0x0;
+	uint32_t addr;
 	uint64_t reg = 0x0;
 
 	/* The result is cached, need to be computed once */
@@ -257,12 +277,14 @@ static uint32_t get_amd_last_pstate_addr(struct msr_info_t *info)
 	/* Refer links above
 	MSRC001_00[6B:64][63] is PstateEn
 	PstateEn indicates if the rest of the P-state information in the register is valid after a reset */
-	last_addr = MSR_PSTATE_7 + 1;
-	while((reg == 0x0) && (last_addr > MSR_PSTATE_0)) {
-		last_addr--;
-		cpu_rdmsr_range(info->handle, last_addr, 63, 63, &reg);
+	addr = MSR_PSTATE_7 + 1;
+	while((reg == 0x0) && (addr > MSR_PSTATE_0)) {
+		addr--;
+		info_rdmsr_range(info, addr, 63, 63, &reg);
 	}
-	return last_addr;
+	/* Publish only the final value, the monitor calls this from several threads */
+	last_addr = addr;
+	return addr;
 }
 
 static double get_info_min_multiplier(struct msr_info_t *info)
@@ -284,7 +306,7 @@ static double get_info_min_multiplier(struct msr_info_t *info)
 		Table 35-40.  Selected MSRs Supported by Next Generation Intel Xeon Phi Processors with DisplayFamily_DisplayModel Signature 06_57H
 		MSR_PLATFORM_INFO[47:40] is Maximum Efficiency Ratio
 		Maximum Efficiency Ratio is the minimum ratio that the processor can operates */
-		err = cpu_rdmsr_range(info->handle, MSR_PLATFORM_INFO, 47, 40, &reg);
+		err = info_rdmsr_range(info, MSR_PLATFORM_INFO, 47, 40, &reg);
 		if (!err) return (double) reg;
 	}
 	else if(info->id->vendor == VENDOR_AMD || info->id->vendor == VENDOR_HYGON) {
@@ -313,13 +335,13 @@ static double get_info_cur_multiplier(struct msr_info_t *info)
 		Table 35-2.  IA-32 Architectural MSRs (Contd.)
 		IA32_PERF_STATUS[15:0] is Current performance State Value
 		[7:0] is 0x0, [15:8] looks like current ratio */
-		err = cpu_rdmsr_range(info->handle, IA32_PERF_STATUS, 15, 8, &reg);
+		err = info_rdmsr_range(info, IA32_PERF_STATUS, 15, 8, &reg);
 		if (!err) return (double) reg;
 	}
 	else if(info->id->vendor == VENDOR_AMD || info->id->vendor == VENDOR_HYGON) {
 		/* Refer links above
 		MSRC001_0063[2:0] is CurPstate */
-		err  = cpu_rdmsr_range(info->handle, MSR_PSTATE_S, 2, 0, &reg);
+		err  = info_rdmsr_range(info, MSR_PSTATE_S, 2, 0, &reg);
 		err += get_amd_multipliers(info, MSR_PSTATE_0 + (uint32_t) reg, &mult);
 		if (!err) return mult;
 	}
@@ -353,7 +375,7 @@ static double get_info_max_multiplier(struct msr_info_t *info)
 		Table 35-37.  Additional MSRs Supported by 6th Generation Intel Core Processors Based on Skylake Microarchitecture
 		Table 35-40.  Selected MSRs Supported by Next Generation Intel Xeon Phi Processors with DisplayFamily_DisplayModel Signature 06_57H
 		MSR_TURBO_RATIO_LIMIT[7:0] is Maximum Ratio Limit for 1C */
-		err = cpu_rdmsr_range(info->handle, MSR_TURBO_RATIO_LIMIT, 7, 0, &reg);
+		err = info_rdmsr_range(info, MSR_TURBO_RATIO_LIMIT, 7, 0, &reg);
 		if (!err) return (double) reg;
 	}
 	else if(info->id->vendor == VENDOR_AMD || info->id->vendor == VENDOR_HYGON) {
@@ -370,7 +392,7 @@ static double get_info_max_multiplier(struct msr_info_t *info)
 static int get_info_temperature(struct msr_info_t *info)
 {
 	int err;
-	uint64_t DigitalReadout, ReadingValid, TemperatureTarget;
+	uint64_t ThermStatus, DigitalReadout, ReadingValid, TemperatureTarget;
 
 	if(info->id->vendor == VENDOR_INTEL) {
 		/* Refer links above
@@ -385,15 +407,32 @@ static int get_info_temperature(struct msr_info_t *info)
 		Table 35-34.  Additional MSRs Common to Intel Xeon Processor D and Intel Xeon Processors E5 v4 Family Based on the Broadwell Microarchitecture
 		Table 35-40.  Selected MSRs Supported by Next Generation Intel Xeon Phi Processors with DisplayFamily_DisplayModel Signature 06_57H
 		MSR_TEMPERATURE_TARGET[23:16] is Temperature Target */
-		err  = cpu_rdmsr_range(info->handle, IA32_THERM_STATUS,      22, 16, &DigitalReadout);
-		err += cpu_rdmsr_range(info->handle, IA32_THERM_STATUS,      31, 31, &ReadingValid);
-		err += cpu_rdmsr_range(info->handle, MSR_TEMPERATURE_TARGET, 23, 16, &TemperatureTarget);
+		err  = info_rdmsr_range(info, IA32_THERM_STATUS,      31, 16, &ThermStatus);
+		err += info_rdmsr_range(info, MSR_TEMPERATURE_TARGET, 23, 16, &TemperatureTarget);
+		DigitalReadout = ThermStatus & 0x7F;
+		ReadingValid = ThermStatus >> 15;
 		if(!err && ReadingValid) return (int) (TemperatureTarget - DigitalReadout);
 	}
 
 	return CPU_INVALID_VALUE;
 }
 
+static int get_info_throttling(struct msr_info_t *info)
+{
+	int err;
+	uint64_t reg;
+
+	if(info->id->vendor == VENDOR_INTEL) {
+		/* Refer links above
+		Table 35-2.   IA-32 Architectural MSRs
+		IA32_THERM_STATUS[0] is Thermal Status (PROCHOT# or the thermal monitor is active) */
+		err = info_rdmsr_range(info, IA32_THERM_STATUS, 0, 0, &reg);
+		if (!err) return (int) reg;
+	}
+
+	return CPU_INVALID_VALUE;
+}
+
 static double get_info_voltage(struct msr_info_t *info)
 {
 	int err;
@@ -405,7 +444,7 @@ static double get_info_voltage(struct msr_info_t *info)
 		Table 35-18.  MSRs Supported by Intel Processors based on Intel microarchitecture code name Sandy Bridge (Contd.)
 		MSR_PERF_STATUS[47:32] is Core Voltage
 		P-state core voltage can be computed by MSR_PERF_STATUS[37:32] * (float) 1/(2^13). */
-		err = cpu_rdmsr_range(info->handle, MSR_PERF_STATUS, 47, 32, &reg);
+		err = info_rdmsr_range(info, MSR_PERF_STATUS, 47, 32, &reg);
 		if (!err) return (double) reg / (1ULL << 13ULL);
 	}
 	else if(info->id->vendor == VENDOR_AMD || info->id->vendor == VENDOR_HYGON) {
@@ -417,17 +456,40 @@ static double get_info_voltage(struct msr_info_t *info)
 		BKDG 15h, page 50: Voltage = 1.5500 - 0.00625 * Vid[7:0] (SVI2)
 		SVI2 since Piledriver (Family 15h, 2nd-gen): Models 10h-1Fh Processors */
 		VIDStep = ((info->id->ext_family < 0x15) || ((info->id->ext_family == 0x15) && (info->id->ext_model < 0x10))) ? 0.0125 : 0.00625;
-		err = cpu_rdmsr_range(info->handle, MSR_PSTATE_S, 2, 0, &reg);
+		err = info_rdmsr_range(info, MSR_PSTATE_S, 2, 0, &reg);
 		if(info->id->ext_family < 0x17)
-			err += cpu_rdmsr_range(info->handle, MSR_PSTATE_0 + (uint32_t) reg, 15, 9, &CpuVid);
+			err += info_rdmsr_range(info, MSR_PSTATE_0 + (uint32_t) reg, 15, 9, &CpuVid);
 		else
-			err += cpu_rdmsr_range(info->handle, MSR_PSTATE_0 + (uint32_t) reg, 21, 14, &CpuVid);
+			err += info_rdmsr_range(info, MSR_PSTATE_0 + (uint32_t) reg, 21, 14, &CpuVid);
 		if (!err && MSR_PSTATE_0 + (uint32_t) reg <= MSR_PSTATE_7) return 1.550 - VIDStep * CpuVid;
 	}
 
 	return (double) CPU_INVALID_VALUE / 100;
 }
 
+static double get_info_base_multiplier(struct msr_info_t *info)
+{
+	int err;
+	double mult;
+	uint64_t reg;
+
+	if(info->id->vendor == VENDOR_INTEL && info->internal->code.intel != PENTIUM) {
+		/* Refer links above
+		MSR_PLATFORM_INFO[15:8] is Maximum Non-Turbo Ratio
+		The TSC and MPERF tick at this ratio */
+		err = info_rdmsr_range(info, MSR_PLATFORM_INFO, 15, 8, &reg);
+		if (!err && reg > 0) return (double) reg;
+	}
+	else if(info->id->vendor == VENDOR_AMD || info->id->vendor == VENDOR_HYGON) {
+		/* Refer links above
+		The TSC and MPERF tick at the P0 frequency */
+		err = get_amd_multipliers(info, MSR_PSTATE_0, &mult);
+		if (!err && mult > 0) return mult;
+	}
+
+	return (double) CPU_INVALID_VALUE / 100;
+}
+
 static double get_info_bus_clock(struct msr_info_t *info)
 {
 	int err;
@@ -445,7 +507,7 @@ static double get_info_bus_clock(struct msr_info_t *info)
 		Table 35-27.  Additional MSRs Supported by Processors based on the Haswell or Haswell-E microarchitectures
 		Table 35-40.  Selected MSRs Supported by Next Generation Intel Xeon Phi Processors with DisplayFamily_DisplayModel Signature 06_57H
 		MSR_PLATFORM_INFO[15:8] is Maximum Non-Turbo Ratio */
-		err = cpu_rdmsr_range(info->handle, MSR_PLATFORM_INFO, 15, 8, &reg);
+		err = info_rdmsr_range(info, MSR_PLATFORM_INFO, 15, 8, &reg);
 		if (!err) return (double) info->cpu_clock / reg;
 	}
 	else if(info->id->vendor == VENDOR_AMD || info->id->vendor == VENDOR_HYGON) {
@@ -453,7 +515,7 @@ static double get_info_bus_clock(struct msr_info_t *info)
 		MSRC001_0061[6:4] is PstateMaxVal
 		PstateMaxVal is the the lowest-performance non-boosted P-state */
 		addr = get_amd_last_pstate_addr(info);
-		err  = cpu_rdmsr_range(info->handle, MSR_PSTATE_L, 6, 4, &reg);
+		err  = info_rdmsr_range(info, MSR_PSTATE_L, 6, 4, &reg);
 		err += get_amd_multipliers(info, addr - (uint32_t) reg, &mult);
 		if (!err) return (double) info->cpu_clock / mult;
 	}
@@ -465,53 +527,80 @@ int cpu_rdmsr_range(struct msr_driver_t* handle, uint32_t msr_index, uint8_t hig
 					uint8_t lowbit, uint64_t* result)
 {
 	int err;
-	const uint8_t bits = highbit - lowbit + 1;
+	uint64_t value;
 
 	if(highbit > 63 || lowbit > highbit)
 		return set_error(ERR_INVRANGE);
 
-	err = cpu_rdmsr(handle, msr_index, result);
+	err = cpu_rdmsr(handle, msr_index, &value);
+	if(err)
+		return err;
 
-	if(!err && bits < 64) {
-		/* Show only part of register */
-		*result >>= lowbit;
-		*result &= (1ULL << bits) - 1;
+	return get_msr_bits(value, highbit, lowbit, result);
+}
+
+static int msr_info_err = 0;
+static struct cpu_id_t msr_info_id;
+static struct internal_id_info_t msr_info_internal;
+static struct msr_info_t msr_info = { 0 };
+static INIT_ONCE msr_info_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK init_msr_info(PINIT_ONCE once, PVOID param, PVOID* context)
+{
+	struct msr_driver_t* handle = param;
+	struct cpu_raw_data_t raw;
+
+	msr_info_err  = cpuid_get_raw_data(&raw);
+	msr_info_err += cpu_ident_internal(&raw, &msr_info_id, &msr_info_internal);
+	/* Non-session bus clock and AMD multipliers are derived from this, keep it measured */
+	msr_info.cpu_clock = cpu_clock_measure(250, 1);
+	msr_info.id = &msr_info_id;
+	msr_info.internal = &msr_info_internal;
+	if(msr_info_id.vendor == VENDOR_INTEL) {
+		msr_info.msrs = intel_msr;
+		msr_info.num_msrs = (int) COUNT_OF(intel_msr);
+	}
+	else if(msr_info_id.vendor == VENDOR_AMD || msr_info_id.vendor == VENDOR_HYGON) {
+		msr_info.msrs = amd_msr;
+		msr_info.num_msrs = (int) COUNT_OF(amd_msr);
 	}
+	if(msr_info.num_msrs > 0 && cpu_rdmsr_batch(handle, -1, msr_info.msrs, msr_info.msr_value, msr_info.msr_valid, msr_info.num_msrs) < 0)
+		msr_info.num_msrs = 0;
+	return TRUE;
+}
 
-	return err;
+/* The snapshot is taken once and never written again, every caller gets
+   its own copy with its own handle so concurrent samplers do not race */
+static int get_msr_info(struct msr_driver_t* handle, struct msr_info_t *info)
+{
+	InitOnceExecuteOnce(&msr_info_once, init_msr_info, handle, NULL);
+	if (msr_info_err)
+		return -1;
+	*info = msr_info;
+	info->handle = handle;
+	return 0;
 }
 
 int cpu_msrinfo(struct msr_driver_t* handle, cpu_msrinfo_request_t which)
 {
-	static int err = 0, init = 0;
-	struct cpu_raw_data_t raw;
-	static struct cpu_id_t id;
-	static struct internal_id_info_t internal;
-	static struct msr_info_t info = { 0 };
+	struct msr_info_t info;
+	struct msr_session_t session;
 
 	if (handle == NULL) {
 		set_error(ERR_HANDLE);
 		return CPU_INVALID_VALUE;
 	}
 
-	info.handle = handle;
-	if (!init) {
-		err  = cpuid_get_raw_data(&raw);
-		err += cpu_ident_internal(&raw, &id, &internal);
-		info.cpu_clock = cpu_clock_measure(250, 1);
-		info.id = &id;
-		info.internal = &internal;
-		init = 1;
-	}
-
-	if (err)
+	if (get_msr_info(handle, &info) < 0)
 		return CPU_INVALID_VALUE;
 
 	switch (which) {
 		case INFO_MPERF:
-			return perfmsr_measure(handle, IA32_MPERF);
 		case INFO_APERF:
-			return perfmsr_measure(handle, IA32_APERF);
+		case INFO_EFFECTIVE_CLOCK:
+			if (cpu_msr_session_begin(handle, &session, 10) < 0)
+				return CPU_INVALID_VALUE;
+			return cpu_msrinfo_session(&session, which);
 		case INFO_MIN_MULTIPLIER:
 			return (int) (get_info_min_multiplier(&info) * 100);
 		case INFO_CUR_MULTIPLIER:
@@ -521,7 +610,7 @@ int cpu_msrinfo(struct msr_driver_t* handle, cpu_msrinfo_request_t which)
 		case INFO_TEMPERATURE:
 			return get_info_temperature(&info);
 		case INFO_THROTTLING:
-			return CPU_INVALID_VALUE;
+			return get_info_throttling(&info);
 		case INFO_VOLTAGE:
 			return (int) (get_info_voltage(&info) * 100);
 		case INFO_BCLK:
@@ -532,4 +621,89 @@ int cpu_msrinfo(struct msr_driver_t* handle, cpu_msrinfo_request_t which)
 	}
 }
 
+int cpu_msr_session_begin(struct msr_driver_t* handle, struct msr_session_t* session, int millis)
+{
+	static const uint32_t perf_msr[] = { IA32_MPERF, IA32_APERF };
+	uint64_t before[2], after[2];
+	PROCESSOR_NUMBER number;
+	GROUP_AFFINITY affinity, previous;
+	BOOL pinned;
+
+	if (handle == NULL || session == NULL)
+		return set_error(ERR_HANDLE);
+
+	memset(session, 0, sizeof(struct msr_session_t));
+	session->handle = handle;
+
+	/* Both ends of the window must be read on the same CPU */
+	GetCurrentProcessorNumberEx(&number);
+	memset(&affinity, 0, sizeof(GROUP_AFFINITY));
+	affinity.Group = number.Group;
+	affinity.Mask = (KAFFINITY) 1 << number.Number;
+	pinned = SetThreadGroupAffinity(GetCurrentThread(), &affinity, &previous);
+
+	session->perf_valid = cpu_rdmsr_batch(handle, -1, perf_msr, before, NULL, 2) == 2;
+	cpu_tsc_mark(&session->mark);
+	busy_loop_delay(millis);
+	cpu_tsc_unmark(&session->mark);
+	if (session->perf_valid && cpu_rdmsr_batch(handle, -1, perf_msr, after, NULL, 2) == 2
+		&& after[0] > before[0] && after[1] > before[1]) {
+		session->mperf = after[0] - before[0];
+		session->aperf = after[1] - before[1];
+	}
+	else
+		session->perf_valid = 0;
+
+	if (pinned)
+		SetThreadGroupAffinity(GetCurrentThread(), &previous, NULL);
+	return 0;
+}
+
+int cpu_msrinfo_session(struct msr_session_t* session, cpu_msrinfo_request_t which)
+{
+	struct msr_info_t info;
+	double ratio, tsc_mhz = 0.0;
+
+	if (session == NULL || session->handle == NULL) {
+		set_error(ERR_HANDLE);
+		return CPU_INVALID_VALUE;
+	}
+
+	if (get_msr_info(session->handle, &info) < 0)
+		return CPU_INVALID_VALUE;
+
+	if (session->mark.sys_clock > 0)
+		tsc_mhz = (double) session->mark.tsc / session->mark.sys_clock;
+
+	switch (which) {
+		case INFO_MPERF:
+			if (!session->perf_valid || session->mark.sys_clock == 0)
+				return CPU_INVALID_VALUE;
+			return (int) (session->mperf / session->mark.sys_clock);
+		case INFO_APERF:
+			if (!session->perf_valid || session->mark.sys_clock == 0)
+				return CPU_INVALID_VALUE;
+			return (int) (session->aperf / session->mark.sys_clock);
+		case INFO_EFFECTIVE_CLOCK:
+			if (!session->perf_valid || tsc_mhz <= 0.0)
+				return CPU_INVALID_VALUE;
+			return (int) (tsc_mhz * session->aperf / session->mperf);
+		case INFO_CUR_MULTIPLIER:
+			ratio = get_info_base_multiplier(&info);
+			if (session->perf_valid && ratio > 0.0 && ratio < (double) CPU_INVALID_VALUE / 100)
+				return (int) (ratio * session->aperf / session->mperf * 100);
+			break;
+		case INFO_BCLK:
+		case INFO_BUS_CLOCK:
+			ratio = get_info_base_multiplier(&info);
+			if (tsc_mhz > 0.0 && ratio > 0.0 && ratio < (double) CPU_INVALID_VALUE / 100)
+				return (int) (tsc_mhz / ratio * 100);
+			break;
+		default:
+			break;
+	}
+
+	return cpu_msrinfo(session->handle, which);
+}
+
 #endif // RDMSR_UNSUPPORTED_OS
@@ -154,6 +154,45 @@ int cpu_rdmsr(struct msr_driver_t* driver, uint32_t msr_index, uint64_t* result)
 	return 0;
 }
 
+int cpu_rdmsr_batch(struct msr_driver_t* driver, int cpu, const uint32_t* msrs, uint64_t* result,
+	uint8_t* valid, int count)
+{
+	DWORD dwBytesReturned;
+	GROUP_AFFINITY affinity, previous;
+	PROCESSOR_NUMBER number;
+	int i, read = 0;
+
+	if (!driver)
+		return set_error(ERR_HANDLE);
+	/* The driver runs RDMSR on the calling CPU, so pin once for the whole batch.
+	   -1 pins to the CPU the thread is on now, so the batch cannot migrate between IOCTLs. */
+	if (cpu >= 0) {
+		if (!cpuid_get_cpu_group_affinity((logical_cpu_t)cpu, &affinity))
+			return set_error(ERR_INVCNB);
+	}
+	else {
+		GetCurrentProcessorNumberEx(&number);
+		memset(&affinity, 0, sizeof(GROUP_AFFINITY));
+		affinity.Group = number.Group;
+		affinity.Mask = (KAFFINITY) 1 << number.Number;
+	}
+	if (!SetThreadGroupAffinity(GetCurrentThread(), &affinity, &previous))
+		return set_error(ERR_INVCNB);
+	for (i = 0; i < count; i++) {
+		UINT64 MsrData = 0;
+		uint32_t msr_index = msrs[i];
+		BOOL Res = DeviceIoControl(driver->hhDriver, IOCTL_OLS_READ_MSR,
+			&msr_index, sizeof(msr_index), &MsrData, sizeof(MsrData), &dwBytesReturned, NULL);
+		result[i] = Res ? MsrData : 0;
+		if (valid)
+			valid[i] = Res ? 1 : 0;
+		if (Res)
+			read++;
+	}
+	SetThreadGroupAffinity(GetCurrentThread(), &previous, NULL);
+	return read;
+}
+
 uint8_t io_inb(struct msr_driver_t* drv, uint16_t port)
 {
 	if (!drv || !drv->hhDriver || drv->hhDriver == INVALID_HANDLE_VALUE)